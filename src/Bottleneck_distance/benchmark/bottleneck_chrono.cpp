@@ -12,6 +12,8 @@
 #include <chrono>
 #include <fstream>
 #include <random>
+#include <limits>  // for numeric_limits
+#include <algorithm>  // for max
 
 using namespace Gudhi::persistence_diagram;
 
@@ -39,12 +41,22 @@ int main() {
       if (i % 3 == 0)
         v2.emplace_back(std::max(a, b), std::max(a, b) + y);
     }
+    typedef std::chrono::duration<int, std::milli> millisecs_t;
     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     double b = bottleneck_distance(v1, v2);
     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-    typedef std::chrono::duration<int, std::milli> millisecs_t;
     millisecs_t duration(std::chrono::duration_cast<millisecs_t>(end - start));
-    result_file << n << ";" << duration.count() << ";" << b << std::endl;
+
+    // Same computation, with a uniform grid instead of CGAL kd-trees to find the neighbors
+    const double e = (std::numeric_limits<double>::min)();
+    start = std::chrono::steady_clock::now();
+    Persistence_graph g(v1, v2, e);
+    double b_grid = (std::max)(g.bottleneck_alive(), bottleneck_distance_approx<Grid_graph_matching>(g, e));
+    end = std::chrono::steady_clock::now();
+    millisecs_t duration_grid(std::chrono::duration_cast<millisecs_t>(end - start));
+
+    result_file << n << ";" << duration.count() << ";" << b << ";" << duration_grid.count() << ";" << b_grid
+        << std::endl;
   }
   result_file.close();
 }
@@ -70,6 +70,23 @@ int main() {
     Bottleneck distance = 0.75
     Approx bottleneck distance = 0.808176
  * \endcode
+ *
+ * \section bottleneckdistancematrix Distance matrix
+ *
+ * To compare many diagrams, `bottleneck_distance_matrix()` computes the distances between all the pairs of a range of
+ * diagrams (or between two ranges of diagrams). Each diagram is preprocessed only once, and the pairs are computed in
+ * parallel when TBB is available.
+ *
+ * \section wassersteindistance Wasserstein distance
+ *
+ * `wasserstein_distance()` computes the \f$q\f$-Wasserstein distance between two diagrams with an auction algorithm
+ * with \f$\varepsilon\f$-scaling, where the best bids are found in a kd-tree as in Hera. It does not depend on CGAL.
+ * The class `Wasserstein_auction` gives access to the matching and to the prices of the auction, which can be reused
+ * to warm-start the computation on a similar pair of diagrams, and `wasserstein_distance_matrix()` evaluates many
+ * pairs of diagrams, in parallel when TBB is available.
+ *
+ * `Lagrangian_barycenter` estimates a Fréchet mean of a set of diagrams for the 2-Wasserstein distance. Its matchings
+ * are computed with the same auction algorithm, warm-started from one iteration to the next.
 
  */
 /** @} */  // end defgroup bottleneck_distance
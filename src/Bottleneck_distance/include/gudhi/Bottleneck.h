@@ -17,9 +17,18 @@
 
 #include <CGAL/version.h>  // for CGAL_VERSION_NR
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <vector>
-#include <algorithm>  // for max
+#include <algorithm>  // for max, sort, merge
+#include <memory>  // for shared_ptr
 #include <limits>  // for numeric_limits
+#include <utility>  // for pair, move
+#include <iterator>  // for begin, end
+#include <tuple>  // for get
+#include <cstddef>  // for size_t
 
 #include <cmath>
 #include <cfloat>  // FLT_EVAL_METHOD
@@ -33,12 +42,14 @@ namespace Gudhi {
 
 namespace persistence_diagram {
 
-inline double bottleneck_distance_approx(Persistence_graph& g, double e) {
+template<typename Matching = Graph_matching>
+double bottleneck_distance_approx(Persistence_graph& g, double e) {
   double b_lower_bound = 0.;
   double b_upper_bound = g.diameter_bound();
   const double alpha = std::pow(g.size(), 1. / 5.);
-  Graph_matching m(g);
-  Graph_matching biggest_unperfect(g);
+  // The matching found for a radius stays valid for larger radii, so each step only augments the biggest imperfect
+  // matching found so far. The augmentations of a step that reaches a perfect matching are undone.
+  Matching m(g);
   while (b_upper_bound - b_lower_bound > 2 * e) {
     double step = b_lower_bound + (b_upper_bound - b_lower_bound) / alpha;
 #if !defined FLT_EVAL_METHOD || FLT_EVAL_METHOD < 0 || FLT_EVAL_METHOD > 1
@@ -53,38 +64,43 @@ inline double bottleneck_distance_approx(Persistence_graph& g, double e) {
     m.set_r(step);
     while (m.multi_augment()) {}  // compute a maximum matching (in the graph corresponding to the current r)
     if (m.perfect()) {
-      m = biggest_unperfect;
+      m.rollback();
       b_upper_bound = step;
     } else {
-      biggest_unperfect = m;
+      m.commit();
       b_lower_bound = step;
     }
   }
   return (b_lower_bound + b_upper_bound) / 2.;
 }
 
-inline double bottleneck_distance_exact(Persistence_graph& g) {
-  std::vector<double> sd = g.sorted_distances();
+template<typename Matching = Graph_matching>
+double bottleneck_distance_exact(Persistence_graph& g, std::vector<double> const& sd) {
   long lower_bound_i = 0;
   long upper_bound_i = sd.size() - 1;
   const double alpha = std::pow(g.size(), 1. / 5.);
-  Graph_matching m(g);
-  Graph_matching biggest_unperfect(g);
+  // Same warm start as in bottleneck_distance_approx
+  Matching m(g);
   while (lower_bound_i != upper_bound_i) {
     long step = lower_bound_i + static_cast<long> ((upper_bound_i - lower_bound_i - 1) / alpha);
     m.set_r(sd.at(step));
     while (m.multi_augment()) {}  // compute a maximum matching (in the graph corresponding to the current r)
     if (m.perfect()) {
-      m = biggest_unperfect;
+      m.rollback();
       upper_bound_i = step;
     } else {
-      biggest_unperfect = m;
+      m.commit();
       lower_bound_i = step + 1;
     }
   }
   return sd.at(lower_bound_i);
 }
 
+template<typename Matching = Graph_matching>
+double bottleneck_distance_exact(Persistence_graph& g) {
+  return bottleneck_distance_exact<Matching>(g, g.sorted_distances());
+}
+
 /** \brief Function to compute the Bottleneck distance between two persistence diagrams.
  *
  * \tparam Persistence_diagram1,Persistence_diagram2
@@ -117,6 +133,149 @@ double bottleneck_distance(const Persistence_diagram1 &diag1, const Persistence_
   return (std::max)(g.bottleneck_alive(), e == 0. ? bottleneck_distance_exact(g) : bottleneck_distance_approx(g, e));
 }
 
+namespace internal {
+
+/** \internal \brief What the Persistence_graph of a persistence diagram and any other diagram needs, computed once
+ * when the diagram is compared to many others: its points farther than e from the diagonal, shared by the graphs,
+ * the sorted distances of these points to the diagonal, and its sorted essential births.
+ */
+struct Preprocessed_diagram {
+  std::shared_ptr<const std::vector<Internal_point>> points;
+  std::vector<double> diagonal_distances;
+  std::vector<double> essential;
+
+  template<typename Persistence_diagram>
+  Preprocessed_diagram(const Persistence_diagram &diag, double e) {
+    std::vector<Internal_point> finite;
+    for (auto it = std::begin(diag); it != std::end(diag); ++it) {
+      if (std::get<1>(*it) == std::numeric_limits<double>::infinity()) {
+        essential.push_back(std::get<0>(*it));
+      } else if (std::get<1>(*it) - std::get<0>(*it) > e) {
+        finite.push_back(Internal_point(std::get<0>(*it), std::get<1>(*it), finite.size()));
+        // Same computation as Persistence_graph::distance to the projection
+        double m = (std::get<0>(*it) + std::get<1>(*it)) / 2.;
+        diagonal_distances.push_back((std::max)(std::fabs(std::get<0>(*it) - m), std::fabs(std::get<1>(*it) - m)));
+      }
+    }
+    points = std::make_shared<const std::vector<Internal_point>>(std::move(finite));
+    std::sort(diagonal_distances.begin(), diagonal_distances.end());
+    std::sort(essential.begin(), essential.end());
+  }
+};
+
+template<typename Persistence_diagram_range>
+std::vector<Preprocessed_diagram> preprocess_diagrams(const Persistence_diagram_range &diagrams, double e) {
+  std::vector<Preprocessed_diagram> preprocessed;
+  for (auto it = std::begin(diagrams); it != std::end(diagrams); ++it)
+    preprocessed.emplace_back(*it, e);
+  return preprocessed;
+}
+
+/** \internal \brief Candidate values of the exact bottleneck distance between two preprocessed diagrams, sorted.
+ * A point is never better matched to the projection of another point than to its own projection, so only 0, the
+ * distances of the points to the diagonal and the distances between the points of both diagrams are candidates
+ * (Persistence_graph::sorted_distances() also lists the distances between points and other projections).
+ */
+inline std::vector<double> sorted_distances(const Preprocessed_diagram &diag1, const Preprocessed_diagram &diag2) {
+  std::vector<double> cross;
+  cross.reserve(diag1.points->size() * diag2.points->size() + 1);
+  cross.push_back(0.);  // for empty diagrams
+  for (const Internal_point &p : *diag1.points)
+    for (const Internal_point &q : *diag2.points)
+      cross.push_back((std::max)(std::fabs(p.x() - q.x()), std::fabs(p.y() - q.y())));
+  // Already in parallel over the pairs of diagrams
+  std::sort(cross.begin(), cross.end());
+  std::vector<double> diagonal(diag1.diagonal_distances.size() + diag2.diagonal_distances.size());
+  std::merge(diag1.diagonal_distances.begin(), diag1.diagonal_distances.end(), diag2.diagonal_distances.begin(),
+             diag2.diagonal_distances.end(), diagonal.begin());
+  std::vector<double> sd(cross.size() + diagonal.size());
+  std::merge(cross.begin(), cross.end(), diagonal.begin(), diagonal.end(), sd.begin());
+  return sd;
+}
+
+inline double bottleneck_distance(const Preprocessed_diagram &diag1, const Preprocessed_diagram &diag2, double e) {
+  if (diag1.essential.size() != diag2.essential.size())
+    return std::numeric_limits<double>::infinity();
+  double b_alive = 0.;
+  for (std::size_t i = 0; i < diag1.essential.size(); ++i)
+    b_alive = (std::max)(b_alive, std::fabs(diag1.essential[i] - diag2.essential[i]));
+  Persistence_graph g(diag1.points, diag2.points, b_alive);
+  return (std::max)(b_alive, e == 0. ? bottleneck_distance_exact(g, sorted_distances(diag1, diag2))
+                                     : bottleneck_distance_approx(g, e));
+}
+
+}  // namespace internal
+
+/** \brief Function to compute the matrix of Bottleneck distances between all the pairs of a range of persistence
+ * diagrams.
+ *
+ * Each diagram is preprocessed once: its points far enough from the diagonal are extracted and shared by the graphs of
+ * all its pairs, and the distances of these points to the diagonal and its essential points are sorted. For the exact
+ * distance (`e` = 0), only the distances between the points of the two diagrams are computed and sorted for each
+ * pair. The pairs are computed in parallel when TBB is available. Each distance is the same as the one given by
+ * `bottleneck_distance()`.
+ *
+ * \tparam Persistence_diagram_range A range whose value type is a model of the concept `PersistenceDiagram`.
+ *
+ * \param[in] diagrams The persistence diagrams.
+ * \param[in] e Same as in `bottleneck_distance()`.
+ * \return The symmetric matrix of the distances, of size `n * n` for `n` diagrams, stored row by row.
+ *
+ * \ingroup bottleneck_distance
+ */
+template<typename Persistence_diagram_range>
+std::vector<double> bottleneck_distance_matrix(const Persistence_diagram_range &diagrams,
+                                               double e = (std::numeric_limits<double>::min)()) {
+  std::vector<internal::Preprocessed_diagram> diags = internal::preprocess_diagrams(diagrams, e);
+  const std::size_t n = diags.size();
+  std::vector<double> matrix(n * n, 0.);
+  // Rows get shorter, but each distance is expensive enough for TBB to balance the work.
+  auto compute_row = [&](std::size_t i) {
+    for (std::size_t j = i + 1; j < n; ++j)
+      matrix[i * n + j] = matrix[j * n + i] = internal::bottleneck_distance(diags[i], diags[j], e);
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), n, compute_row);
+#else
+  for (std::size_t i = 0; i < n; ++i) compute_row(i);
+#endif
+  return matrix;
+}
+
+/** \brief Function to compute the matrix of Bottleneck distances between each persistence diagram of a range and
+ * each persistence diagram of another range.
+ *
+ * \tparam Persistence_diagram_range1,Persistence_diagram_range2 Ranges whose value types are models of the concept
+ * `PersistenceDiagram`.
+ *
+ * \param[in] diagrams1 The first persistence diagrams.
+ * \param[in] diagrams2 The second persistence diagrams.
+ * \param[in] e Same as in `bottleneck_distance()`.
+ * \return The matrix of the distances, of size `n1 * n2`, stored row by row: the distance between `diagrams1[i]`
+ * and `diagrams2[j]` is at index `i * n2 + j`.
+ *
+ * \ingroup bottleneck_distance
+ */
+template<typename Persistence_diagram_range1, typename Persistence_diagram_range2>
+std::vector<double> bottleneck_distance_matrix(const Persistence_diagram_range1 &diagrams1,
+                                               const Persistence_diagram_range2 &diagrams2,
+                                               double e = (std::numeric_limits<double>::min)()) {
+  std::vector<internal::Preprocessed_diagram> diags1 = internal::preprocess_diagrams(diagrams1, e);
+  std::vector<internal::Preprocessed_diagram> diags2 = internal::preprocess_diagrams(diagrams2, e);
+  const std::size_t n1 = diags1.size();
+  const std::size_t n2 = diags2.size();
+  std::vector<double> matrix(n1 * n2);
+  auto compute_entry = [&](std::size_t k) {
+    matrix[k] = internal::bottleneck_distance(diags1[k / n2], diags2[k % n2], e);
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), n1 * n2, compute_entry);
+#else
+  for (std::size_t k = 0; k < n1 * n2; ++k) compute_entry(k);
+#endif
+  return matrix;
+}
+
 }  // namespace persistence_diagram
 
 }  // namespace Gudhi
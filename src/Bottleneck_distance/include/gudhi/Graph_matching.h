@@ -15,6 +15,7 @@
 
 #include <vector>
 #include <unordered_set>
+#include <utility>  // for std::pair
 #include <algorithm>
 
 namespace Gudhi {
@@ -22,19 +23,28 @@ namespace Gudhi {
 namespace persistence_diagram {
 
 /** \internal \brief Structure representing a graph matching. The graph is a Persistence_diagrams_graph.
+ *
+ * \tparam Neighbors_finder_ Structure used to find the near V points during the BFS and DFS: Neighbors_finder (CGAL
+ * kd-tree) or Grid_neighbors_finder (uniform grid, usually faster).
  *
  * \ingroup bottleneck_distance
  */
-class Graph_matching {
+template <class Neighbors_finder_>
+class Basic_graph_matching {
  public:
   /** \internal \brief Constructor constructing an empty matching. */
-  explicit Graph_matching(Persistence_graph &g);
+  explicit Basic_graph_matching(Persistence_graph &g);
   /** \internal \brief Is the matching perfect ? */
   bool perfect() const;
   /** \internal \brief Augments the matching with a maximal set of edge-disjoint shortest augmenting paths. */
   bool multi_augment();
   /** \internal \brief Sets the maximum length of the edges allowed to be added in the matching, 0 initially. */
   void set_r(double r);
+  /** \internal \brief Forgets the changes made to the matching since the last call to commit() or rollback(). */
+  void commit();
+  /** \internal \brief Undoes the changes made to the matching since the last call to commit() or rollback(). The
+   * matching is then the same as before, without copying the whole structure. r is not restored. */
+  void rollback();
 
  private:
   Persistence_graph* gp;
@@ -43,29 +53,44 @@ class Graph_matching {
   std::vector<int> v_to_u;
   /** \internal \brief All the unmatched points in U. */
   std::unordered_set<int> unmatched_in_u;
+  /** \internal \brief Changes of v_to_u since the last commit, as pairs (V point, previous value). */
+  std::vector<std::pair<int, int>> v_to_u_log;
+  /** \internal \brief Points of U matched since the last commit. */
+  std::vector<int> matched_in_u_log;
+
+  typedef Basic_layered_neighbors_finder<Neighbors_finder_> Layered_finder;
 
   /** \internal \brief Provides a Layered_neighbors_finder dividing the graph in layers. Basically a BFS. */
-  Layered_neighbors_finder layering() const;
+  Layered_finder layering() const;
   /** \internal \brief Augments the matching with a simple path no longer than max_depth. Basically a DFS. */
-  bool augment(Layered_neighbors_finder & layered_nf, int u_start_index, int max_depth);
+  bool augment(Layered_finder & layered_nf, int u_start_index, int max_depth);
   /** \internal \brief Update the matching with the simple augmenting path given as parameter. */
   void update(std::vector<int> & path);
 };
 
-inline Graph_matching::Graph_matching(Persistence_graph& g)
-    : gp(&g), r(0.), v_to_u(g.size(), null_point_index()), unmatched_in_u(g.size()) {
+/** \internal \brief Matching using CGAL kd-trees to find neighbors. */
+typedef Basic_graph_matching<Neighbors_finder> Graph_matching;
+/** \internal \brief Matching using uniform grids to find neighbors. */
+typedef Basic_graph_matching<Grid_neighbors_finder> Grid_graph_matching;
+
+template <class Neighbors_finder_>
+Basic_graph_matching<Neighbors_finder_>::Basic_graph_matching(Persistence_graph& g)
+    : gp(&g), r(0.), v_to_u(g.size(), null_point_index()), unmatched_in_u(g.size()), v_to_u_log(),
+      matched_in_u_log() {
   for (int u_point_index = 0; u_point_index < g.size(); ++u_point_index)
     unmatched_in_u.insert(u_point_index);
 }
 
-inline bool Graph_matching::perfect() const {
+template <class Neighbors_finder_>
+bool Basic_graph_matching<Neighbors_finder_>::perfect() const {
   return unmatched_in_u.empty();
 }
 
-inline bool Graph_matching::multi_augment() {
+template <class Neighbors_finder_>
+bool Basic_graph_matching<Neighbors_finder_>::multi_augment() {
   if (perfect())
     return false;
-  Layered_neighbors_finder layered_nf(layering());
+  Layered_finder layered_nf(layering());
   int max_depth = layered_nf.vlayers_number()*2 - 1;
   double rn = sqrt(gp->size());
   // verification of a necessary criterion in order to shortcut if possible
@@ -79,11 +104,27 @@ inline bool Graph_matching::multi_augment() {
   return successful;
 }
 
-inline void Graph_matching::set_r(double r) {
+template <class Neighbors_finder_>
+void Basic_graph_matching<Neighbors_finder_>::set_r(double r) {
   this->r = r;
 }
 
-inline bool Graph_matching::augment(Layered_neighbors_finder & layered_nf, int u_start_index, int max_depth) {
+template <class Neighbors_finder_>
+void Basic_graph_matching<Neighbors_finder_>::commit() {
+  v_to_u_log.clear();
+  matched_in_u_log.clear();
+}
+
+template <class Neighbors_finder_>
+void Basic_graph_matching<Neighbors_finder_>::rollback() {
+  for (auto it = v_to_u_log.crbegin(); it != v_to_u_log.crend(); ++it)
+    v_to_u[it->first] = it->second;
+  unmatched_in_u.insert(matched_in_u_log.cbegin(), matched_in_u_log.cend());
+  commit();
+}
+
+template <class Neighbors_finder_>
+bool Basic_graph_matching<Neighbors_finder_>::augment(Layered_finder & layered_nf, int u_start_index, int max_depth) {
   // V vertices have at most one successor, thus when we backtrack from U we can directly pop_back 2 vertices.
   std::vector<int> path;
   path.emplace_back(u_start_index);
@@ -111,13 +152,15 @@ inline bool Graph_matching::augment(Layered_neighbors_finder & layered_nf, int u
   return true;
 }
 
-inline Layered_neighbors_finder Graph_matching::layering() const {
+template <class Neighbors_finder_>
+typename Basic_graph_matching<Neighbors_finder_>::Layered_finder
+Basic_graph_matching<Neighbors_finder_>::layering() const {
   std::vector<int> u_vertices(unmatched_in_u.cbegin(), unmatched_in_u.cend());
   std::vector<int> v_vertices;
-  Neighbors_finder nf(*gp, r);
+  Neighbors_finder_ nf(*gp, r);
   for (int v_point_index = 0; v_point_index < gp->size(); ++v_point_index)
     nf.add(v_point_index);
-  Layered_neighbors_finder layered_nf(*gp, r);
+  Layered_finder layered_nf(*gp, r);
   for (int layer = 0; !u_vertices.empty(); layer++) {
     // one layer is one step in the BFS
     for (auto it1 = u_vertices.cbegin(); it1 != u_vertices.cend(); ++it1) {
@@ -144,13 +187,17 @@ inline Layered_neighbors_finder Graph_matching::layering() const {
   return layered_nf;
 }
 
-inline void Graph_matching::update(std::vector<int>& path) {
+template <class Neighbors_finder_>
+void Basic_graph_matching<Neighbors_finder_>::update(std::vector<int>& path) {
   // Must return 1.
   unmatched_in_u.erase(path.front());
+  matched_in_u_log.emplace_back(path.front());
   for (auto it = path.cbegin(); it != path.cend(); ++it) {
     // Be careful, the iterator is incremented twice each time
     int tmp = *it;
-    v_to_u[*(++it)] = tmp;
+    int v_point_index = *(++it);
+    v_to_u_log.emplace_back(v_point_index, v_to_u[v_point_index]);
+    v_to_u[v_point_index] = tmp;
   }
 }
 
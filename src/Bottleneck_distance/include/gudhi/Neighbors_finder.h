@@ -18,10 +18,15 @@
 #include <gudhi/Persistence_graph.h>
 #include <gudhi/Internal_point.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <unordered_set>
+#include <unordered_map>
 #include <vector>
-#include <algorithm>  // for std::max
-#include <cmath>  // for std::abs
+#include <memory>  // for std::unique_ptr
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::max, std::min
+#include <cmath>  // for std::abs, std::floor
 
 namespace Gudhi {
 
@@ -85,18 +90,55 @@ class Neighbors_finder {
   std::unordered_set<int> projections_f;
 };
 
+/** \internal \brief Same as Neighbors_finder, but the V points are stored in a uniform grid of squares of side 2r
+ * instead of a kd-tree.
+ *
+ * A query only looks at the 3x3 cells around the query point, and a point is pulled by swapping it with the last point
+ * of its cell, which is much cheaper than a removal from a CGAL kd-tree. Cells of side 2r (and not r) leave room for
+ * rounding errors when a point is exactly at distance r from the query point.
+ *
+ * \ingroup bottleneck_distance
+ */
+class Grid_neighbors_finder {
+ public:
+  /** \internal \brief Constructor taking the near distance definition as parameter. */
+  Grid_neighbors_finder(const Persistence_graph& g, double r);
+  /** \internal \brief A point added will be possibly pulled. */
+  void add(int v_point_index);
+  /** \internal \brief Returns and remove a V point near to the U point given as parameter, null_point_index() if
+   * there isn't such a point. */
+  int pull_near(int u_point_index);
+  /** \internal \brief Returns and remove all the V points near to the U point given as parameter. */
+  std::vector<int> pull_all_near(int u_point_index);
+
+ private:
+  typedef std::pair<long long, long long> Cell;
+
+  long long cell_coordinate(double x) const;
+
+  const Persistence_graph& g;
+  const double r;
+  // Side of the cells, 2r
+  const double cell_size;
+  std::unordered_map<Cell, std::vector<Internal_point>, boost::hash<Cell>> grid;
+  std::unordered_set<int> projections_f;
+};
+
 /** \internal \brief data structure used to find any point (including projections) in V near to a query point from U
  * (which can be a projection) in a layered graph layer given as parmeter.
  *
  * V points have to be added manually using their index and before the first pull. A neighbor pulled is automatically
  * removed.
  *
+ * \tparam Neighbors_finder_ Neighbors_finder or Grid_neighbors_finder, used for each layer.
+ *
  * \ingroup bottleneck_distance
  */
-class Layered_neighbors_finder {
+template <class Neighbors_finder_>
+class Basic_layered_neighbors_finder {
  public:
   /** \internal \brief Constructor taking the near distance definition as parameter. */
-  Layered_neighbors_finder(const Persistence_graph& g, double r);
+  Basic_layered_neighbors_finder(const Persistence_graph& g, double r);
   /** \internal \brief A point added will be possibly pulled. */
   void add(int v_point_index, int vlayer);
   /** \internal \brief Returns and remove a V point near to the U point given as parameter, null_point_index() if
@@ -108,9 +150,11 @@ class Layered_neighbors_finder {
  private:
   const Persistence_graph& g;
   const double r;
-  std::vector<std::unique_ptr<Neighbors_finder>> neighbors_finder;
+  std::vector<std::unique_ptr<Neighbors_finder_>> neighbors_finder;
 };
 
+typedef Basic_layered_neighbors_finder<Neighbors_finder> Layered_neighbors_finder;
+
 inline Neighbors_finder::Neighbors_finder(const Persistence_graph& g, double r) :
     g(g), r(r), kd_t(), projections_f() { }
 
@@ -156,22 +200,92 @@ inline std::vector<int> Neighbors_finder::pull_all_near(int u_point_index) {
   return all_pull;
 }
 
-inline Layered_neighbors_finder::Layered_neighbors_finder(const Persistence_graph& g, double r) :
+inline Grid_neighbors_finder::Grid_neighbors_finder(const Persistence_graph& g, double r) :
+    g(g), r(r), cell_size(r > 0. ? 2 * r : 1.), grid(), projections_f() { }
+
+inline long long Grid_neighbors_finder::cell_coordinate(double x) const {
+  // Clamping is monotonic, so points at distance at most r from each other stay in neighbor cells.
+  const double bound = 1e18;
+  return static_cast<long long>((std::max)(-bound, (std::min)(bound, std::floor(x / cell_size))));
+}
+
+inline void Grid_neighbors_finder::add(int v_point_index) {
+  if (g.on_the_v_diagonal(v_point_index)) {
+    projections_f.emplace(v_point_index);
+  } else {
+    Internal_point v_point = g.get_v_point(v_point_index);
+    grid[Cell(cell_coordinate(v_point.x()), cell_coordinate(v_point.y()))].push_back(v_point);
+  }
+}
+
+inline int Grid_neighbors_finder::pull_near(int u_point_index) {
+  int tmp;
+  int c = g.corresponding_point_in_v(u_point_index);
+  if (g.on_the_u_diagonal(u_point_index) && !projections_f.empty()) {
+    // Any pair of projection is at distance 0
+    tmp = *projections_f.cbegin();
+    projections_f.erase(tmp);
+    return tmp;
+  }
+  if (projections_f.count(c) && (g.distance(u_point_index, c) <= r)) {
+    // Is the query point near to its projection ?
+    projections_f.erase(c);
+    return c;
+  }
+  // Is the query point near to a V point in the plane ?
+  Internal_point u_point = g.get_u_point(u_point_index);
+  const long long cx = cell_coordinate(u_point.x());
+  const long long cy = cell_coordinate(u_point.y());
+  for (long long i = cx - 1; i <= cx + 1; ++i) {
+    for (long long j = cy - 1; j <= cy + 1; ++j) {
+      auto cell = grid.find(Cell(i, j));
+      if (cell == grid.end())
+        continue;
+      std::vector<Internal_point>& points = cell->second;
+      for (std::size_t k = 0; k < points.size(); ++k) {
+        if ((std::max)(std::abs(points[k].x() - u_point.x()), std::abs(points[k].y() - u_point.y())) <= r) {
+          tmp = points[k].point_index;
+          points[k] = points.back();
+          points.pop_back();
+          return tmp;
+        }
+      }
+    }
+  }
+  return null_point_index();
+}
+
+inline std::vector<int> Grid_neighbors_finder::pull_all_near(int u_point_index) {
+  std::vector<int> all_pull;
+  int last_pull = pull_near(u_point_index);
+  while (last_pull != null_point_index()) {
+    all_pull.emplace_back(last_pull);
+    last_pull = pull_near(u_point_index);
+  }
+  return all_pull;
+}
+
+template <class Neighbors_finder_>
+Basic_layered_neighbors_finder<Neighbors_finder_>::Basic_layered_neighbors_finder(const Persistence_graph& g,
+                                                                                  double r) :
     g(g), r(r), neighbors_finder() { }
 
-inline void Layered_neighbors_finder::add(int v_point_index, int vlayer) {
+template <class Neighbors_finder_>
+void Basic_layered_neighbors_finder<Neighbors_finder_>::add(int v_point_index, int vlayer) {
   for (int l = neighbors_finder.size(); l <= vlayer; l++)
-    neighbors_finder.emplace_back(std::unique_ptr<Neighbors_finder>(new Neighbors_finder(g, r)));
+    neighbors_finder.emplace_back(std::unique_ptr<Neighbors_finder_>(new Neighbors_finder_(g, r)));
   neighbors_finder.at(vlayer)->add(v_point_index);
 }
 
-inline int Layered_neighbors_finder::pull_near(int u_point_index, int vlayer) {
+template <class Neighbors_finder_>
+int Basic_layered_neighbors_finder<Neighbors_finder_>::pull_near(int u_point_index, int vlayer) {
   if (static_cast<int> (neighbors_finder.size()) <= vlayer)
     return null_point_index();
   return neighbors_finder.at(vlayer)->pull_near(u_point_index);
 }
 
-inline int Layered_neighbors_finder::vlayers_number() const {
+template <class Neighbors_finder_>
+int Basic_layered_neighbors_finder<Neighbors_finder_>::vlayers_number() const {
   return static_cast<int> (neighbors_finder.size());
 }
 
@@ -20,6 +20,8 @@
 #include <vector>
 #include <algorithm>
 #include <limits>  // for numeric_limits
+#include <memory>  // for shared_ptr
+#include <utility>  // for swap, move
 
 namespace Gudhi {
 
@@ -35,6 +37,10 @@ class Persistence_graph {
   /** \internal \brief Constructor taking 2 PersistenceDiagrams (concept) as parameters. */
   template<typename Persistence_diagram1, typename Persistence_diagram2>
   Persistence_graph(const Persistence_diagram1& diag1, const Persistence_diagram2& diag2, double e);
+  /** \internal \brief Constructor taking the points of 2 diagrams farther than e from the diagonal, numbered from 0,
+   * and the bottleneck distance between their essential parts. The points are shared, not copied. */
+  Persistence_graph(std::shared_ptr<const std::vector<Internal_point>> u_points,
+                    std::shared_ptr<const std::vector<Internal_point>> v_points, double b_alive);
   /** \internal \brief Is the given point from U the projection of a point in V ? */
   bool on_the_u_diagonal(int u_point_index) const;
   /** \internal \brief Is the given point from V the projection of a point in U ? */
@@ -59,8 +65,9 @@ class Persistence_graph {
   Internal_point get_v_point(int v_point_index) const;
 
  private:
-  std::vector<Internal_point> u;
-  std::vector<Internal_point> v;
+  // Shared with the preprocessed diagrams of the distance matrices
+  std::shared_ptr<const std::vector<Internal_point>> u;
+  std::shared_ptr<const std::vector<Internal_point>> v;
   double b_alive;
 };
 
@@ -70,20 +77,24 @@ Persistence_graph::Persistence_graph(const Persistence_diagram1 &diag1,
     : u(), v(), b_alive(0.) {
   std::vector<double> u_alive;
   std::vector<double> v_alive;
+  std::vector<Internal_point> u_points;
+  std::vector<Internal_point> v_points;
   for (auto it = std::begin(diag1); it != std::end(diag1); ++it) {
     if (std::get<1>(*it) == std::numeric_limits<double>::infinity())
       u_alive.push_back(std::get<0>(*it));
     else if (std::get<1>(*it) - std::get<0>(*it) > e)
-      u.push_back(Internal_point(std::get<0>(*it), std::get<1>(*it), u.size()));
+      u_points.push_back(Internal_point(std::get<0>(*it), std::get<1>(*it), u_points.size()));
   }
   for (auto it = std::begin(diag2); it != std::end(diag2); ++it) {
     if (std::get<1>(*it) == std::numeric_limits<double>::infinity())
       v_alive.push_back(std::get<0>(*it));
     else if (std::get<1>(*it) - std::get<0>(*it) > e)
-      v.push_back(Internal_point(std::get<0>(*it), std::get<1>(*it), v.size()));
+      v_points.push_back(Internal_point(std::get<0>(*it), std::get<1>(*it), v_points.size()));
   }
-  if (u.size() < v.size())
-    swap(u, v);
+  if (u_points.size() < v_points.size())
+    swap(u_points, v_points);
+  u = std::make_shared<const std::vector<Internal_point>>(std::move(u_points));
+  v = std::make_shared<const std::vector<Internal_point>>(std::move(v_points));
   std::sort(u_alive.begin(), u_alive.end());
   std::sort(v_alive.begin(), v_alive.end());
   if (u_alive.size() != v_alive.size()) {
@@ -94,22 +105,30 @@ Persistence_graph::Persistence_graph(const Persistence_diagram1 &diag1,
   }
 }
 
+inline Persistence_graph::Persistence_graph(std::shared_ptr<const std::vector<Internal_point>> u_points,
+                                            std::shared_ptr<const std::vector<Internal_point>> v_points,
+                                            double b_alive)
+    : u(std::move(u_points)), v(std::move(v_points)), b_alive(b_alive) {
+  if (u->size() < v->size())
+    std::swap(u, v);
+}
+
 inline bool Persistence_graph::on_the_u_diagonal(int u_point_index) const {
-  return u_point_index >= static_cast<int> (u.size());
+  return u_point_index >= static_cast<int> (u->size());
 }
 
 inline bool Persistence_graph::on_the_v_diagonal(int v_point_index) const {
-  return v_point_index >= static_cast<int> (v.size());
+  return v_point_index >= static_cast<int> (v->size());
 }
 
 inline int Persistence_graph::corresponding_point_in_u(int v_point_index) const {
   return on_the_v_diagonal(v_point_index) ?
-      v_point_index - static_cast<int> (v.size()) : v_point_index + static_cast<int> (u.size());
+      v_point_index - static_cast<int> (v->size()) : v_point_index + static_cast<int> (u->size());
 }
 
 inline int Persistence_graph::corresponding_point_in_v(int u_point_index) const {
   return on_the_u_diagonal(u_point_index) ?
-      u_point_index - static_cast<int> (u.size()) : u_point_index + static_cast<int> (v.size());
+      u_point_index - static_cast<int> (u->size()) : u_point_index + static_cast<int> (v->size());
 }
 
 inline double Persistence_graph::distance(int u_point_index, int v_point_index) const {
@@ -121,7 +140,7 @@ inline double Persistence_graph::distance(int u_point_index, int v_point_index)
 }
 
 inline int Persistence_graph::size() const {
-  return static_cast<int> (u.size() + v.size());
+  return static_cast<int> (u->size() + v->size());
 }
 
 inline double Persistence_graph::bottleneck_alive() const {
@@ -146,25 +165,25 @@ inline std::vector<double> Persistence_graph::sorted_distances() const {
 
 inline Internal_point Persistence_graph::get_u_point(int u_point_index) const {
   if (!on_the_u_diagonal(u_point_index))
-    return u.at(u_point_index);
-  Internal_point projector = v.at(corresponding_point_in_v(u_point_index));
+    return u->at(u_point_index);
+  Internal_point projector = v->at(corresponding_point_in_v(u_point_index));
   double m = (projector.x() + projector.y()) / 2.;
   return Internal_point(m, m, u_point_index);
 }
 
 inline Internal_point Persistence_graph::get_v_point(int v_point_index) const {
   if (!on_the_v_diagonal(v_point_index))
-    return v.at(v_point_index);
-  Internal_point projector = u.at(corresponding_point_in_u(v_point_index));
+    return v->at(v_point_index);
+  Internal_point projector = u->at(corresponding_point_in_u(v_point_index));
   double m = (projector.x() + projector.y()) / 2.;
   return Internal_point(m, m, v_point_index);
 }
 
 inline double Persistence_graph::diameter_bound() const {
   double max = 0.;
-  for (auto it = u.cbegin(); it != u.cend(); it++)
+  for (auto it = u->cbegin(); it != u->cend(); it++)
     max = (std::max)(max, it->y());
-  for (auto it = v.cbegin(); it != v.cend(); it++)
+  for (auto it = v->cbegin(); it != v->cend(); it++)
     max = (std::max)(max, it->y());
   return max;
 }
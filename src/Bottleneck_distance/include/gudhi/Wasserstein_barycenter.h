@@ -0,0 +1,244 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef WASSERSTEIN_BARYCENTER_H_
+#define WASSERSTEIN_BARYCENTER_H_
+
+#include <gudhi/Wasserstein_distance.h>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::sort, std::min_element
+#include <iterator>  // for std::begin, std::end
+#include <tuple>  // for std::get
+#include <cstddef>  // for std::size_t
+#include <stdexcept>  // for std::invalid_argument
+
+namespace Gudhi {
+
+namespace persistence_diagram {
+
+/** \brief Lagrangian estimation of a Fréchet mean (barycenter) of persistence diagrams for the 2-Wasserstein
+ * distance, as described in \cite turner2014frechet .
+ *
+ * \details
+ * Starting from an initial diagram, each iteration matches the current estimate to every diagram, then moves each
+ * point of the estimate to the (arithmetic) mean of the points it is matched to, where a diagonal point counts as the
+ * projection of the mean on the diagonal. Points of a diagram matched to the diagonal create new points in the
+ * estimate. The iterations stop when the estimate does not move anymore, which gives a local minimum of the Fréchet
+ * energy.
+ *
+ * The matchings are computed by `Wasserstein_auction`, in parallel over the diagrams when TBB is available. The prices
+ * of the auction between the estimate and each diagram are kept from one iteration to the next, where the estimate
+ * only moves slightly, which makes the later iterations much cheaper.
+ *
+ * All the points of the diagrams must be finite.
+ *
+ * \ingroup bottleneck_distance
+ */
+class Lagrangian_barycenter {
+ public:
+  typedef std::pair<double, double> Point;
+  typedef std::vector<Point> Diagram;
+  typedef std::vector<std::pair<int, int>> Grouping;
+
+  /** \brief Constructor, no computation is done.
+   *
+   * \tparam Persistence_diagram_range A range whose value type is a model of the concept `PersistenceDiagram`.
+   *
+   * @param[in] diagrams The persistence diagrams to average.
+   * @param[in] delta Relative error of the matchings, see `Wasserstein_auction::compute()`.
+   * @exception std::invalid_argument If a diagram contains a point with an infinite coordinate.
+   */
+  template<typename Persistence_diagram_range>
+  explicit Lagrangian_barycenter(const Persistence_diagram_range &diagrams, double delta = 1e-6) : delta_(delta) {
+    for (auto it = std::begin(diagrams); it != std::end(diagrams); ++it) {
+      diagrams_.emplace_back(*it);
+      check_finite(diagrams_.back());
+    }
+    prices_.resize(diagrams_.size());
+  }
+
+  /** \brief Computes a barycenter estimate.
+   *
+   * \tparam Persistence_diagram A model of the concept `PersistenceDiagram`.
+   *
+   * @param[in] init The initial estimate, with finite points.
+   * @param[in] max_iterations Maximal number of iterations, in case the approximate matchings keep alternating between
+   * equivalent solutions.
+   * @return The barycenter estimate. It is empty if the range of diagrams is empty.
+   */
+  template<typename Persistence_diagram>
+  Diagram compute(const Persistence_diagram &init, int max_iterations = 1000) {
+    const std::size_t m = diagrams_.size();
+    barycenter_.clear();
+    groupings_.clear();
+    number_of_iterations_ = 0;
+    if (m == 0) return barycenter_;
+    for (auto it = std::begin(init); it != std::end(init); ++it)
+      barycenter_.emplace_back(std::get<0>(*it), std::get<1>(*it));
+    check_finite(internal::Wasserstein_diagram(barycenter_));
+
+    bool converged = false;
+    while (!converged && number_of_iterations_ < max_iterations) {
+      ++number_of_iterations_;
+      match_all();
+      const std::size_t k = barycenter_.size();
+
+      // Move each point of the estimate to the mean of its matched points
+      Diagram updated;
+      for (std::size_t j = 0; j < k; ++j) {
+        double sum_x = 0., sum_y = 0.;
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < m; ++i) {
+          int matched = matched_[i][j];
+          if (matched < 0) continue;
+          sum_x += diagrams_[i].finite[matched].first;
+          sum_y += diagrams_[i].finite[matched].second;
+          ++count;
+        }
+        // A point matched to the diagonal in all the diagrams is removed
+        if (count > 0) updated.push_back(mean(sum_x, sum_y, count));
+      }
+
+      // Points matched to the diagonal of the estimate create new points
+      bool created = false;
+      for (std::size_t i = 0; i < m; ++i) {
+        for (int x : created_[i]) {
+          updated.push_back(mean(diagrams_[i].finite[x].first, diagrams_[i].finite[x].second, 1));
+          created = true;
+        }
+      }
+      converged = !created && updated == barycenter_;
+      barycenter_.swap(updated);
+    }
+    return barycenter_;
+  }
+
+  /** \brief Returns the number of iterations performed by the last call to `compute()`. */
+  int number_of_iterations() const { return number_of_iterations_; }
+
+  /** \brief Computes the optimal matchings between the estimate returned by the last call to `compute()` and each
+   * diagram, and the Fréchet energy of the estimate.
+   *
+   * @return The mean of the 2-Wasserstein distances between the estimate and the diagrams. Afterwards, `groupings()`
+   * returns the matchings.
+   */
+  double compute_energy() {
+    const std::size_t m = diagrams_.size();
+    groupings_.assign(m, Grouping());
+    std::vector<double> distances(m, 0.);
+    if (m == 0) return 0.;
+    internal::Wasserstein_diagram current(barycenter_);
+    auto match = [&](std::size_t i) {
+      Wasserstein_auction auction(current, diagrams_[i], 2., 2.);
+      auction.set_prices(adapted_prices(i, current));
+      distances[i] = auction.compute(delta_);
+      prices_[i] = auction.prices();
+      groupings_[i] = auction.matching();
+      std::sort(groupings_[i].begin(), groupings_[i].end());
+    };
+    for_each_diagram(match);
+    double energy = 0.;
+    for (double d : distances) energy += d;
+    return energy / m;
+  }
+
+  /** \brief Returns, for each diagram, the pairs `(j, i)` meaning that the point `j` of the estimate is matched to the
+   * point `i` of the diagram, -1 representing the diagonal. Only available after `compute_energy()`.
+   */
+  std::vector<Grouping> const &groupings() const { return groupings_; }
+
+ private:
+  static void check_finite(internal::Wasserstein_diagram const &diag) {
+    if (!diag.infinite_death.empty() || !diag.infinite_birth.empty() || !diag.both_infinite.empty())
+      throw std::invalid_argument("Lagrangian_barycenter - diagrams must only contain finite points");
+  }
+
+  // Mean of count points (of coordinate sums sum_x and sum_y) and of diagrams_.size() - count copies of the diagonal,
+  // located at the projection of the mean of the points
+  Point mean(double sum_x, double sum_y, std::size_t count) const {
+    const double m = static_cast<double>(diagrams_.size());
+    double x = sum_x / count;
+    double y = sum_y / count;
+    double d = (x + y) / 2;
+    return Point((count * x + (m - count) * d) / m, (count * y + (m - count) * d) / m);
+  }
+
+  template<typename Function>
+  void for_each_diagram(Function const &f) const {
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), diagrams_.size(), f);
+#else
+    for (std::size_t i = 0; i < diagrams_.size(); ++i) f(i);
+#endif
+  }
+
+  // The objects of the auction are the points of the diagram followed by the diagonal copies of the points of the
+  // estimate. The latter are interchangeable, so when the estimate changes size the previous prices are kept for the
+  // points of the diagram and the diagonal copies are given the lowest previous diagonal price.
+  std::vector<double> adapted_prices(std::size_t i, internal::Wasserstein_diagram const &current) const {
+    std::vector<double> prices = prices_[i];
+    const std::size_t n2 = diagrams_[i].finite.size();
+    if (prices.size() < n2) return prices;
+    const std::size_t size = n2 + current.finite.size();
+    if (prices.size() != size) {
+      double diagonal_price = prices.size() > n2 ? *std::min_element(prices.begin() + n2, prices.end()) : 0.;
+      prices.resize(size, diagonal_price);
+    }
+    return prices;
+  }
+
+  // Matches the current estimate to every diagram, filling matched_ and created_
+  void match_all() {
+    const std::size_t m = diagrams_.size();
+    const std::size_t k = barycenter_.size();
+    internal::Wasserstein_diagram current(barycenter_);
+    matched_.assign(m, std::vector<int>(k, -1));
+    created_.assign(m, std::vector<int>());
+    auto match = [&](std::size_t i) {
+      Wasserstein_auction auction(current, diagrams_[i], 2., 2.);
+      auction.set_prices(adapted_prices(i, current));
+      auction.compute(delta_);
+      prices_[i] = auction.prices();
+      auto pairs = auction.matching();
+      std::sort(pairs.begin(), pairs.end());
+      for (auto const &p : pairs) {
+        if (p.first >= 0)
+          matched_[i][p.first] = p.second;
+        else if (p.second >= 0)
+          created_[i].push_back(p.second);
+      }
+    };
+    for_each_diagram(match);
+  }
+
+  std::vector<internal::Wasserstein_diagram> diagrams_;
+  double delta_;
+  Diagram barycenter_;
+  int number_of_iterations_ = 0;
+  // Warm start prices of the auction between the estimate and each diagram
+  std::vector<std::vector<double>> prices_;
+  // matched_[i][j] is the point of diagram i matched to point j of the estimate, or -1 for the diagonal
+  std::vector<std::vector<int>> matched_;
+  // Points of diagram i matched to the diagonal of the estimate
+  std::vector<std::vector<int>> created_;
+  std::vector<Grouping> groupings_;
+};
+
+}  // namespace persistence_diagram
+
+}  // namespace Gudhi
+
+#endif  // WASSERSTEIN_BARYCENTER_H_
@@ -0,0 +1,623 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef WASSERSTEIN_DISTANCE_H_
+#define WASSERSTEIN_DISTANCE_H_
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::sort, std::max, std::min_element, std::fill, std::push_heap, std::pop_heap
+#include <functional>  // for std::greater
+#include <limits>  // for std::numeric_limits
+#include <iterator>  // for std::begin, std::end
+#include <tuple>  // for std::get
+#include <cmath>  // for std::pow, std::abs, std::isinf
+#include <cstddef>  // for std::size_t
+#include <stdexcept>  // for std::invalid_argument
+#include <memory>  // for std::unique_ptr
+
+namespace Gudhi {
+
+namespace persistence_diagram {
+
+namespace internal {
+
+/** \internal \brief Kd-tree on the finite points of a persistence diagram, used to find the best bids of an auction.
+ * A leaf holds a range of `points`, and the nodes are stored in depth-first order, so the children of a node come
+ * after it.
+ */
+struct Wasserstein_kd_tree {
+  struct Node {
+    double min_x, max_x, min_y, max_y;  // bounding box of the points
+    int begin, end;  // range of the points in points
+    int left, right;  // children, -1 for a leaf
+    int parent;
+  };
+
+  static constexpr int leaf_size = 8;
+
+  std::vector<Node> nodes;
+  // Indices of the finite points, in the order of the leaves
+  std::vector<int> points;
+  // Leaf containing each finite point
+  std::vector<int> leaf;
+
+  Wasserstein_kd_tree() = default;
+
+  explicit Wasserstein_kd_tree(std::vector<std::pair<double, double>> const &finite)
+      : points(finite.size()), leaf(finite.size()) {
+    if (finite.empty()) return;
+    for (std::size_t i = 0; i < finite.size(); ++i) points[i] = static_cast<int>(i);
+    build(finite, 0, static_cast<int>(finite.size()), -1);
+  }
+
+ private:
+  int build(std::vector<std::pair<double, double>> const &finite, int begin, int end, int parent) {
+    const double inf = std::numeric_limits<double>::infinity();
+    Node node{inf, -inf, inf, -inf, begin, end, -1, -1, parent};
+    for (int k = begin; k < end; ++k) {
+      auto const &p = finite[points[k]];
+      node.min_x = (std::min)(node.min_x, p.first);
+      node.max_x = (std::max)(node.max_x, p.first);
+      node.min_y = (std::min)(node.min_y, p.second);
+      node.max_y = (std::max)(node.max_y, p.second);
+    }
+    const int index = static_cast<int>(nodes.size());
+    nodes.push_back(node);
+    if (end - begin <= leaf_size) {
+      for (int k = begin; k < end; ++k) leaf[points[k]] = index;
+      return index;
+    }
+    // Split the widest side at the median
+    const bool split_x = node.max_x - node.min_x >= node.max_y - node.min_y;
+    const int middle = begin + (end - begin) / 2;
+    std::nth_element(points.begin() + begin, points.begin() + middle, points.begin() + end, [&](int a, int b) {
+      return split_x ? finite[a].first < finite[b].first : finite[a].second < finite[b].second;
+    });
+    const int left = build(finite, begin, middle, index);
+    const int right = build(finite, middle, end, index);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+  }
+};
+
+/** \internal \brief Points of a persistence diagram, split between finite points and the different kinds of essential
+ * points (sorted by their finite coordinate), with their index in the input diagram.
+ */
+struct Wasserstein_diagram {
+  typedef std::pair<double, int> Essential_point;  // (finite coordinate, index)
+
+  std::vector<std::pair<double, double>> finite;
+  std::vector<int> finite_index;
+  std::vector<Essential_point> infinite_death;
+  std::vector<Essential_point> infinite_birth;
+  std::vector<int> both_infinite;
+  // Kd-tree on the finite points
+  Wasserstein_kd_tree tree;
+
+  template<typename Persistence_diagram>
+  explicit Wasserstein_diagram(const Persistence_diagram &diag) {
+    const double inf = std::numeric_limits<double>::infinity();
+    int index = 0;
+    for (auto it = std::begin(diag); it != std::end(diag); ++it, ++index) {
+      double birth = std::get<0>(*it);
+      double death = std::get<1>(*it);
+      bool infinite_b = std::isinf(birth);
+      bool infinite_d = std::isinf(death);
+      if (infinite_b && infinite_d) {
+        both_infinite.push_back(index);
+      } else if (death == inf) {
+        infinite_death.emplace_back(birth, index);
+      } else if (birth == -inf) {
+        infinite_birth.emplace_back(death, index);
+      } else {
+        finite.emplace_back(birth, death);
+        finite_index.push_back(index);
+      }
+    }
+    std::sort(infinite_death.begin(), infinite_death.end());
+    std::sort(infinite_birth.begin(), infinite_birth.end());
+    tree = Wasserstein_kd_tree(finite);
+  }
+};
+
+}  // namespace internal
+
+/** \brief Auction algorithm computing the Wasserstein distance between two persistence diagrams.
+ *
+ * \details
+ * The distance between two diagrams is the minimum, over all the matchings between their points (a point may also be
+ * matched to the diagonal), of \f$(\sum \|p - \sigma(p)\|_{internal\_p}^{order})^{1/order}\f$. Essential points
+ * (with an infinite coordinate) are matched with essential points of the same kind, and if their numbers differ the
+ * distance is infinite.
+ *
+ * The finite points are matched by the auction algorithm of Bertsekas with \f$\varepsilon\f$-scaling, as in Hera
+ * \cite Kerber:2017:GHC:3047249.3064175. The computation stops as soon as the result is guaranteed to be within a
+ * relative error `delta` of the exact distance. As in Hera, the best bids are found in a kd-tree on the points of the
+ * second diagram, whose nodes keep the lowest price of their points.
+ *
+ * The prices of the auction can be read after a computation and given back to another computation between diagrams
+ * of the same sizes (for instance when one of the diagrams moves slightly), which usually makes it much faster.
+ *
+ * \ingroup bottleneck_distance
+ */
+class Wasserstein_auction {
+ public:
+  /** \brief Constructor, no computation is done.
+   *
+   * \tparam Persistence_diagram1,Persistence_diagram2 models of the concept `PersistenceDiagram`.
+   *
+   * @param[in] diag1 The first persistence diagram.
+   * @param[in] diag2 The second persistence diagram.
+   * @param[in] order Wasserstein exponent, at least 1.
+   * @param[in] internal_p Internal Minkowski norm \f$L^p\f$ in \f$\mathbb{R}^2\f$, at least 1 (may be infinite).
+   * @exception std::invalid_argument If `order` or `internal_p` is less than 1, or if `order` is infinite.
+   */
+  template<typename Persistence_diagram1, typename Persistence_diagram2>
+  Wasserstein_auction(const Persistence_diagram1 &diag1, const Persistence_diagram2 &diag2, double order = 1.,
+                      double internal_p = std::numeric_limits<double>::infinity())
+      : Wasserstein_auction(std::unique_ptr<internal::Wasserstein_diagram>(new internal::Wasserstein_diagram(diag1)),
+                            std::unique_ptr<internal::Wasserstein_diagram>(new internal::Wasserstein_diagram(diag2)),
+                            order, internal_p) {}
+
+  /** \internal \brief Constructor from preprocessed diagrams, which are not copied and must outlive the auction. */
+  Wasserstein_auction(const internal::Wasserstein_diagram &diag1, const internal::Wasserstein_diagram &diag2,
+                      double order, double internal_p)
+      : d1_(&diag1), d2_(&diag2), order_(order), internal_p_(internal_p),
+        n1_(static_cast<int>(diag1.finite.size())), n2_(static_cast<int>(diag2.finite.size())) {
+    if (!(order >= 1.) || std::isinf(order))
+      throw std::invalid_argument("Wasserstein_auction - order must be a finite number larger than 1");
+    if (!(internal_p >= 1.))
+      throw std::invalid_argument("Wasserstein_auction - internal_p must be larger than 1");
+    const int n = n1_ + n2_;
+    prices_.assign(n, 0.);
+    bidder_to_object_.assign(n, -1);
+  }
+
+  /** \brief Sets the initial prices of the next computation (warm start).
+   * @param[in] prices Prices returned by `prices()` after a computation between diagrams with the same number of
+   * finite points. Ignored if the size does not match.
+   */
+  void set_prices(std::vector<double> const &prices) {
+    if (prices.size() == prices_.size()) {
+      prices_ = prices;
+      warm_start_ = true;
+    }
+  }
+
+  /** \brief Returns the prices of the auction, to warm start another computation. */
+  std::vector<double> const &prices() const { return prices_; }
+
+  /** \brief Computes the (approximate) Wasserstein distance.
+   * @param[in] delta Relative error, must be positive.
+   * @return A value between the Wasserstein distance and `1 + delta` times this distance.
+   */
+  double compute(double delta = .01) {
+    if (!(delta > 0.))
+      throw std::invalid_argument("Wasserstein_auction - delta must be positive");
+    double essential_cost = compute_essential_cost();
+    if (std::isinf(essential_cost))
+      return essential_cost;
+    double finite_cost = run_auction(delta);
+    return std::pow(essential_cost + finite_cost, 1. / order_);
+  }
+
+  /** \brief Returns the matching found by the last call to `compute()`, as pairs of indices in the input diagrams,
+   * -1 meaning the diagonal. Pairs of two diagonal points are not listed.
+   */
+  std::vector<std::pair<int, int>> matching() const {
+    std::vector<std::pair<int, int>> result;
+    if (!essential_match_) return result;
+    auto add_essential = [&](std::vector<internal::Wasserstein_diagram::Essential_point> const &e1,
+                             std::vector<internal::Wasserstein_diagram::Essential_point> const &e2) {
+      for (std::size_t i = 0; i < e1.size(); ++i) result.emplace_back(e1[i].second, e2[i].second);
+    };
+    add_essential(d1_->infinite_death, d2_->infinite_death);
+    add_essential(d1_->infinite_birth, d2_->infinite_birth);
+    for (std::size_t i = 0; i < d1_->both_infinite.size(); ++i)
+      result.emplace_back(d1_->both_infinite[i], d2_->both_infinite[i]);
+    for (int bidder = 0; bidder < n1_ + n2_; ++bidder) {
+      int object = bidder_to_object_[bidder];
+      if (object < 0) continue;
+      int i = bidder < n1_ ? d1_->finite_index[bidder] : -1;
+      int j = object < n2_ ? d2_->finite_index[object] : -1;
+      if (i >= 0 || j >= 0) result.emplace_back(i, j);
+    }
+    return result;
+  }
+
+ private:
+  Wasserstein_auction(std::unique_ptr<internal::Wasserstein_diagram> diag1,
+                      std::unique_ptr<internal::Wasserstein_diagram> diag2, double order, double internal_p)
+      : Wasserstein_auction(*diag1, *diag2, order, internal_p) {
+    owned1_ = std::move(diag1);
+    owned2_ = std::move(diag2);
+  }
+
+  // Best and second best values (minus cost and price) of the objects for a bidder
+  struct Bid {
+    int best_object = -1;
+    double best_value = -std::numeric_limits<double>::infinity();
+    double second_value = -std::numeric_limits<double>::infinity();
+
+    void consider(int object, double value) {
+      if (value > best_value) {
+        second_value = best_value;
+        best_value = value;
+        best_object = object;
+      } else if (value > second_value) {
+        second_value = value;
+      }
+    }
+  };
+
+  // Bidders are the finite points of diag1 (0 to n1-1) and diagonal points, one per point of diag2 (n1 to n1+n2-1).
+  // Objects are the finite points of diag2 (0 to n2-1) and diagonal points, one per point of diag1 (n2 to n2+n1-1).
+  // All diagonal points are interchangeable, so any diagonal bidder may get any diagonal object.
+
+  double distance(double x1, double y1, double x2, double y2) const {
+    double dx = std::abs(x1 - x2);
+    double dy = std::abs(y1 - y2);
+    if (std::isinf(internal_p_)) return (std::max)(dx, dy);
+    if (internal_p_ == 1.) return dx + dy;
+    return std::pow(std::pow(dx, internal_p_) + std::pow(dy, internal_p_), 1. / internal_p_);
+  }
+
+  double power(double d) const {
+    if (order_ == 1.) return d;
+    if (order_ == 2.) return d * d;
+    return std::pow(d, order_);
+  }
+
+  double distance_to_diagonal(std::pair<double, double> const &p) const {
+    double m = (p.first + p.second) / 2;
+    return distance(p.first, p.second, m, m);
+  }
+
+  double finite_cost(double x1, double y1, double x2, double y2) const {
+    if (order_ == internal_p_) {
+      // No root to take
+      return power(std::abs(x1 - x2)) + power(std::abs(y1 - y2));
+    }
+    return power(distance(x1, y1, x2, y2));
+  }
+
+  double cost(int bidder, int object) const {
+    if (bidder < n1_) {
+      if (object < n2_) {
+        auto const &a = d1_->finite[bidder];
+        auto const &b = d2_->finite[object];
+        return finite_cost(a.first, a.second, b.first, b.second);
+      }
+      return diag_cost1_[bidder];
+    }
+    return object < n2_ ? diag_cost2_[object] : 0.;
+  }
+
+  // Lowest prices, and lowest sums of the price and the cost to the diagonal, of the finite objects in each node of
+  // the kd-tree
+  void init_node_prices() {
+    auto const &nodes = d2_->tree.nodes;
+    node_min_price_.resize(nodes.size());
+    node_min_diagonal_.resize(nodes.size());
+    // Children come after their parent
+    for (int node = static_cast<int>(nodes.size()) - 1; node >= 0; --node) update_node_prices(node);
+  }
+
+  // Returns whether the values of the node changed
+  bool update_node_prices(int node) {
+    auto const &n = d2_->tree.nodes[node];
+    double min_price = std::numeric_limits<double>::infinity();
+    double min_diagonal = std::numeric_limits<double>::infinity();
+    if (n.left < 0) {
+      for (int k = n.begin; k < n.end; ++k) {
+        const int object = d2_->tree.points[k];
+        min_price = (std::min)(min_price, prices_[object]);
+        min_diagonal = (std::min)(min_diagonal, diag_cost2_[object] + prices_[object]);
+      }
+    } else {
+      min_price = (std::min)(node_min_price_[n.left], node_min_price_[n.right]);
+      min_diagonal = (std::min)(node_min_diagonal_[n.left], node_min_diagonal_[n.right]);
+    }
+    if (min_price == node_min_price_[node] && min_diagonal == node_min_diagonal_[node]) return false;
+    node_min_price_[node] = min_price;
+    node_min_diagonal_[node] = min_diagonal;
+    return true;
+  }
+
+  // Called after the price of a finite object changed
+  void update_price(int object) {
+    int node = d2_->tree.leaf[object];
+    while (node >= 0 && update_node_prices(node)) node = d2_->tree.nodes[node].parent;
+  }
+
+  // Lower bound of the cost plus the price of the objects of the node, for a finite bidder at (x, y)
+  double lower_bound(double x, double y, int node) const {
+    auto const &n = d2_->tree.nodes[node];
+    double cx = (std::min)((std::max)(x, n.min_x), n.max_x);
+    double cy = (std::min)((std::max)(y, n.min_y), n.max_y);
+    return finite_cost(x, y, cx, cy) + node_min_price_[node];
+  }
+
+  // Finds the best finite objects for the finite bidder at (x, y), ignoring the nodes which cannot improve the bid
+  void search_finite_objects(double x, double y, int node, Bid &bid) const {
+    auto const &tree = d2_->tree;
+    auto const &n = tree.nodes[node];
+    if (n.left < 0) {
+      for (int k = n.begin; k < n.end; ++k) {
+        const int object = tree.points[k];
+        auto const &b = d2_->finite[object];
+        bid.consider(object, -finite_cost(x, y, b.first, b.second) - prices_[object]);
+      }
+      return;
+    }
+    int first = n.left;
+    int second = n.right;
+    double first_bound = lower_bound(x, y, first);
+    double second_bound = lower_bound(x, y, second);
+    if (second_bound < first_bound) {
+      std::swap(first, second);
+      std::swap(first_bound, second_bound);
+    }
+    if (-first_bound > bid.second_value) search_finite_objects(x, y, first, bid);
+    if (-second_bound > bid.second_value) search_finite_objects(x, y, second, bid);
+  }
+
+  // Same for a diagonal bidder, whose cost to a finite object is the distance of the object to the diagonal
+  void search_finite_objects(int node, Bid &bid) const {
+    auto const &tree = d2_->tree;
+    auto const &n = tree.nodes[node];
+    if (n.left < 0) {
+      for (int k = n.begin; k < n.end; ++k) {
+        const int object = tree.points[k];
+        bid.consider(object, -diag_cost2_[object] - prices_[object]);
+      }
+      return;
+    }
+    int first = n.left;
+    int second = n.right;
+    if (node_min_diagonal_[second] < node_min_diagonal_[first]) std::swap(first, second);
+    if (-node_min_diagonal_[first] > bid.second_value) search_finite_objects(first, bid);
+    if (-node_min_diagonal_[second] > bid.second_value) search_finite_objects(second, bid);
+  }
+
+  double compute_essential_cost() {
+    essential_match_ = false;
+    if (d1_->infinite_death.size() != d2_->infinite_death.size() ||
+        d1_->infinite_birth.size() != d2_->infinite_birth.size() ||
+        d1_->both_infinite.size() != d2_->both_infinite.size())
+      return std::numeric_limits<double>::infinity();
+    essential_match_ = true;
+    double res = 0.;
+    // Sorted matching is optimal for a convex cost
+    for (std::size_t i = 0; i < d1_->infinite_death.size(); ++i)
+      res += power(std::abs(d1_->infinite_death[i].first - d2_->infinite_death[i].first));
+    for (std::size_t i = 0; i < d1_->infinite_birth.size(); ++i)
+      res += power(std::abs(d1_->infinite_birth[i].first - d2_->infinite_birth[i].first));
+    return res;
+  }
+
+  double run_auction(double delta) {
+    const int n = n1_ + n2_;
+    if (n == 0) return 0.;
+    diag_cost1_.resize(n1_);
+    diag_cost2_.resize(n2_);
+    double max_cost = 0.;
+    for (int i = 0; i < n1_; ++i) {
+      diag_cost1_[i] = power(distance_to_diagonal(d1_->finite[i]));
+      max_cost = (std::max)(max_cost, diag_cost1_[i]);
+    }
+    for (int j = 0; j < n2_; ++j) {
+      diag_cost2_[j] = power(distance_to_diagonal(d2_->finite[j]));
+      max_cost = (std::max)(max_cost, diag_cost2_[j]);
+    }
+    if (n1_ > 0 && n2_ > 0) {
+      // Bounded by the cost between the farthest corners of the bounding boxes
+      auto const &box1 = d1_->tree.nodes[0];
+      auto const &box2 = d2_->tree.nodes[0];
+      double dx = (std::max)(box1.max_x - box2.min_x, box2.max_x - box1.min_x);
+      double dy = (std::max)(box1.max_y - box2.min_y, box2.max_y - box1.min_y);
+      max_cost = (std::max)(max_cost, finite_cost(0., 0., dx, dy));
+    }
+    init_node_prices();
+    if (max_cost == 0.) {
+      // Everything is on the diagonal or matched at distance 0, any perfect matching works
+      run_round(1.);
+      return 0.;
+    }
+    // A warm start only needs to repair the previous assignment
+    double epsilon = warm_start_ ? max_cost / (4. * n) : max_cost / 4.;
+    warm_start_ = false;
+    const double min_epsilon = max_cost * std::numeric_limits<double>::epsilon();
+    while (true) {
+      double total = run_round(epsilon);
+      // The assignment is within n * epsilon of the optimum
+      if (total == 0. || (1. + delta) * n * epsilon <= delta * total || epsilon <= min_epsilon) return total;
+      epsilon /= 5.;
+    }
+  }
+
+  // One round of Gauss-Seidel auction, returns the cost of the resulting assignment
+  double run_round(double epsilon) {
+    const int n = n1_ + n2_;
+    std::vector<int> object_to_bidder(n, -1);
+    std::fill(bidder_to_object_.begin(), bidder_to_object_.end(), -1);
+    std::vector<int> unassigned(n);
+    for (int i = 0; i < n; ++i) unassigned[i] = n - 1 - i;
+    // The diagonal objects are interchangeable, so they can all get the lowest of their prices, which avoids price
+    // wars between them. A bidder has the same cost for all of them and only looks at the two cheapest ones, kept in
+    // a heap where outdated prices are removed lazily.
+    typedef std::pair<double, int> Price;
+    std::vector<Price> diagonal_prices;
+    if (n1_ > 0) {
+      double lowest = *std::min_element(prices_.begin() + n2_, prices_.end());
+      std::fill(prices_.begin() + n2_, prices_.end(), lowest);
+      for (int object = n2_; object < n; ++object) diagonal_prices.emplace_back(lowest, object);
+    }
+    auto pop_outdated = [&]() {
+      while (!diagonal_prices.empty() && diagonal_prices.front().first != prices_[diagonal_prices.front().second]) {
+        std::pop_heap(diagonal_prices.begin(), diagonal_prices.end(), std::greater<Price>());
+        diagonal_prices.pop_back();
+      }
+    };
+    while (!unassigned.empty()) {
+      int bidder = unassigned.back();
+      unassigned.pop_back();
+      Bid bid;
+      if (n2_ > 0) {
+        if (bidder < n1_)
+          search_finite_objects(d1_->finite[bidder].first, d1_->finite[bidder].second, 0, bid);
+        else
+          search_finite_objects(0, bid);
+      }
+      if (n1_ > 0) {
+        const double diagonal_cost = cost(bidder, n2_);
+        pop_outdated();
+        Price cheapest = diagonal_prices.front();
+        bid.consider(cheapest.second, -diagonal_cost - cheapest.first);
+        std::pop_heap(diagonal_prices.begin(), diagonal_prices.end(), std::greater<Price>());
+        diagonal_prices.pop_back();
+        pop_outdated();
+        if (!diagonal_prices.empty())
+          bid.consider(diagonal_prices.front().second, -diagonal_cost - diagonal_prices.front().first);
+        diagonal_prices.push_back(cheapest);
+        std::push_heap(diagonal_prices.begin(), diagonal_prices.end(), std::greater<Price>());
+      }
+      const int best_object = bid.best_object;
+      double increment = (std::isinf(bid.second_value) ? 0. : bid.best_value - bid.second_value) + epsilon;
+      prices_[best_object] += increment;
+      if (best_object < n2_) {
+        update_price(best_object);
+      } else {
+        diagonal_prices.emplace_back(prices_[best_object], best_object);
+        std::push_heap(diagonal_prices.begin(), diagonal_prices.end(), std::greater<Price>());
+      }
+      int previous = object_to_bidder[best_object];
+      if (previous >= 0) {
+        bidder_to_object_[previous] = -1;
+        unassigned.push_back(previous);
+      }
+      object_to_bidder[best_object] = bidder;
+      bidder_to_object_[bidder] = best_object;
+    }
+    double total = 0.;
+    for (int bidder = 0; bidder < n; ++bidder) total += cost(bidder, bidder_to_object_[bidder]);
+    return total;
+  }
+
+  const internal::Wasserstein_diagram *d1_;
+  const internal::Wasserstein_diagram *d2_;
+  // Only set when the auction preprocessed the diagrams itself
+  std::unique_ptr<internal::Wasserstein_diagram> owned1_;
+  std::unique_ptr<internal::Wasserstein_diagram> owned2_;
+  double order_;
+  double internal_p_;
+  int n1_;
+  int n2_;
+  std::vector<double> diag_cost1_;
+  std::vector<double> diag_cost2_;
+  std::vector<double> prices_;
+  std::vector<int> bidder_to_object_;
+  std::vector<double> node_min_price_;
+  std::vector<double> node_min_diagonal_;
+  bool warm_start_ = false;
+  bool essential_match_ = false;
+};
+
+/** \brief Function to compute the Wasserstein distance between two persistence diagrams.
+ *
+ * \tparam Persistence_diagram1,Persistence_diagram2 models of the concept `PersistenceDiagram`.
+ *
+ * @param[in] diag1 The first persistence diagram.
+ * @param[in] diag2 The second persistence diagram.
+ * @param[in] order Wasserstein exponent, at least 1.
+ * @param[in] internal_p Internal Minkowski norm \f$L^p\f$ in \f$\mathbb{R}^2\f$ (may be infinite).
+ * @param[in] delta Relative error, must be positive.
+ * @return A value between the Wasserstein distance and `1 + delta` times this distance.
+ *
+ * \ingroup bottleneck_distance
+ */
+template<typename Persistence_diagram1, typename Persistence_diagram2>
+double wasserstein_distance(const Persistence_diagram1 &diag1, const Persistence_diagram2 &diag2, double order = 1.,
+                            double internal_p = std::numeric_limits<double>::infinity(), double delta = .01) {
+  return Wasserstein_auction(diag1, diag2, order, internal_p).compute(delta);
+}
+
+/** \brief Function to compute the matrix of Wasserstein distances between all the pairs of a range of persistence
+ * diagrams, in parallel when TBB is available. Each diagram is preprocessed once.
+ *
+ * \tparam Persistence_diagram_range A range whose value type is a model of the concept `PersistenceDiagram`.
+ *
+ * The parameters are the same as in `wasserstein_distance()`.
+ * \return The symmetric matrix of the distances, of size `n * n` for `n` diagrams, stored row by row.
+ *
+ * \ingroup bottleneck_distance
+ */
+template<typename Persistence_diagram_range>
+std::vector<double> wasserstein_distance_matrix(const Persistence_diagram_range &diagrams, double order = 1.,
+                                                double internal_p = std::numeric_limits<double>::infinity(),
+                                                double delta = .01) {
+  std::vector<internal::Wasserstein_diagram> diags;
+  for (auto it = std::begin(diagrams); it != std::end(diagrams); ++it) diags.emplace_back(*it);
+  const std::size_t n = diags.size();
+  std::vector<double> matrix(n * n, 0.);
+  auto compute_row = [&](std::size_t i) {
+    for (std::size_t j = i + 1; j < n; ++j)
+      matrix[i * n + j] = matrix[j * n + i] = Wasserstein_auction(diags[i], diags[j], order, internal_p).compute(delta);
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), n, compute_row);
+#else
+  for (std::size_t i = 0; i < n; ++i) compute_row(i);
+#endif
+  return matrix;
+}
+
+/** \brief Function to compute the matrix of Wasserstein distances between each persistence diagram of a range and
+ * each persistence diagram of another range, in parallel when TBB is available.
+ *
+ * The parameters are the same as in `wasserstein_distance()`.
+ * \return The matrix of the distances, of size `n1 * n2`, stored row by row: the distance between `diagrams1[i]`
+ * and `diagrams2[j]` is at index `i * n2 + j`.
+ *
+ * \ingroup bottleneck_distance
+ */
+template<typename Persistence_diagram_range1, typename Persistence_diagram_range2>
+std::vector<double> wasserstein_distance_matrix(const Persistence_diagram_range1 &diagrams1,
+                                                const Persistence_diagram_range2 &diagrams2, double order = 1.,
+                                                double internal_p = std::numeric_limits<double>::infinity(),
+                                                double delta = .01) {
+  std::vector<internal::Wasserstein_diagram> diags1, diags2;
+  for (auto it = std::begin(diagrams1); it != std::end(diagrams1); ++it) diags1.emplace_back(*it);
+  for (auto it = std::begin(diagrams2); it != std::end(diagrams2); ++it) diags2.emplace_back(*it);
+  const std::size_t n1 = diags1.size();
+  const std::size_t n2 = diags2.size();
+  std::vector<double> matrix(n1 * n2);
+  auto compute_entry = [&](std::size_t k) {
+    matrix[k] = Wasserstein_auction(diags1[k / n2], diags2[k % n2], order, internal_p).compute(delta);
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), n1 * n2, compute_entry);
+#else
+  for (std::size_t k = 0; k < n1 * n2; ++k) compute_entry(k);
+#endif
+  return matrix;
+}
+
+}  // namespace persistence_diagram
+
+}  // namespace Gudhi
+
+#endif  // WASSERSTEIN_DISTANCE_H_
@@ -113,6 +113,33 @@ BOOST_AUTO_TEST_CASE(layered_neighbors_finder) {
   BOOST_CHECK(v_point_index_2 == -1);
 }
 
+BOOST_AUTO_TEST_CASE(grid_neighbors_finder) {
+  Persistence_graph g(v1, v2, 0.);
+  const double r = upper_bound / 20.;
+  Grid_neighbors_finder nf(g, r);
+  std::vector<bool> added(g.size(), false);
+  for (int v_point_index = 1; v_point_index < ((n2 + n1)*9 / 10); v_point_index += 2) {
+    nf.add(v_point_index);
+    added[v_point_index] = true;
+  }
+  for (int u_point_index : {0, n1 / 2, n1 + n2 / 2}) {
+    // Brute force, the only projection that can be pulled from a point off the diagonal is its own projection
+    std::vector<int> expected;
+    for (int v_point_index = 0; v_point_index < g.size(); ++v_point_index)
+      if (added[v_point_index] && g.distance(u_point_index, v_point_index) <= r &&
+          (!g.on_the_v_diagonal(v_point_index) || v_point_index == g.corresponding_point_in_v(u_point_index)))
+        expected.push_back(v_point_index);
+    std::vector<int> l = nf.pull_all_near(u_point_index);
+    // A pair of projections is at distance 0, only the first one is pulled
+    if (g.on_the_u_diagonal(u_point_index))
+      continue;
+    std::sort(l.begin(), l.end());
+    BOOST_CHECK(l == expected);
+    for (int v_point_index : l) added[v_point_index] = false;
+    BOOST_CHECK(nf.pull_near(u_point_index) == null_point_index());
+  }
+}
+
 BOOST_AUTO_TEST_CASE(graph_matching) {
   Persistence_graph g(v1, v2, 0.);
   Graph_matching m1(g);
@@ -133,6 +160,27 @@ BOOST_AUTO_TEST_CASE(graph_matching) {
   BOOST_CHECK(!m1.perfect());
 }
 
+BOOST_AUTO_TEST_CASE(graph_matching_rollback) {
+  Persistence_graph g(v1, v2, 0.);
+  Grid_graph_matching m(g);
+  m.set_r(0.);
+  while (m.multi_augment()) {}
+  m.commit();
+  BOOST_CHECK(!m.perfect());
+  m.set_r(upper_bound);
+  while (m.multi_augment()) {}
+  BOOST_CHECK(m.perfect());
+  // Back to the matching for r = 0, which is maximal
+  m.rollback();
+  BOOST_CHECK(!m.perfect());
+  m.set_r(0.);
+  BOOST_CHECK(!m.multi_augment());
+  // The undone augmentations can be found again
+  m.set_r(upper_bound);
+  while (m.multi_augment()) {}
+  BOOST_CHECK(m.perfect());
+}
+
 BOOST_AUTO_TEST_CASE(global) {
   std::uniform_real_distribution<double> unif1(0., upper_bound);
   std::uniform_real_distribution<double> unif2(upper_bound / 10000., upper_bound / 100.);
@@ -154,3 +202,65 @@ BOOST_AUTO_TEST_CASE(global) {
   BOOST_CHECK(bottleneck_distance(v1, v2, upper_bound / 10000.) <= upper_bound / 100. + upper_bound / 10000.);
   BOOST_CHECK(std::abs(bottleneck_distance(v1, v2, 0.) - bottleneck_distance(v1, v2, upper_bound / 10000.)) <= upper_bound / 10000.);
 }
+
+BOOST_AUTO_TEST_CASE(grid_graph_matching) {
+  Persistence_graph g(v1, v2, 0.);
+  // The grid and the kd-tree give the same exact distance
+  BOOST_CHECK(bottleneck_distance_exact<Grid_graph_matching>(g) == bottleneck_distance_exact<Graph_matching>(g));
+  double e = upper_bound / 10000.;
+  Persistence_graph ge(v1, v2, e);
+  BOOST_CHECK(std::abs(bottleneck_distance_approx<Grid_graph_matching>(ge, e) - bottleneck_distance_exact(g)) <= 2 * e);
+}
+
+BOOST_AUTO_TEST_CASE(distance_matrix) {
+  std::uniform_real_distribution<double> unif1(0., upper_bound);
+  std::default_random_engine re;
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector< std::vector< std::pair<double, double> > > diagrams(7);
+  for (std::size_t d = 0; d < diagrams.size(); d++) {
+    for (std::size_t i = 0; i < 10 + 3 * d; i++) {
+      double a = unif1(re);
+      double b = unif1(re);
+      diagrams[d].emplace_back(std::min(a, b), std::max(a, b));
+    }
+    diagrams[d].emplace_back(unif1(re), inf);
+  }
+  // Different number of essential points
+  diagrams[4].emplace_back(0., inf);
+
+  for (double e : {0., upper_bound / 10000.}) {
+    std::vector<double> matrix = bottleneck_distance_matrix(diagrams, e);
+    const std::size_t n = diagrams.size();
+    BOOST_CHECK(matrix.size() == n * n);
+    for (std::size_t i = 0; i < n; i++) {
+      BOOST_CHECK(matrix[i * n + i] == 0.);
+      for (std::size_t j = 0; j < n; j++) {
+        if (i != j) BOOST_CHECK(matrix[i * n + j] == bottleneck_distance(diagrams[i], diagrams[j], e) ||
+                                matrix[i * n + j] == bottleneck_distance(diagrams[j], diagrams[i], e));
+        BOOST_CHECK(matrix[i * n + j] == matrix[j * n + i]);
+      }
+    }
+    BOOST_CHECK(matrix[4 * n] == inf);
+
+    std::vector< std::vector< std::pair<double, double> > > others(diagrams.begin(), diagrams.begin() + 3);
+    std::vector<double> cross = bottleneck_distance_matrix(diagrams, others, e);
+    BOOST_CHECK(cross.size() == n * 3);
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t j = 0; j < 3; j++)
+        BOOST_CHECK(cross[i * 3 + j] == bottleneck_distance(diagrams[i], others[j], e));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(distance_matrix_diagonal_candidates) {
+  // The exact distances are distances to the diagonal, or 0 for the empty diagrams
+  std::vector< std::vector< std::pair<double, double> > > diagrams = {
+      {}, {{0., 2.}}, {{0., 2.}, {1., 1.5}}, {{3., 3.}}, {{0., 2.1}, {5., 9.}}};
+  std::vector<double> matrix = bottleneck_distance_matrix(diagrams, 0.);
+  const std::size_t n = diagrams.size();
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      BOOST_CHECK(matrix[i * n + j] == (i == j ? 0. : bottleneck_distance(diagrams[i], diagrams[j], 0.)));
+  BOOST_CHECK(matrix[1] == 1.);
+  BOOST_CHECK(matrix[4] == 2.);
+  BOOST_CHECK(matrix[3 * n] == 0.);
+}
@@ -0,0 +1,229 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "wasserstein distance"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Wasserstein_distance.h>
+#include <gudhi/Wasserstein_barycenter.h>
+
+#include <random>
+#include <vector>
+#include <utility>  // for pair
+#include <algorithm>  // for next_permutation
+#include <limits>
+#include <cmath>
+
+using namespace Gudhi::persistence_diagram;
+
+typedef std::vector<std::pair<double, double>> Diagram;
+
+const double inf = std::numeric_limits<double>::infinity();
+
+Diagram random_diagram(std::default_random_engine& re, int n) {
+  std::uniform_real_distribution<double> unif(0., 10.);
+  Diagram diag;
+  for (int i = 0; i < n; i++) {
+    double a = unif(re);
+    double b = unif(re);
+    diag.emplace_back(std::min(a, b), std::max(a, b));
+  }
+  return diag;
+}
+
+// Exact distance by trying all the matchings, for tiny diagrams
+double brute_force(Diagram const& d1, Diagram const& d2, double order, double internal_p) {
+  auto dist = [&](double x1, double y1, double x2, double y2) {
+    double dx = std::abs(x1 - x2), dy = std::abs(y1 - y2);
+    return std::isinf(internal_p) ? std::max(dx, dy)
+                                  : std::pow(std::pow(dx, internal_p) + std::pow(dy, internal_p), 1. / internal_p);
+  };
+  const std::size_t n1 = d1.size(), n2 = d2.size(), n = n1 + n2;
+  std::vector<std::size_t> perm(n);
+  for (std::size_t i = 0; i < n; i++) perm[i] = i;
+  double best = inf;
+  do {
+    double total = 0.;
+    for (std::size_t i = 0; i < n; i++) {
+      std::size_t j = perm[i];
+      if (i < n1 && j < n2) {
+        total += std::pow(dist(d1[i].first, d1[i].second, d2[j].first, d2[j].second), order);
+      } else if (i < n1) {
+        double m = (d1[i].first + d1[i].second) / 2;
+        total += std::pow(dist(d1[i].first, d1[i].second, m, m), order);
+      } else if (j < n2) {
+        double m = (d2[j].first + d2[j].second) / 2;
+        total += std::pow(dist(d2[j].first, d2[j].second, m, m), order);
+      }
+    }
+    best = std::min(best, total);
+  } while (std::next_permutation(perm.begin(), perm.end()));
+  return std::pow(best, 1. / order);
+}
+
+BOOST_AUTO_TEST_CASE(wasserstein_against_brute_force) {
+  std::default_random_engine re;
+  for (int test = 0; test < 12; test++) {
+    Diagram d1 = random_diagram(re, 1 + test % 4);
+    Diagram d2 = random_diagram(re, 1 + test % 3);
+    double order = 1. + test % 3;
+    double internal_p = test % 2 ? 2. : inf;
+    double expected = brute_force(d1, d2, order, internal_p);
+    double delta = 1e-6;
+    double w = wasserstein_distance(d1, d2, order, internal_p, delta);
+    BOOST_CHECK(w >= expected * (1 - 1e-12));
+    BOOST_CHECK(w <= expected * (1 + delta));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(wasserstein_essential_points) {
+  Diagram d1 = {{0., 1.}, {2., inf}, {3., inf}};
+  Diagram d2 = {{0., 1.}, {3.5, inf}, {1., inf}};
+  // Finite parts are identical, essential births are matched in sorted order: |2-1| + |3-3.5|
+  BOOST_CHECK(std::abs(wasserstein_distance(d1, d2, 1., inf, 1e-9) - 1.5) < 1e-9);
+  d2.emplace_back(0., inf);
+  BOOST_CHECK(wasserstein_distance(d1, d2) == inf);
+  BOOST_CHECK(wasserstein_distance(Diagram(), Diagram()) == 0.);
+  // A single point is matched to the diagonal
+  BOOST_CHECK(std::abs(wasserstein_distance(Diagram{{0., 2.}}, Diagram(), 1., inf, 1e-9) - 1.) < 1e-9);
+
+  Wasserstein_auction auction(d1, Diagram{{0., 1.1}, {2., inf}, {3., inf}});
+  BOOST_CHECK(std::abs(auction.compute(1e-9) - .1) < 1e-9);
+  auto matching = auction.matching();
+  BOOST_CHECK(std::find(matching.begin(), matching.end(), std::make_pair(0, 0)) != matching.end());
+  BOOST_CHECK(std::find(matching.begin(), matching.end(), std::make_pair(1, 1)) != matching.end());
+  BOOST_CHECK(std::find(matching.begin(), matching.end(), std::make_pair(2, 2)) != matching.end());
+}
+
+BOOST_AUTO_TEST_CASE(wasserstein_warm_start) {
+  std::default_random_engine re;
+  Diagram d1 = random_diagram(re, 50);
+  Diagram d2 = random_diagram(re, 40);
+  Wasserstein_auction auction(d1, d2, 2., 2.);
+  double w = auction.compute(1e-4);
+
+  // Move d2 slightly, and start from the previous prices
+  Diagram d3 = d2;
+  for (auto& p : d3) p.second += .01;
+  Wasserstein_auction warm(d1, d3, 2., 2.);
+  warm.set_prices(auction.prices());
+  double w_warm = warm.compute(1e-4);
+  double w_cold = wasserstein_distance(d1, d3, 2., 2., 1e-4);
+  BOOST_CHECK(std::abs(w_warm - w_cold) <= 2e-4 * w_cold);
+  BOOST_CHECK(std::abs(w_warm - w) <= .1);
+}
+
+BOOST_AUTO_TEST_CASE(wasserstein_large_diagrams) {
+  // Large enough for the kd-tree to have many levels, with clustered points to make the bids compete
+  std::default_random_engine re;
+  Diagram d1 = random_diagram(re, 700);
+  Diagram d2 = random_diagram(re, 500);
+  for (int i = 0; i < 200; i++) d2.push_back(d1[i]);
+  for (double order : {1., 2.}) {
+    for (double internal_p : {1., 2., inf}) {
+      const double delta = 1e-3;
+      Wasserstein_auction auction(d1, d2, order, internal_p);
+      double w = auction.compute(delta);
+      double w_reverse = wasserstein_distance(d2, d1, order, internal_p, delta);
+      BOOST_CHECK(std::abs(w - w_reverse) <= delta * std::min(w, w_reverse));
+      // The distance is the cost of the matching
+      double total = 0.;
+      for (auto const& p : auction.matching()) {
+        auto const a = p.first >= 0 ? d1[p.first] : std::make_pair((d2[p.second].first + d2[p.second].second) / 2,
+                                                                     (d2[p.second].first + d2[p.second].second) / 2);
+        auto const b = p.second >= 0 ? d2[p.second] : std::make_pair((a.first + a.second) / 2,
+                                                                      (a.first + a.second) / 2);
+        double dx = std::abs(a.first - b.first), dy = std::abs(a.second - b.second);
+        double d = std::isinf(internal_p) ? std::max(dx, dy)
+                                          : std::pow(std::pow(dx, internal_p) + std::pow(dy, internal_p),
+                                                     1. / internal_p);
+        total += std::pow(d, order);
+      }
+      BOOST_CHECK(std::abs(std::pow(total, 1. / order) - w) <= 1e-9 * w);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(wasserstein_matrix) {
+  std::default_random_engine re;
+  std::vector<Diagram> diagrams;
+  for (int i = 0; i < 6; i++) diagrams.push_back(random_diagram(re, 5 + 2 * i));
+  std::vector<double> matrix = wasserstein_distance_matrix(diagrams, 1., 2., 1e-6);
+  const std::size_t n = diagrams.size();
+  BOOST_CHECK(matrix.size() == n * n);
+  for (std::size_t i = 0; i < n; i++) {
+    BOOST_CHECK(matrix[i * n + i] == 0.);
+    for (std::size_t j = 0; j < n; j++) {
+      BOOST_CHECK(matrix[i * n + j] == matrix[j * n + i]);
+      if (i < j) BOOST_CHECK(matrix[i * n + j] == wasserstein_distance(diagrams[i], diagrams[j], 1., 2., 1e-6));
+    }
+  }
+  std::vector<Diagram> others(diagrams.begin(), diagrams.begin() + 2);
+  std::vector<double> cross = wasserstein_distance_matrix(diagrams, others, 1., 2., 1e-6);
+  BOOST_CHECK(cross.size() == n * 2);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < 2; j++)
+      BOOST_CHECK(std::abs(cross[i * 2 + j] - matrix[i * n + j]) <= 2e-6 * matrix[i * n + j]);
+}
+
+BOOST_AUTO_TEST_CASE(lagrangian_barycenter) {
+  Diagram dg1 = {{0.2, 0.5}};
+  Diagram dg2 = {{0.2, 0.7}};
+  Diagram dg3 = {{0.3, 0.6}, {0.7, 0.8}, {0.2, 0.3}};
+  Diagram empty;
+  Lagrangian_barycenter bary(std::vector<Diagram>{dg1, dg2, dg3, empty});
+  Diagram res = bary.compute(empty);
+  Diagram expected = {{0.27916667, 0.55416667}, {0.7375, 0.7625}, {0.2375, 0.2625}};
+  BOOST_CHECK(res.size() == expected.size());
+  for (std::size_t i = 0; i < res.size(); i++) {
+    BOOST_CHECK(std::abs(res[i].first - expected[i].first) < 1e-7);
+    BOOST_CHECK(std::abs(res[i].second - expected[i].second) < 1e-7);
+  }
+
+  Lagrangian_barycenter empty_bary(std::vector<Diagram>{empty, empty, empty});
+  BOOST_CHECK(empty_bary.compute(empty).empty());
+  BOOST_CHECK(Lagrangian_barycenter(std::vector<Diagram>()).compute(dg1).empty());
+
+  Diagram dg7 = {{0.1, 0.15}, {0.1, 0.7}, {0.2, 0.22}, {0.55, 0.84}, {0.11, 0.91}, {0.61, 0.75}, {0.33, 0.46}};
+  BOOST_CHECK(Lagrangian_barycenter(std::vector<Diagram>{dg7}).compute(dg7) == dg7);
+
+  Diagram dg8 = {{0., 4.}, {4., 8.}};
+  Lagrangian_barycenter bary8(std::vector<Diagram>{empty, dg8});
+  res = bary8.compute(dg8);
+  BOOST_CHECK(res.size() == 2);
+  BOOST_CHECK(std::abs(res[0].first - 1.) < 1e-7 && std::abs(res[0].second - 3.) < 1e-7);
+  BOOST_CHECK(std::abs(res[1].first - 5.) < 1e-7 && std::abs(res[1].second - 7.) < 1e-7);
+  BOOST_CHECK(std::abs(bary8.compute_energy() - 2.) < 1e-6);
+  auto const& groupings = bary8.groupings();
+  BOOST_CHECK(groupings.size() == 2);
+  BOOST_CHECK((groupings[0] == Lagrangian_barycenter::Grouping{{0, -1}, {1, -1}}));
+  BOOST_CHECK((groupings[1] == Lagrangian_barycenter::Grouping{{0, 0}, {1, 1}}));
+
+  BOOST_CHECK_THROW(Lagrangian_barycenter(std::vector<Diagram>{{{0., inf}}}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(lagrangian_barycenter_many_diagrams) {
+  // The estimate is a fixed point: a new iteration from it does not move it
+  std::default_random_engine re;
+  std::vector<Diagram> diagrams;
+  for (int i = 0; i < 20; i++) diagrams.push_back(random_diagram(re, 10));
+  Lagrangian_barycenter bary(diagrams, 1e-9);
+  Diagram res = bary.compute(diagrams[0]);
+  BOOST_CHECK(bary.number_of_iterations() > 1);
+  double energy = bary.compute_energy();
+  Lagrangian_barycenter again(diagrams, 1e-9);
+  BOOST_CHECK(again.compute(res) == res);
+  BOOST_CHECK(again.number_of_iterations() == 1);
+  // The iterations decrease the energy of the initial estimate
+  Lagrangian_barycenter none(diagrams, 1e-9);
+  BOOST_CHECK(none.compute(diagrams[0], 0) == diagrams[0]);
+  BOOST_CHECK(energy <= none.compute_energy());
+}
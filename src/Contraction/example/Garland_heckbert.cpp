@@ -126,9 +126,10 @@ class GH_visitor : public Gudhi::contraction::Contraction_visitor<EdgeProfile> {
 };
 
 int main(int argc, char *argv[]) {
-  if (argc != 4) {
+  if (argc != 4 && argc != 5) {
     std::cerr << "Usage " << argv[0] <<
-        " input.off output.off N to load the file input.off, contract N edges and save the result to output.off.\n";
+        " input.off output.off N [B] to load the file input.off, contract N edges and save the result to output.off.\n"
+        "If B is given, the edges are contracted by batches of at most B independent edges.\n";
     return EXIT_FAILURE;
   }
 
@@ -159,7 +160,10 @@ int main(int argc, char *argv[]) {
                                 new GH_visitor(complex));
 
   std::clog << "Contract " << num_contractions << " edges" << std::endl;
-  contractor.contract_edges(num_contractions);
+  if (argc == 5)
+    contractor.contract_edges_in_parallel(num_contractions, atoi(argv[4]));
+  else
+    contractor.contract_edges(num_contractions);
 
   std::clog << "Final complex has " <<
       complex.num_vertices() << " vertices, " <<
@@ -99,6 +99,12 @@ an orientation for instance).
 
 \image html "sphere_contraction.png" "Time in seconds to simplify random 2-spheres to a tetrahedron" width=10cm
 
+The method Skeleton_blocker_contractor::contract_edges_in_parallel contracts the edges by batches of edges of lowest
+cost whose neighborhoods are disjoint. The placements, the validity checks and the cost updates of a batch are
+computed in parallel when TBB is available, the contractions themselves remain sequential.
+The simplification differs from the one of Skeleton_blocker_contractor::contract_edges as soon as a batch contains
+more than one edge.
+
 \section Example
 
  
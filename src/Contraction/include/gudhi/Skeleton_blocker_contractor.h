@@ -32,11 +32,16 @@
 #include <boost/scoped_array.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <memory>
 #include <cassert>
 #include <list>
 #include <utility>  // for pair
 #include <vector>
+#include <algorithm>  // for std::min
 
 // Make compilation fail - required for external projects - https://github.com/GUDHI/gudhi-devel/issues/10
 #if CGAL_VERSION_NR < 1041101000
@@ -356,6 +361,101 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
     if (contraction_visitor_) contraction_visitor_->on_stop_condition_reached();
   }
 
+  /**
+   * \brief Contract edges by batches of independent edges.
+   *
+   * \details Each round extracts the `max_batch_size` edges with the lowest costs from the heap and selects greedily,
+   * by increasing cost, the edges whose closed neighborhoods (the two vertices and their neighbors) are disjoint from
+   * the ones of the edges already selected. The contractions of these edges do not interact: the validity and the
+   * placement of an edge do not depend on the contraction of the others. The other extracted edges are put back in the
+   * heap for the next rounds.
+   *
+   * When `GUDHI_USE_TBB` is defined, the placements and the validity of the selected edges are computed in parallel,
+   * then the edges are contracted sequentially and the costs of the changed edges are updated in parallel at the end of
+   * the round. The policies must then support concurrent calls on different edges.
+   *
+   * It stops when the heap is empty or when the number of contractions given by 'num_max_contractions' is reached
+   * (if this number is positive). With a `max_batch_size` of 1, the contractions are the same as with contract_edges,
+   * as long as the visitor does not modify the complex in `on_contracted` (the costs are then updated after this call
+   * instead of before it).
+   */
+  void contract_edges_in_parallel(int num_max_contractions = -1, std::size_t max_batch_size = 1024) {
+    DBG("\n\nContract edges in parallel");
+    assert(max_batch_size > 0);
+    int num_contraction = 0;
+    bool unspecified_num_contractions = (num_max_contractions == -1);
+
+    std::vector<Edge_handle> selected_edges;
+    std::vector<Edge_handle> postponed_edges;
+    std::vector<Placement_type> placements;
+    std::vector<char> valid_contractions;
+    // the vertices of the closed neighborhoods of the selected edges are marked with the round number
+    std::vector<int> vertex_rounds;
+    int round = 0;
+    bool stop = false;
+    while (!stop && !heap_PQ_->empty() && (unspecified_num_contractions || num_contraction < num_max_contractions)) {
+      ++round;
+      std::size_t max_num_selected = max_batch_size;
+      if (!unspecified_num_contractions)
+        max_num_selected = std::min(max_num_selected, static_cast<std::size_t>(num_max_contractions - num_contraction));
+
+      selected_edges.clear();
+      postponed_edges.clear();
+      std::size_t num_extracted = 0;
+      boost::optional<Edge_handle> edge;
+      while (num_extracted < max_batch_size && selected_edges.size() < max_num_selected && (edge = pop_from_PQ())) {
+        ++num_extracted;
+        Cost_type cost(get_data(*edge).cost());
+        if (!cost) {
+          DBG("uncomputable cost");
+          if (contraction_visitor_) contraction_visitor_->on_selected(create_profile(*edge), cost, 0, 0);
+          continue;
+        }
+        if (should_stop(*cost, create_profile(*edge))) {
+          if (contraction_visitor_) contraction_visitor_->on_stop_condition_reached();
+          DBG("should_stop");
+          postponed_edges.push_back(*edge);
+          stop = true;
+          break;
+        }
+        if (mark_neighborhood(*edge, round, vertex_rounds))
+          selected_edges.push_back(*edge);
+        else
+          postponed_edges.push_back(*edge);
+      }
+      for (auto postponed_edge : postponed_edges)
+        insert_in_PQ(postponed_edge, get_data(postponed_edge));
+
+      placements.assign(selected_edges.size(), Placement_type());
+      valid_contractions.assign(selected_edges.size(), false);
+      auto check_contraction = [&](std::size_t i) {
+        Profile const& profile = create_profile(selected_edges[i]);
+        placements[i] = get_placement(profile);
+        valid_contractions[i] = is_contraction_valid(profile, placements[i]) && placements[i];
+      };
+#ifdef GUDHI_USE_TBB
+      tbb::parallel_for(std::size_t(0), selected_edges.size(), check_contraction);
+#else
+      for (std::size_t i = 0; i < selected_edges.size(); ++i) check_contraction(i);
+#endif
+
+      for (std::size_t i = 0; i < selected_edges.size(); ++i) {
+        Profile const& profile = create_profile(selected_edges[i]);
+        if (contraction_visitor_) contraction_visitor_->on_selected(profile, get_data(selected_edges[i]).cost(), 0, 0);
+        if (valid_contractions[i]) {
+          DBG("contraction_valid");
+          contract_edge(profile, placements[i], false);
+          ++num_contraction;
+        } else {
+          DBG("contraction not valid");
+          if (contraction_visitor_) contraction_visitor_->on_non_valid(profile);
+        }
+      }
+      update_changed_edges_in_parallel();
+    }
+    if (contraction_visitor_) contraction_visitor_->on_stop_condition_reached();
+  }
+
   bool is_in_heap(Edge_handle edge) const {
     if (heap_PQ_->empty()) {
       return false;
@@ -435,7 +535,33 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
   }
 
  private:
-  void contract_edge(const Profile& profile, Placement_type placement) {
+  /**
+   * @brief Marks with the round number the closed neighborhood of the edge if none of its vertices is already marked.
+   * @return true iff the neighborhood was not marked.
+   */
+  bool mark_neighborhood(Edge_handle edge, int round, std::vector<int>& vertex_rounds) const {
+    Vertex_handle a = complex_.first_vertex(edge);
+    Vertex_handle b = complex_.second_vertex(edge);
+    auto is_marked = [&](Vertex_handle v) {
+      return static_cast<std::size_t>(v.vertex) < vertex_rounds.size() && vertex_rounds[v.vertex] == round;
+    };
+    auto mark = [&](Vertex_handle v) {
+      if (static_cast<std::size_t>(v.vertex) >= vertex_rounds.size()) vertex_rounds.resize(v.vertex + 1, 0);
+      vertex_rounds[v.vertex] = round;
+    };
+    for (Vertex_handle v : {a, b}) {
+      if (is_marked(v)) return false;
+      for (auto w : complex_.vertex_range(v))
+        if (is_marked(w)) return false;
+    }
+    for (Vertex_handle v : {a, b}) {
+      mark(v);
+      for (auto w : complex_.vertex_range(v)) mark(w);
+    }
+    return true;
+  }
+
+  void contract_edge(const Profile& profile, Placement_type placement, bool update_costs = true) {
     if (contraction_visitor_) contraction_visitor_->on_contracting(profile, placement);
 
     assert(complex_.contains_vertex(profile.v0_handle()));
@@ -452,7 +578,7 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
     assert(complex_.contains_vertex(profile.v0_handle()));
     assert(!complex_.contains_vertex(profile.v1_handle()));
 
-    update_changed_edges();
+    if (update_costs) update_changed_edges();
 
     // the visitor could do something as complex_.remove_popable_blockers();
     if (contraction_visitor_) contraction_visitor_->on_contracted(profile, placement);
@@ -462,6 +588,8 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
   // every time the visitor's method on_changed_edge is called, it adds an
   // edge to changed_edges_
   std::vector< Edge_handle > changed_edges_;
+  // marks the edges of changed_edges_ in update_changed_edges_in_parallel
+  std::vector<bool> is_changed_edge_;
 
   /**
    * @brief we update the cost and the position in the heap of an edge that has
@@ -494,6 +622,45 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
     changed_edges_.clear();
   }
 
+  /**
+   * @brief Updates the costs of the edges changed by several contractions, in parallel when GUDHI_USE_TBB is defined,
+   * and then their positions in the heap.
+   */
+  void update_changed_edges_in_parallel() {
+    DBG("update edges in parallel");
+    // An edge may have been changed several times. Only its first occurrence is kept, so that the heap is updated in
+    // the same order as by update_changed_edges (the later updates of an edge do not move it), which decides the ties
+    // between equal costs.
+    std::size_t num_changed_edges = 0;
+    for (auto ab : changed_edges_) {
+      std::size_t id = get_undirected_edge_id(ab);
+      if (id >= is_changed_edge_.size()) is_changed_edge_.resize(id + 1, false);
+      if (!is_changed_edge_[id]) {
+        is_changed_edge_[id] = true;
+        changed_edges_[num_changed_edges++] = ab;
+      }
+    }
+    changed_edges_.resize(num_changed_edges);
+    for (auto ab : changed_edges_) is_changed_edge_[get_undirected_edge_id(ab)] = false;
+    auto update_cost = [&](std::size_t i) {
+      get_data(changed_edges_[i]).cost() = get_cost(create_profile(changed_edges_[i]));
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), changed_edges_.size(), update_cost);
+#else
+    for (std::size_t i = 0; i < changed_edges_.size(); ++i) update_cost(i);
+#endif
+    for (auto ab : changed_edges_) {
+      Edge_data& data = get_data(ab);
+      if (data.is_in_PQ()) {
+        update_in_PQ(ab, data);
+      } else {
+        insert_in_PQ(ab, data);
+      }
+    }
+    changed_edges_.clear();
+  }
+
 
  private:
   void on_remove_edge(Vertex_handle a, Vertex_handle b) override {
@@ -0,0 +1,132 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/Edge_contraction.h>
+#include <gudhi/Skeleton_blocker.h>
+#include <gudhi/Point.h>
+#include <gudhi/Contraction/policies/Middle_placement.h>
+
+#include <iostream>
+#include <algorithm>  // for std::equal
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "contraction_in_parallel"
+#include <boost/test/unit_test.hpp>
+
+struct Geometry_trait {
+  typedef Point_d Point;
+};
+
+using Complex_geometric_traits = Gudhi::skeleton_blocker::Skeleton_blocker_simple_geometric_traits<Geometry_trait>;
+using Complex = Gudhi::skeleton_blocker::Skeleton_blocker_geometric_complex< Complex_geometric_traits >;
+using Profile = Gudhi::contraction::Edge_profile<Complex>;
+using Complex_contractor = Gudhi::contraction::Skeleton_blocker_contractor<Complex>;
+
+// Rips complex of the points of tore3D_300.off
+Complex build_rips(double offset) {
+  Complex complex;
+  Gudhi::skeleton_blocker::Skeleton_blocker_off_reader<Complex> off_reader("tore3D_300.off", complex, true);
+  BOOST_REQUIRE(off_reader.is_valid());
+  auto vertices = complex.vertex_range();
+  for (auto p = vertices.begin(); p != vertices.end(); ++p)
+    for (auto q = p; ++q != vertices.end(); /**/) {
+      if (squared_dist(complex.point(*p), complex.point(*q)) < 4 * offset * offset)
+        complex.add_edge_without_blockers(*p, *q);
+    }
+  return complex;
+}
+
+// Rips complex of a n x n grid, whose edges have few different lengths
+Complex build_grid(int n, double offset) {
+  Complex complex;
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) complex.add_vertex(Point_d{static_cast<double>(i), static_cast<double>(j)});
+  auto vertices = complex.vertex_range();
+  for (auto p = vertices.begin(); p != vertices.end(); ++p)
+    for (auto q = p; ++q != vertices.end(); /**/) {
+      if (squared_dist(complex.point(*p), complex.point(*q)) < 4 * offset * offset)
+        complex.add_edge_without_blockers(*p, *q);
+    }
+  return complex;
+}
+
+int euler_characteristic(Complex& complex) {
+  int euler = 0;
+  for (const auto& s : complex.complex_simplex_range())
+    euler += s.dimension() % 2 == 0 ? 1 : -1;
+  return euler;
+}
+
+bool same_complexes(Complex& a, Complex& b) {
+  if (a != b) return false;
+  for (auto v : a.vertex_range())
+    if (!std::equal(a.point(v).begin(), a.point(v).end(), b.point(v).begin())) return false;
+  return true;
+}
+
+BOOST_AUTO_TEST_CASE(contraction_in_parallel_batch_size_1) {
+  // With batches of one edge, the contractions are the ones of contract_edges
+  for (int num_contractions : {50, -1}) {
+    Complex sequential_complex = build_rips(0.5);
+    Complex batch_complex = build_rips(0.5);
+    std::clog << "Initial complex has " << sequential_complex.num_vertices() << " vertices and "
+              << sequential_complex.num_edges() << " edges" << std::endl;
+    {
+      Complex_contractor contractor(sequential_complex);
+      contractor.contract_edges(num_contractions);
+    }
+    {
+      Complex_contractor contractor(batch_complex);
+      contractor.contract_edges_in_parallel(num_contractions, 1);
+    }
+    std::clog << "Final complex has " << batch_complex.num_vertices() << " vertices and "
+              << batch_complex.num_edges() << " edges" << std::endl;
+    if (num_contractions > 0) BOOST_CHECK(batch_complex.num_vertices() == 300 - num_contractions);
+    BOOST_CHECK(same_complexes(sequential_complex, batch_complex));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(contraction_in_parallel_batch_size_1_ties) {
+  // Many edges have the same cost, and the vertices move, so the order of the heap updates decides the contractions
+  Complex sequential_complex = build_grid(10, 0.8);
+  Complex batch_complex = build_grid(10, 0.8);
+  {
+    Complex_contractor contractor(sequential_complex, new Gudhi::contraction::Edge_length_cost<Profile>,
+                                  new Gudhi::contraction::Middle_placement<Profile>);
+    contractor.contract_edges();
+  }
+  {
+    Complex_contractor contractor(batch_complex, new Gudhi::contraction::Edge_length_cost<Profile>,
+                                  new Gudhi::contraction::Middle_placement<Profile>);
+    contractor.contract_edges_in_parallel(-1, 1);
+  }
+  BOOST_CHECK(same_complexes(sequential_complex, batch_complex));
+}
+
+BOOST_AUTO_TEST_CASE(contraction_in_parallel_batch_size_16) {
+  Complex sequential_complex = build_rips(0.5);
+  Complex batch_complex = build_rips(0.5);
+  {
+    Complex_contractor contractor(sequential_complex);
+    contractor.contract_edges();
+  }
+  {
+    Complex_contractor contractor(batch_complex);
+    contractor.contract_edges_in_parallel(50, 16);
+    BOOST_CHECK(batch_complex.num_vertices() == 250);
+    contractor.contract_edges_in_parallel(-1, 16);
+    BOOST_CHECK(contractor.is_heap_empty());
+  }
+  std::clog << "Final complexes have " << sequential_complex.num_vertices() << " and "
+            << batch_complex.num_vertices() << " vertices" << std::endl;
+  // The contractions satisfy the link condition, so they preserve the homotopy type
+  BOOST_CHECK(euler_characteristic(batch_complex) == euler_characteristic(sequential_complex));
+  BOOST_CHECK(batch_complex.num_vertices() < 300);
+}
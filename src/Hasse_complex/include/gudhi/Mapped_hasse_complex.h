@@ -0,0 +1,307 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef MAPPED_HASSE_COMPLEX_H_
+#define MAPPED_HASSE_COMPLEX_H_
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <cstdint>  // for std::uint64_t, std::int32_t
+#include <cstring>  // for std::memcpy, std::memcmp
+#include <fstream>
+#include <iostream>
+#include <limits>  // for infinity value
+#include <numeric>  // for std::iota
+#include <stdexcept>  // for std::invalid_argument
+#include <string>
+#include <utility>  // for pair
+#include <vector>
+
+namespace Gudhi {
+
+// Keep this file tag for Doxygen to parse the code, otherwise, functions are not documented.
+// It is required for global functions and variables.
+
+/** @file
+ * @brief This file includes the reader and the writer of binary boundary matrices, see
+ * \ref FileFormatsHasseBoundaryMatrix.
+ */
+
+namespace hasse_boundary_matrix_detail {
+
+constexpr char magic[8] = {'G', 'U', 'D', 'H', 'I', 'H', 'B', 'M'};
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+constexpr std::uint32_t version = 1;
+
+// The header, at the beginning of the file. Its size is a multiple of 8 bytes, so that the offsets and the filtration
+// values, which follow it, are aligned.
+struct Header {
+  char magic[8];
+  std::uint32_t byte_order_mark;
+  std::uint32_t version;
+  std::uint64_t number_of_simplices;
+  std::uint64_t number_of_boundary_entries;
+  std::int64_t dimension;
+};
+
+inline void throw_invalid_boundary_matrix(std::string const& filename, std::string const& reason) {
+  std::string error_str("Mapped_hasse_complex - ");
+  error_str.append(filename).append(": ").append(reason);
+  std::cerr << error_str << std::endl;
+  throw std::invalid_argument(error_str);
+}
+
+template <typename T>
+void write(std::ofstream& out, T const& value) {
+  out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+}  // namespace hasse_boundary_matrix_detail
+
+/**
+ * @brief Checks whether a file is a binary boundary matrix (see \ref FileFormatsHasseBoundaryMatrix), by reading its
+ * first bytes.
+ */
+inline bool is_hasse_boundary_matrix(std::string const& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  char magic[sizeof(hasse_boundary_matrix_detail::magic)];
+  if (!in.read(magic, sizeof(magic))) return false;
+  return std::memcmp(magic, hasse_boundary_matrix_detail::magic, sizeof(magic)) == 0;
+}
+
+/**
+ * @brief Writes the boundary matrix of a FilteredComplex to a binary file (see \ref FileFormatsHasseBoundaryMatrix).
+ *
+ * @details As Persistent_cohomology does, the key of every simplex is set to its position in the filtration: the
+ * boundaries are written as these keys. The filtration is traversed once per section of the file, which is written as
+ * it goes, so that nothing but the complex is kept in memory.
+ *
+ * Throws std::invalid_argument if the file cannot be written or if the complex has more simplices than a 32-bit
+ * signed integer can index.
+ */
+template <class FilteredComplex>
+void write_hasse_boundary_matrix(std::string const& filename, FilteredComplex& cpx) {
+  using namespace hasse_boundary_matrix_detail;
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) throw_invalid_boundary_matrix(filename, "Unable to open file");
+  // The header is written again at the end, with the right sizes.
+  Header header;
+  std::memcpy(header.magic, magic, sizeof(header.magic));
+  header.byte_order_mark = byte_order_mark;
+  header.version = version;
+  header.number_of_simplices = 0;
+  header.number_of_boundary_entries = 0;
+  header.dimension = -1;
+  write(out, header);
+
+  // Keys and offsets
+  std::uint64_t number_of_simplices = 0;
+  std::uint64_t number_of_boundary_entries = 0;
+  write(out, number_of_boundary_entries);
+  for (auto sh : cpx.filtration_simplex_range()) {
+    if (number_of_simplices == static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max()))
+      throw_invalid_boundary_matrix(filename, "Too many simplices");
+    cpx.assign_key(sh, static_cast<typename FilteredComplex::Simplex_key>(number_of_simplices++));
+    for (auto b_sh : cpx.boundary_simplex_range(sh)) {
+      (void)b_sh;
+      ++number_of_boundary_entries;
+    }
+    write(out, number_of_boundary_entries);
+    if (cpx.dimension(sh) > header.dimension) header.dimension = cpx.dimension(sh);
+  }
+  // Filtration values
+  for (auto sh : cpx.filtration_simplex_range()) write(out, static_cast<double>(cpx.filtration(sh)));
+  // Boundaries
+  for (auto sh : cpx.filtration_simplex_range())
+    for (auto b_sh : cpx.boundary_simplex_range(sh)) write(out, static_cast<std::int32_t>(cpx.key(b_sh)));
+  // Dimensions
+  for (auto sh : cpx.filtration_simplex_range()) write(out, static_cast<std::int32_t>(cpx.dimension(sh)));
+
+  header.number_of_simplices = number_of_simplices;
+  header.number_of_boundary_entries = number_of_boundary_entries;
+  out.seekp(0);
+  write(out, header);
+  out.close();
+  if (out.fail()) throw_invalid_boundary_matrix(filename, "Unable to write file");
+}
+
+/**
+ * @brief Read-only Hasse diagram of a complex mapped in memory from a binary boundary matrix (see
+ * \ref FileFormatsHasseBoundaryMatrix).
+ *
+ * @details It has the same interface as Hasse_complex, and can be given to Persistent_cohomology. The boundaries,
+ * filtration values and dimensions are read directly in the mapping, without parsing nor allocation per simplex:
+ * only the keys and the list of vertices are stored in memory. A Hasse_complex can also be built from it, in parallel
+ * when TBB is available, with `Hasse_complex<> hcpx(mapped_cpx)`, as long as its keys are the positions in the
+ * filtration, which is no longer the case once its persistence has been computed.
+ *
+ * \implements FilteredComplex
+ */
+class Mapped_hasse_complex {
+ public:
+  typedef double Filtration_value;
+  typedef int Simplex_key;
+  typedef int Simplex_handle;  // index in the filtration
+
+  typedef boost::counting_iterator< Simplex_handle > Filtration_simplex_iterator;
+  typedef boost::iterator_range<Filtration_simplex_iterator> Filtration_simplex_range;
+
+  typedef Simplex_handle const* Boundary_simplex_iterator;
+  typedef boost::iterator_range<Boundary_simplex_iterator> Boundary_simplex_range;
+
+  typedef std::vector< Simplex_handle >::const_iterator Skeleton_simplex_iterator;
+  typedef boost::iterator_range< Skeleton_simplex_iterator > Skeleton_simplex_range;
+
+  /** @brief Maps the boundary matrix in memory. Throws std::invalid_argument if the file is not a valid boundary
+   * matrix. */
+  explicit Mapped_hasse_complex(std::string const& filename) {
+    using namespace hasse_boundary_matrix_detail;
+    static_assert(sizeof(Simplex_handle) == sizeof(std::int32_t), "Boundaries are stored as 32-bit integers");
+    if (!is_hasse_boundary_matrix(filename)) throw_invalid_boundary_matrix(filename, "Not a boundary matrix");
+    try {
+      boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+      region_ = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+    } catch (boost::interprocess::interprocess_exception const& e) {
+      throw_invalid_boundary_matrix(filename, e.what());
+    }
+    char const* data = static_cast<char const*>(region_.get_address());
+    const std::size_t size = region_.get_size();
+
+    Header header;
+    if (size < sizeof(Header)) throw_invalid_boundary_matrix(filename, "Truncated header");
+    std::memcpy(&header, data, sizeof(Header));
+    if (header.byte_order_mark != byte_order_mark) throw_invalid_boundary_matrix(filename, "Wrong byte order");
+    if (header.version != version) throw_invalid_boundary_matrix(filename, "Unsupported version");
+    if (header.dimension < -1 || header.dimension > std::numeric_limits<std::int32_t>::max())
+      throw_invalid_boundary_matrix(filename, "Corrupted dimension");
+    // Check the sizes before computing the size of the file, to avoid overflows.
+    if (header.number_of_simplices > static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max()) ||
+        header.number_of_boundary_entries > size / sizeof(std::int32_t) ||
+        sizeof(Header) + 8 * (header.number_of_simplices + 1) + 8 * header.number_of_simplices +
+        4 * header.number_of_boundary_entries + 4 * header.number_of_simplices > size)
+      throw_invalid_boundary_matrix(filename, "Truncated file");
+
+    num_simplices_ = header.number_of_simplices;
+    dim_max_ = static_cast<int>(header.dimension);
+    offsets_ = reinterpret_cast<std::uint64_t const*>(data + sizeof(Header));
+    filtrations_ = reinterpret_cast<Filtration_value const*>(offsets_ + num_simplices_ + 1);
+    boundaries_ = reinterpret_cast<Simplex_handle const*>(filtrations_ + num_simplices_);
+    dimensions_ = reinterpret_cast<std::int32_t const*>(boundaries_ + header.number_of_boundary_entries);
+
+    // The boundaries must be in the file and only contain previous simplices, so that the persistence can be computed.
+    if (offsets_[0] != 0 || offsets_[num_simplices_] != header.number_of_boundary_entries)
+      throw_invalid_boundary_matrix(filename, "Corrupted offsets");
+    for (std::size_t sh = 0; sh < num_simplices_; ++sh) {
+      if (offsets_[sh] > offsets_[sh + 1]) throw_invalid_boundary_matrix(filename, "Corrupted offsets");
+      std::uint64_t boundary_size = offsets_[sh + 1] - offsets_[sh];
+      if (dimensions_[sh] < 0 || dimensions_[sh] > dim_max_ || (dimensions_[sh] == 0) != (boundary_size == 0) ||
+          (dimensions_[sh] == 1 && boundary_size != 2))
+        throw_invalid_boundary_matrix(filename, "Corrupted dimensions");
+      for (std::uint64_t entry = offsets_[sh]; entry < offsets_[sh + 1]; ++entry)
+        if (boundaries_[entry] < 0 || static_cast<std::size_t>(boundaries_[entry]) >= sh)
+          throw_invalid_boundary_matrix(filename, "Corrupted boundaries");
+      if (dimensions_[sh] == 0) vertices_.push_back(sh);
+    }
+
+    keys_.resize(num_simplices_);
+    std::iota(keys_.begin(), keys_.end(), 0);
+  }
+
+  /*  only dimension 0 skeleton_simplex_range(...) */
+  Skeleton_simplex_range skeleton_simplex_range(int dim = 0) const {
+    if (dim != 0) {
+      std::cerr << "Dimension must be 0 \n";
+    }
+    return Skeleton_simplex_range(vertices_.begin(), vertices_.end());
+  }
+
+  size_t num_simplices() const {
+    return num_simplices_;
+  }
+
+  Filtration_simplex_range filtration_simplex_range() const {
+    return Filtration_simplex_range(Filtration_simplex_iterator(0)
+                                    , Filtration_simplex_iterator(num_simplices_));
+  }
+
+  Simplex_key key(Simplex_handle sh) const {
+    return keys_[sh];
+  }
+
+  Simplex_key null_key() const {
+    return -1;
+  }
+
+  Simplex_handle simplex(Simplex_key key) const {
+    if (key == null_key()) return null_simplex();
+    return key;
+  }
+
+  Simplex_handle null_simplex() const {
+    return -1;
+  }
+
+  Filtration_value filtration(Simplex_handle sh) const {
+    if (sh == null_simplex()) {
+      return std::numeric_limits<Filtration_value>::infinity();
+    }
+    return filtrations_[sh];
+  }
+
+  int dimension(Simplex_handle sh) const {
+    return dimensions_[sh];
+  }
+
+  int dimension() const {
+    return dim_max_;
+  }
+
+  std::pair<Simplex_handle, Simplex_handle> endpoints(Simplex_handle sh) const {
+    return std::pair<Simplex_handle, Simplex_handle>(boundaries_[offsets_[sh]]
+                                                     , boundaries_[offsets_[sh] + 1]);
+  }
+
+  void assign_key(Simplex_handle sh, Simplex_key key) {
+    keys_[sh] = key;
+  }
+
+  Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) const {
+    return Boundary_simplex_range(boundaries_ + offsets_[sh]
+                                  , boundaries_ + offsets_[sh + 1]);
+  }
+
+  void display_simplex(Simplex_handle sh) const {
+    std::clog << dimension(sh) << "  ";
+    for (auto sh_b : boundary_simplex_range(sh)) std::clog << sh_b << " ";
+    std::clog << "  " << filtration(sh) << "         key=" << key(sh);
+  }
+
+  void initialize_filtration() {
+    // The simplices are stored in the order of the filtration.
+  }
+
+ private:
+  boost::interprocess::mapped_region region_;
+  std::size_t num_simplices_;
+  int dim_max_;
+  std::uint64_t const* offsets_;
+  Filtration_value const* filtrations_;
+  Simplex_handle const* boundaries_;
+  std::int32_t const* dimensions_;
+  std::vector<Simplex_key> keys_;
+  std::vector<Simplex_handle> vertices_;
+};
+
+}  // namespace Gudhi
+
+#endif  // MAPPED_HASSE_COMPLEX_H_
@@ -26,6 +26,7 @@
 #include <gudhi/distance_functions.h>
 #include <gudhi/Persistent_cohomology.h>
 #include <gudhi/Bottleneck.h>
+#include <gudhi/Vantage_point_tree.h>
 
 #include <boost/config.hpp>
 #include <boost/graph/graph_traits.hpp>
@@ -39,12 +40,13 @@
 
 #include <iostream>
 #include <vector>
-#include <map>
 #include <string>
 #include <limits>     // for numeric_limits
 #include <utility>    // for std::pair<>
 #include <algorithm>  // for (std::max)
 #include <random>
+#include <queue>
+#include <functional>  // for std::greater
 #include <cassert>
 #include <cmath>
 
@@ -91,6 +93,7 @@ class Cover_complex {
 
   std::vector<Point> point_cloud;               // input point cloud.
   std::vector<std::vector<double> > distances;  // all pairwise distances.
+  bool on_demand_distances = false;             // whether distances are computed only when needed, with a metric tree.
   int maximal_dim;                              // maximal dimension of output simplicial complex.
   int data_dimension;                           // dimension of input data.
   int n;                                        // number of points.
@@ -111,13 +114,14 @@ class Cover_complex {
 
   std::vector<std::vector<int> >
       cover;  // function associating to each data point the vector of cover elements to which it belongs.
-  std::map<int, std::vector<int> >
+  // The cover elements are identified by consecutive integers, which index the following vectors.
+  std::vector<std::vector<int> >
       cover_back;  // inverse of cover, in order to get the data points associated to a specific cover element.
-  std::map<int, double> cover_std;  // standard function (induced by func) used to compute the extended persistence
-                                    // diagram of the output simplicial complex.
-  std::map<int, int>
+  std::vector<double> cover_std;  // standard function (induced by func) used to compute the extended persistence
+                                  // diagram of the output simplicial complex.
+  std::vector<int>
       cover_fct;  // integer-valued function that allows to state if two elements of the cover are consecutive or not.
-  std::map<int, std::pair<int, double> >
+  std::vector<std::pair<int, double> >
       cover_color;  // size and coloring (induced by func_color) of the vertices of the output simplicial complex.
 
   int resolution_int = -1;
@@ -127,7 +131,7 @@ class Cover_complex {
   double rate_power = 0.001;  // Power in the subsampling.
   int mask = 0;               // Ignore nodes containing less than mask points.
 
-  std::map<int, int> name2id, name2idinv;
+  std::vector<int> name2id, name2idinv;
 
   std::string cover_name;
   std::string point_cloud_name;
@@ -139,11 +143,16 @@ class Cover_complex {
     for (boost::tie(ei, ei_end) = boost::edges(G); ei != ei_end; ++ei) boost::remove_edge(*ei, G);
   }
 
+  // Random number generator of the current thread.
+  static std::default_random_engine& random_engine() {
+    thread_local std::default_random_engine re;
+    return re;
+  }
+
   // Find random number in [0,1].
   double GetUniform() {
-    thread_local std::default_random_engine re;
     std::uniform_real_distribution<double> Dist(0, 1);
-    return Dist(re);
+    return Dist(random_engine());
   }
 
   // Subsample points.
@@ -163,6 +172,33 @@ class Cover_complex {
     }
   }
 
+  // Find the representative of the connected component of x, with path halving.
+  static int find_component(std::vector<int>& parent, int x) {
+    while (parent[x] != x) {
+      parent[x] = parent[parent[x]];
+      x = parent[x];
+    }
+    return x;
+  }
+
+  // Merge the connected components of x and y.
+  static void union_components(std::vector<int>& parent, int x, int y) {
+    x = find_component(parent, x);
+    y = find_component(parent, y);
+    if (x < y)
+      parent[y] = x;
+    else
+      parent[x] = y;
+  }
+
+  // Make room for the cover elements 0, ..., num - 1.
+  void resize_cover_elements(int num) {
+    if (num <= static_cast<int>(cover_color.size())) return;
+    cover_back.resize(num);
+    cover_fct.resize(num);
+    cover_color.resize(num, std::pair<int, double>(0, 0));
+  }
+
   // *******************************************************************************************************************
   // Utils.
   // *******************************************************************************************************************
@@ -206,6 +242,18 @@ class Cover_complex {
    */
   void set_mask(int nodemask) { mask = nodemask; }
 
+ public:
+  /** \brief Specifies whether the distances should be computed only when needed, instead of being stored in a dense
+   * matrix of all pairwise distances. In this mode, the Rips graphs are computed with radius queries in a
+   * `Gudhi::spatial_searching::Vantage_point_tree`, the subsamplings of `set_graph_from_automatic_rips()` with nearest
+   * neighbor queries, and the Voronoi covers only use the distances along the edges of the graph. This mode has no
+   * effect if the distance matrix was given with `set_distances_from_range()`.
+   *
+   * @param[in] on_demand boolean (true = compute distances on demand, false = compute all pairwise distances).
+   *
+   */
+  void set_on_demand_distances(bool on_demand = true) { on_demand_distances = on_demand; }
+
  public:
 
 
@@ -224,6 +272,11 @@ class Cover_complex {
     this->point_cloud = point_cloud;
   }
 
+  /** \brief Returns the input point cloud, for instance to build a metric tree on it.
+   *
+   */
+  const std::vector<Point>& get_point_cloud() const { return point_cloud; }
+
   /** \brief Reads and stores the input point cloud from .(n)OFF file.
    *
    * @param[in] off_file_name name of the input .OFF or .nOFF file.
@@ -346,6 +399,11 @@ class Cover_complex {
            */
   template <typename Distance>
   void set_graph_from_rips(double threshold, Distance distance) {
+    if (on_demand_distances && distances.size() == 0) {
+      set_graph_from_rips(threshold, Gudhi::spatial_searching::Vantage_point_tree<std::vector<Point>, Distance>(
+                                         point_cloud, distance));
+      return;
+    }
     remove_edges(one_skeleton);
     if (distances.size() == 0) compute_pairwise_distances(distance);
     for (int i = 0; i < n; i++) {
@@ -359,6 +417,32 @@ class Cover_complex {
     }
   }
 
+ public:  // Set graph from Rips complex with a metric tree.
+          /** \brief Creates a graph G from a Rips complex, using radius queries in a metric tree instead of all
+           * pairwise distances.
+           *
+           * @param[in] threshold threshold value for the Rips complex.
+           * @param[in] tree metric tree built on the point cloud (see `get_point_cloud()`).
+           *
+           */
+  template <typename Point_range, typename Distance>
+  void set_graph_from_rips(double threshold,
+                           const Gudhi::spatial_searching::Vantage_point_tree<Point_range, Distance>& tree) {
+    remove_edges(one_skeleton);
+    std::vector<std::pair<std::size_t, double> > neighbors;
+    for (int i = 0; i < n; i++) {
+      neighbors.clear();
+      tree.all_near_neighbors_with_distances(tree.points()[i], threshold, std::back_inserter(neighbors));
+      for (auto const& nghb : neighbors) {
+        int j = nghb.first;
+        if (j <= i) continue;
+        boost::add_edge(vertices[i], vertices[j], one_skeleton);
+        boost::put(boost::edge_weight, one_skeleton, boost::edge(vertices[i], vertices[j], one_skeleton).first,
+                   nghb.second);
+      }
+    }
+  }
+
  public:
   void set_graph_weights() {
     Index_map index = boost::get(boost::vertex_index, one_skeleton);
@@ -369,6 +453,23 @@ class Cover_complex {
                  distances[index[boost::source(*ei, one_skeleton)]][index[boost::target(*ei, one_skeleton)]]);
   }
 
+  /** \brief Sets the weights of the edges of the graph G to the distances between their endpoints, computed with
+   * `distance` instead of being read in the distance matrix.
+   *
+   * @param[in] distance distance between data points.
+   *
+   */
+  template <typename Distance>
+  void set_graph_weights(Distance distance) {
+    Index_map index = boost::get(boost::vertex_index, one_skeleton);
+    Weight_map weight = boost::get(boost::edge_weight, one_skeleton);
+    boost::graph_traits<Graph>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::edges(one_skeleton); ei != ei_end; ++ei)
+      boost::put(weight, *ei,
+                 distance(point_cloud[index[boost::source(*ei, one_skeleton)]],
+                          point_cloud[index[boost::target(*ei, one_skeleton)]]));
+  }
+
  public:
   /** \brief Reads and stores the distance matrices from vector stored in memory.
    *
@@ -444,11 +545,23 @@ class Cover_complex {
     if (verbose) std::clog << n << " points in R^" << data_dimension << std::endl;
     if (verbose) std::clog << "Subsampling " << m << " points" << std::endl;
 
-    if (distances.size() == 0) compute_pairwise_distances(distance);
-
-    #ifdef GUDHI_USE_TBB
-    std::mutex deltamutex;
-    tbb::parallel_for(0, N, [&](int i){
+    // Hausdorff distance between the point cloud and a random subsample of m points.
+    std::function<double()> hausdorff_to_subsample;
+    if (on_demand_distances && distances.size() == 0) {
+      // The distance of each point to the subsample is found with a nearest neighbor query.
+      hausdorff_to_subsample = [&]() {
+        std::vector<int> samples(m);
+        SampleWithoutReplacement(n, m, samples);
+        Gudhi::spatial_searching::Vantage_point_tree<std::vector<Point>, Distance> tree(point_cloud, samples,
+                                                                                       distance);
+        double hausdorff_dist = 0;
+        for (int j = 0; j < n; j++)
+          hausdorff_dist = (std::max)(hausdorff_dist, (double)tree.k_nearest_neighbors(point_cloud[j], 1)[0].second);
+        return hausdorff_dist;
+      };
+    } else {
+      if (distances.size() == 0) compute_pairwise_distances(distance);
+      hausdorff_to_subsample = [&]() {
         std::vector<int> samples(m);
         SampleWithoutReplacement(n, m, samples);
         double hausdorff_dist = 0;
@@ -457,22 +570,20 @@ class Cover_complex {
           for (int k = 1; k < m; k++) mj = (std::min)(mj, distances[j][samples[k]]);
           hausdorff_dist = (std::max)(hausdorff_dist, mj);
         }
+        return hausdorff_dist;
+      };
+    }
+
+    #ifdef GUDHI_USE_TBB
+    std::mutex deltamutex;
+    tbb::parallel_for(0, N, [&](int i){
+        double hausdorff_dist = hausdorff_to_subsample();
         deltamutex.lock();
         delta += hausdorff_dist / N;
         deltamutex.unlock();
       });
     #else
-      for (int i = 0; i < N; i++) {
-        std::vector<int> samples(m);
-        SampleWithoutReplacement(n, m, samples);
-        double hausdorff_dist = 0;
-        for (int j = 0; j < n; j++) {
-          double mj = distances[j][samples[0]];
-          for (int k = 1; k < m; k++) mj = (std::min)(mj, distances[j][samples[k]]);
-          hausdorff_dist = (std::max)(hausdorff_dist, mj);
-        }
-        delta += hausdorff_dist / N;
-      }
+      for (int i = 0; i < N; i++) delta += hausdorff_to_subsample() / N;
     #endif
 
     if (verbose) std::clog << "delta = " << delta << std::endl;
@@ -697,11 +808,11 @@ class Cover_complex {
     for (int i = 0; i < n; i++) points[i] = i;
     std::sort(points.begin(), points.end(), [this](int p1, int p2){return (this->func[p1] < this->func[p2]);});
 
-    int id = 0;
     int pos = 0;
-    Index_map index = boost::get(boost::vertex_index, one_skeleton);  // int maxc = -1;
-    std::map<int, std::vector<int> > preimages;
-    std::map<int, double> funcstd;
+    // The preimage of the i-th interval is made of the points points[preimages[i].first], ...,
+    // points[preimages[i].second - 1].
+    std::vector<std::pair<int, int> > preimages(res);
+    std::vector<double> funcstd(res);
 
     if (verbose) std::clog << "Computing preimages..." << std::endl;
     for (int i = 0; i < res; i++) {
@@ -709,12 +820,12 @@ class Cover_complex {
       std::pair<double, double> inter1 = intervals[i];
       int tmp = pos;
       double u, v;
+      preimages[i].first = pos;
 
       if (i != res - 1) {
         if (i != 0) {
           std::pair<double, double> inter3 = intervals[i - 1];
           while (func[points[tmp]] < inter3.second && tmp != n) {
-            preimages[i].push_back(points[tmp]);
             tmp++;
           }
           u = inter3.second;
@@ -724,105 +835,109 @@ class Cover_complex {
 
         std::pair<double, double> inter2 = intervals[i + 1];
         while (func[points[tmp]] < inter2.first && tmp != n) {
-          preimages[i].push_back(points[tmp]);
           tmp++;
         }
         v = inter2.first;
         pos = tmp;
         while (func[points[tmp]] < inter1.second && tmp != n) {
-          preimages[i].push_back(points[tmp]);
           tmp++;
         }
 
       } else {
         std::pair<double, double> inter3 = intervals[i - 1];
         while (func[points[tmp]] < inter3.second && tmp != n) {
-          preimages[i].push_back(points[tmp]);
           tmp++;
         }
         while (tmp != n) {
-          preimages[i].push_back(points[tmp]);
           tmp++;
         }
         u = inter3.second;
         v = inter1.second;
       }
 
+      preimages[i].second = tmp;
       funcstd[i] = 0.5 * (u + v);
     }
 
-    #ifdef GUDHI_USE_TBB
-      if (verbose) std::clog << "Computing connected components (parallelized)..." << std::endl;
-      std::mutex covermutex, idmutex;
-      tbb::parallel_for(0, res, [&](int i){
-        // Compute connected components
-        Graph G = one_skeleton.create_subgraph();
-        int num = preimages[i].size();
-        std::vector<int> component(num);
-        for (int j = 0; j < num; j++) boost::add_vertex(index[vertices[preimages[i][j]]], G);
-        boost::connected_components(G, &component[0]);
-        int max = 0;
-
-        // For each point in preimage
-        for (int j = 0; j < num; j++) {
-          // Update number of components in preimage
-          if (component[j] > max) max = component[j];
-
-          // Identify component with Cantor polynomial N^2 -> N
-          int identifier = ((i + component[j])*(i + component[j]) + 3 * i + component[j]) / 2;
-
-          // Update covers
-          covermutex.lock();
-          cover[preimages[i][j]].push_back(identifier);
-          cover_back[identifier].push_back(preimages[i][j]);
-          cover_fct[identifier] = i;
-          cover_std[identifier] = funcstd[i];
-          cover_color[identifier].second += func_color[preimages[i][j]];
-          cover_color[identifier].first += 1;
-          covermutex.unlock();
+    // Position of each point in the sorted order, to know whether a neighbor is in the same preimage.
+    std::vector<int> rank(n);
+    for (int i = 0; i < n; i++) rank[points[i]] = i;
+
+    // Neighbors of each point in the graph, stored contiguously.
+    Index_map index = boost::get(boost::vertex_index, one_skeleton);
+    std::vector<int> neighbors_begin(n + 1, 0), neighbors;
+    boost::graph_traits<Graph>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::edges(one_skeleton); ei != ei_end; ++ei) {
+      neighbors_begin[index[boost::source(*ei, one_skeleton)] + 1]++;
+      neighbors_begin[index[boost::target(*ei, one_skeleton)] + 1]++;
+    }
+    for (int i = 0; i < n; i++) neighbors_begin[i + 1] += neighbors_begin[i];
+    neighbors.resize(neighbors_begin[n]);
+    {
+      std::vector<int> next(neighbors_begin.begin(), neighbors_begin.end() - 1);
+      for (boost::tie(ei, ei_end) = boost::edges(one_skeleton); ei != ei_end; ++ei) {
+        int source = index[boost::source(*ei, one_skeleton)], target = index[boost::target(*ei, one_skeleton)];
+        neighbors[next[source]++] = target;
+        neighbors[next[target]++] = source;
+      }
+    }
+
+    // Connected components of the j-th point of each preimage, numbered by order of appearance in the preimage.
+    std::vector<std::vector<int> > components(res);
+    std::vector<int> num_components(res);
+    auto compute_components = [&](int i) {
+      int first = preimages[i].first;
+      int num = preimages[i].second - first;
+      std::vector<int> parent(num);
+      for (int j = 0; j < num; j++) parent[j] = j;
+      for (int j = 0; j < num; j++) {
+        int p = points[first + j];
+        for (int k = neighbors_begin[p]; k != neighbors_begin[p + 1]; k++) {
+          int l = rank[neighbors[k]] - first;
+          if (l >= 0 && l < num) union_components(parent, j, l);
         }
+      }
+      std::vector<int> label(num, -1);
+      components[i].resize(num);
+      for (int j = 0; j < num; j++) {
+        int root = find_component(parent, j);
+        if (label[root] == -1) label[root] = num_components[i]++;
+        components[i][j] = label[root];
+      }
+    };
 
-        // Maximal dimension is total number of connected components
-        idmutex.lock();
-        id += max + 1;
-        idmutex.unlock();
-      });
+    #ifdef GUDHI_USE_TBB
+      if (verbose) std::clog << "Computing connected components (parallelized)..." << std::endl;
+      tbb::parallel_for(0, res, compute_components);
     #else
       if (verbose) std::clog << "Computing connected components..." << std::endl;
-      for (int i = 0; i < res; i++) {
-        // Compute connected components
-        Graph G = one_skeleton.create_subgraph();
-        int num = preimages[i].size();
-        std::vector<int> component(num);
-        for (int j = 0; j < num; j++) boost::add_vertex(index[vertices[preimages[i][j]]], G);
-        boost::connected_components(G, &component[0]);
-        int max = 0;
-
-        // For each point in preimage
-        for (int j = 0; j < num; j++) {
-          // Update number of components in preimage
-          if (component[j] > max) max = component[j];
-
-          // Identify component with Cantor polynomial N^2 -> N
-          int identifier = (std::pow(i + component[j], 2) + 3 * i + component[j]) / 2;
-
-          // Update covers
-          cover[preimages[i][j]].push_back(identifier);
-          cover_back[identifier].push_back(preimages[i][j]);
-          cover_fct[identifier] = i;
-          cover_std[identifier] = funcstd[i];
-          cover_color[identifier].second += func_color[preimages[i][j]];
-          cover_color[identifier].first += 1;
-        }
+      for (int i = 0; i < res; i++) compute_components(i);
+    #endif
 
-        // Maximal dimension is total number of connected components
-        id += max + 1;
+    // The components of the i-th preimage get consecutive ids, after the ones of the previous preimages.
+    int id = 0;
+    for (int i = 0; i < res; i++) id += num_components[i];
+    cover_back.assign(id, std::vector<int>());
+    cover_fct.assign(id, 0);
+    cover_std.assign(id, 0);
+    cover_color.assign(id, std::pair<int, double>(0, 0));
+    int offset = 0;
+    for (int i = 0; i < res; i++) {
+      for (int j = 0; j < preimages[i].second - preimages[i].first; j++) {
+        int p = points[preimages[i].first + j];
+        int identifier = offset + components[i][j];
+        cover[p].push_back(identifier);
+        cover_back[identifier].push_back(p);
+        cover_fct[identifier] = i;
+        cover_std[identifier] = funcstd[i];
+        cover_color[identifier].second += func_color[p];
+        cover_color[identifier].first += 1;
       }
-    #endif
+      offset += num_components[i];
+    }
 
     maximal_dim = id - 1;
-    for (std::map<int, std::pair<int, double> >::iterator iit = cover_color.begin(); iit != cover_color.end(); iit++)
-      iit->second.second /= iit->second.first;
+    for (auto& color : cover_color) color.second /= color.first;
   }
 
  public:  // Set cover from file.
@@ -844,6 +959,7 @@ class Cover_complex {
       while (stream >> cov) {
         cov_elts.push_back(cov);
         cov_number.push_back(cov);
+        resize_cover_elements(cov + 1);
         cover_fct[cov] = cov;
         cover_color[cov].second += func_color[i];
         cover_color[cov].first++;
@@ -858,7 +974,8 @@ class Cover_complex {
     cov_number.resize(std::distance(cov_number.begin(), it));
 
     maximal_dim = cov_number.size() - 1;
-    for (int i = 0; i <= maximal_dim; i++) cover_color[i].second /= cover_color[i].first;
+    for (auto& color : cover_color)
+      if (color.first > 0) color.second /= color.first;
     cover_name = cover_file_name;
   }
 
@@ -873,55 +990,52 @@ class Cover_complex {
   void set_cover_from_Voronoi(Distance distance, int m = 100) {
     voronoi_subsamples.resize(m);
     SampleWithoutReplacement(n, m, voronoi_subsamples);
-    if (distances.size() == 0) compute_pairwise_distances(distance);
-    set_graph_weights();
+    if (on_demand_distances && distances.size() == 0) {
+      set_graph_weights(distance);
+    } else {
+      if (distances.size() == 0) compute_pairwise_distances(distance);
+      set_graph_weights();
+    }
+
+    // Compute the geodesic distances to the closest subsample with a single Dijkstra started from all the subsamples.
+    if (verbose) std::clog << "Computing geodesic distances..." << std::endl;
     Weight_map weight = boost::get(boost::edge_weight, one_skeleton);
     Index_map index = boost::get(boost::vertex_index, one_skeleton);
-    std::vector<double> mindist(n);
-    for (int j = 0; j < n; j++) mindist[j] = (std::numeric_limits<double>::max)();
-
-    // Compute the geodesic distances to subsamples with Dijkstra
-    #ifdef GUDHI_USE_TBB
-      if (verbose) std::clog << "Computing geodesic distances (parallelized)..." << std::endl;
-      std::mutex coverMutex; std::mutex mindistMutex;
-      tbb::parallel_for(0, m, [&](int i){
-        int seed = voronoi_subsamples[i];
-        std::vector<double> dmap(n);
-        boost::dijkstra_shortest_paths(
-            one_skeleton, vertices[seed],
-            boost::weight_map(weight).distance_map(boost::make_iterator_property_map(dmap.begin(), index)));
-
-        coverMutex.lock(); mindistMutex.lock();
-        for (int j = 0; j < n; j++)
-          if (mindist[j] > dmap[j]) {
-            mindist[j] = dmap[j];
-            if (cover[j].size() == 0)
-              cover[j].push_back(i);
-            else
-              cover[j][0] = i;
-          }
-        coverMutex.unlock(); mindistMutex.unlock();
-      });
-    #else
-      for (int i = 0; i < m; i++) {
-        if (verbose) std::clog << "Computing geodesic distances to seed " << i << "..." << std::endl;
-        int seed = voronoi_subsamples[i];
-        std::vector<double> dmap(n);
-        boost::dijkstra_shortest_paths(
-            one_skeleton, vertices[seed],
-            boost::weight_map(weight).distance_map(boost::make_iterator_property_map(dmap.begin(), index)));
-
-        for (int j = 0; j < n; j++)
-          if (mindist[j] > dmap[j]) {
-            mindist[j] = dmap[j];
-            if (cover[j].size() == 0)
-              cover[j].push_back(i);
-            else
-              cover[j][0] = i;
-          }
+    // Pairs (geodesic distance, subsample), compared lexicographically so that ties go to the first subsample.
+    using Label = std::pair<double, int>;
+    using Queue_entry = std::pair<Label, int>;
+    std::vector<Label> closest(n, Label((std::numeric_limits<double>::max)(), -1));
+    std::priority_queue<Queue_entry, std::vector<Queue_entry>, std::greater<Queue_entry> > queue;
+    for (int i = 0; i < m; i++) {
+      Label label(0, i);
+      if (label < closest[voronoi_subsamples[i]]) {
+        closest[voronoi_subsamples[i]] = label;
+        queue.emplace(label, voronoi_subsamples[i]);
       }
-    #endif
+    }
+    while (!queue.empty()) {
+      Queue_entry top = queue.top();
+      queue.pop();
+      if (top.first != closest[top.second]) continue;  // outdated entry.
+      boost::graph_traits<Graph>::out_edge_iterator ei, ei_end;
+      for (boost::tie(ei, ei_end) = boost::out_edges(vertices[top.second], one_skeleton); ei != ei_end; ++ei) {
+        int j = index[boost::target(*ei, one_skeleton)];
+        Label label(top.first.first + boost::get(weight, *ei), top.first.second);
+        if (label < closest[j]) {
+          closest[j] = label;
+          queue.emplace(label, j);
+        }
+      }
+    }
+    for (int j = 0; j < n; j++) {
+      if (closest[j].second == -1) continue;
+      if (cover[j].size() == 0)
+        cover[j].push_back(closest[j].second);
+      else
+        cover[j][0] = closest[j].second;
+    }
 
+    resize_cover_elements(m);
     for (int i = 0; i < n; i++) {
       cover_back[cover[i][0]].push_back(i);
       cover_color[cover[i][0]].second += func_color[i];
@@ -1007,9 +1121,10 @@ class Cover_complex {
 
     double maxv = std::numeric_limits<double>::lowest();
     double minv = (std::numeric_limits<double>::max)();
-    for (std::map<int, std::pair<int, double> >::iterator iit = cover_color.begin(); iit != cover_color.end(); iit++) {
-      maxv = (std::max)(maxv, iit->second.second);
-      minv = (std::min)(minv, iit->second.second);
+    for (auto const& color : cover_color) {
+      if (color.first == 0) continue;
+      maxv = (std::max)(maxv, color.second);
+      minv = (std::min)(minv, color.second);
     }
 
     int k = 0;
@@ -1018,15 +1133,18 @@ class Cover_complex {
 
     graphic << "graph GIC {" << std::endl;
     int id = 0;
-    for (std::map<int, std::pair<int, double> >::iterator iit = cover_color.begin(); iit != cover_color.end(); iit++) {
-      if (iit->second.first > mask) {
-        nodes.push_back(iit->first);
-        name2id[iit->first] = id;
-        name2idinv[id] = iit->first;
+    int num_cover_elements = cover_color.size();
+    name2id.assign(num_cover_elements, -1);
+    name2idinv.clear();
+    for (int c = 0; c < num_cover_elements; c++) {
+      if (cover_color[c].first > mask) {
+        nodes.push_back(c);
+        name2id[c] = id;
+        name2idinv.push_back(c);
         id++;
-        graphic << name2id[iit->first] << "[shape=circle fontcolor=black color=black label=\"" << name2id[iit->first]
-                << ":" << iit->second.first << "\" style=filled fillcolor=\""
-                << (1 - (maxv - iit->second.second) / (maxv - minv)) * 0.6 << ", 1, 1\"]" << std::endl;
+        graphic << name2id[c] << "[shape=circle fontcolor=black color=black label=\"" << name2id[c]
+                << ":" << cover_color[c].first << "\" style=filled fillcolor=\""
+                << (1 - (maxv - cover_color[c].second) / (maxv - minv)) * 0.6 << ", 1, 1\"]" << std::endl;
         k++;
       }
     }
@@ -1063,13 +1181,20 @@ class Cover_complex {
     graphic << cover_name << std::endl;
     graphic << color_name << std::endl;
     graphic << resolution_double << " " << gain << std::endl;
-    graphic << cover_color.size() << " " << num_edges << std::endl;
+    int num_cover_elements = cover_color.size();
+    int num_nodes = 0;
+    for (int c = 0; c < num_cover_elements; c++)
+      if (cover_color[c].first > 0) num_nodes++;
+    graphic << num_nodes << " " << num_edges << std::endl;
 
     int id = 0;
-    for (std::map<int, std::pair<int, double> >::iterator iit = cover_color.begin(); iit != cover_color.end(); iit++) {
-      graphic << id << " " << iit->second.second << " " << iit->second.first << std::endl;
-      name2id[iit->first] = id;
-      name2idinv[id] = iit->first;
+    name2id.assign(num_cover_elements, -1);
+    name2idinv.clear();
+    for (int c = 0; c < num_cover_elements; c++) {
+      if (cover_color[c].first == 0) continue;
+      graphic << id << " " << cover_color[c].second << " " << cover_color[c].first << std::endl;
+      name2id[c] = id;
+      name2idinv.push_back(c);
       id++;
     }
 
@@ -1142,9 +1267,9 @@ class Cover_complex {
     // Compute max and min
     double maxf = std::numeric_limits<double>::lowest();
     double minf = (std::numeric_limits<double>::max)();
-    for (std::map<int, double>::iterator it = cover_std.begin(); it != cover_std.end(); it++) {
-      maxf = (std::max)(maxf, it->second);
-      minf = (std::min)(minf, it->second);
+    for (double value : cover_std) {
+      maxf = (std::max)(maxf, value);
+      minf = (std::min)(minf, value);
     }
 
     // Build filtration
@@ -1154,8 +1279,9 @@ class Cover_complex {
       st.insert_simplex_and_subfaces(splx, -3);
     }
 
-    for (std::map<int, double>::iterator it = cover_std.begin(); it != cover_std.end(); it++) {
-      int vertex = it->first; float val = it->second;
+    int num_cover_elements = cover_std.size();
+    for (int vertex = 0; vertex < num_cover_elements; vertex++) {
+      float val = cover_std[vertex];
       int vert[] = {vertex}; int edge[] = {vertex, -2};
       if(st.find(vert) != st.null_simplex()){
         st.assign_filtration(st.find(vert), -2 + (val - minf)/(maxf - minf));
@@ -1195,6 +1321,11 @@ class Cover_complex {
 
  public:
   /** \brief Computes bootstrapped distances distribution.
+   *
+   * @details Each bootstrap iteration builds the complex of a resampling (with replacement) of the point cloud, whose
+   * graph is the restriction of the graph G (two copies of the same point being adjacent), and computes the bottleneck
+   * distance between its persistence diagram and the one of this complex. With TBB, the iterations run in parallel,
+   * each with its own random number generator, so that the distribution does not depend on the scheduling.
    *
    * @param[in] N number of bootstrap iterations.
    *
@@ -1202,41 +1333,67 @@ class Cover_complex {
   void compute_distribution(unsigned int N = 100) {
     unsigned int sz = distribution.size();
     if (sz < N) {
-      for (unsigned int i = 0; i < N - sz; i++) {
-        if (verbose)  std::clog << "Computing " << i << "th bootstrap, bottleneck distance = ";
-
-        Cover_complex Cboot; Cboot.n = this->n; Cboot.data_dimension = this->data_dimension; Cboot.type = this->type; Cboot.functional_cover = true;
-
-        std::vector<int> boot(this->n);
-        for (int j = 0; j < this->n; j++) {
-          double u = GetUniform();
-          int id = std::floor(u * (this->n)); boot[j] = id;
-          Cboot.point_cloud.push_back(this->point_cloud[id]); Cboot.cover.emplace_back(); Cboot.func.push_back(this->func[id]);
-          boost::add_vertex(Cboot.one_skeleton_OFF); Cboot.vertices.push_back(boost::add_vertex(Cboot.one_skeleton));
-        }
-        Cboot.set_color_from_range(Cboot.func);
-
-        for (int j = 0; j < n; j++) {
-          std::vector<double> dist(n);
-          for (int k = 0; k < n; k++) dist[k] = distances[boot[j]][boot[k]];
-          Cboot.distances.push_back(dist);
-        }
-
-        Cboot.set_graph_from_automatic_rips(Gudhi::Euclidean_distance());
-        Cboot.set_gain();
-        Cboot.set_automatic_resolution();
-        Cboot.set_cover_from_function();
-        Cboot.find_simplices();
-        Cboot.compute_PD();
-        double db = Gudhi::persistence_diagram::bottleneck_distance(this->PD, Cboot.PD);
-        if (verbose)  std::clog << db << std::endl;
-        distribution.push_back(db);
-      }
+      // The edges of the graph, which are shared by all the bootstrap iterations.
+      Index_map index = boost::get(boost::vertex_index, one_skeleton);
+      std::vector<std::pair<int, int> > edges;
+      edges.reserve(boost::num_edges(one_skeleton));
+      boost::graph_traits<Graph>::edge_iterator ei, ei_end;
+      for (boost::tie(ei, ei_end) = boost::edges(one_skeleton); ei != ei_end; ++ei)
+        edges.emplace_back(index[boost::source(*ei, one_skeleton)], index[boost::target(*ei, one_skeleton)]);
+
+      // The i-th iteration uses a random number generator seeded with (seed, i).
+      unsigned int seed = std::uniform_int_distribution<unsigned int>()(random_engine());
+      distribution.resize(N);
+      auto bootstrap = [&](unsigned int i) {
+        std::seed_seq seq{seed, i};
+        std::mt19937 re(seq);
+        distribution[i] = compute_bootstrap_distance(edges, re);
+        if (verbose) std::clog << "Computing " << i - sz << "th bootstrap, bottleneck distance = " << distribution[i]
+                               << std::endl;
+      };
+      #ifdef GUDHI_USE_TBB
+        tbb::parallel_for(sz, N, bootstrap);
+      #else
+        for (unsigned int i = sz; i < N; i++) bootstrap(i);
+      #endif
 
       std::sort(distribution.begin(), distribution.end());
     }
   }
 
+ private:
+  // Computes the bottleneck distance between the persistence diagram of the complex and the one of the complex of a
+  // resampling of the points. edges are the edges of the graph G.
+  template <typename Random_engine>
+  double compute_bootstrap_distance(const std::vector<std::pair<int, int> >& edges, Random_engine& re) {
+    Cover_complex Cboot; Cboot.n = this->n; Cboot.data_dimension = this->data_dimension; Cboot.type = this->type; Cboot.functional_cover = true;
+
+    // Positions of the copies of each point in the resampling.
+    std::vector<std::vector<int> > copies(this->n);
+    std::uniform_int_distribution<int> Dist(0, this->n - 1);
+    for (int j = 0; j < this->n; j++) {
+      int id = Dist(re); copies[id].push_back(j);
+      Cboot.cover.emplace_back(); Cboot.func.push_back(this->func[id]);
+      Cboot.vertices.push_back(boost::add_vertex(Cboot.one_skeleton));
+    }
+    Cboot.set_color_from_range(Cboot.func);
+
+    for (auto const& edge : edges)
+      for (int j : copies[edge.first])
+        for (int k : copies[edge.second]) boost::add_edge(Cboot.vertices[j], Cboot.vertices[k], Cboot.one_skeleton);
+    for (auto const& point_copies : copies)
+      for (std::size_t j = 0; j < point_copies.size(); j++)
+        for (std::size_t k = j + 1; k < point_copies.size(); k++)
+          boost::add_edge(Cboot.vertices[point_copies[j]], Cboot.vertices[point_copies[k]], Cboot.one_skeleton);
+
+    Cboot.set_gain();
+    Cboot.set_automatic_resolution();
+    Cboot.set_cover_from_function();
+    Cboot.find_simplices();
+    Cboot.compute_PD();
+    return Gudhi::persistence_diagram::bottleneck_distance(this->PD, Cboot.PD);
+  }
+
  public:
   /** \brief Computes the bottleneck distance threshold corresponding to a specific confidence level.
    *
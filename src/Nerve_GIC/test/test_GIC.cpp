@@ -13,8 +13,12 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>  // for std::remove
 #include <limits>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gudhi/GIC.h>
@@ -79,3 +83,131 @@ BOOST_AUTO_TEST_CASE(check_voronoiGIC) {
   BOOST_CHECK((stree.num_simplices() - stree.num_vertices()) == 1);
   BOOST_CHECK(stree.dimension() == 1);
 }
+
+BOOST_AUTO_TEST_CASE(check_voronoiGIC_on_demand_distances) {
+  using Point = std::vector<float>;
+  Gudhi::cover_complex::Cover_complex<Point> GIC;
+  GIC.set_type("GIC");
+  GIC.set_on_demand_distances();
+  std::string cloud_file_name("data/cloud");
+  GIC.read_point_cloud(cloud_file_name);
+  GIC.set_color_from_coordinate();
+  std::string graph_file_name("data/graph");
+  GIC.set_graph_from_file(graph_file_name);
+  GIC.set_cover_from_Voronoi(Gudhi::Euclidean_distance(), 2);
+  GIC.find_simplices();
+  Gudhi::Simplex_tree<> stree;
+  GIC.create_complex(stree);
+
+  BOOST_CHECK(stree.num_vertices() == 2);
+  BOOST_CHECK((stree.num_simplices() - stree.num_vertices()) == 1);
+  BOOST_CHECK(stree.dimension() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(check_rips_GIC_on_demand_distances) {
+  using Point = std::vector<double>;
+  // Points on a circle.
+  std::vector<Point> points;
+  for (int i = 0; i < 50; i++) points.push_back({std::cos(2 * M_PI * i / 50), std::sin(2 * M_PI * i / 50)});
+
+  Gudhi::Simplex_tree<> stree[2];
+  for (int on_demand = 0; on_demand != 2; on_demand++) {
+    // In dense mode, the distances would be read from the file "matrix_dist" if it exists, and written to it otherwise.
+    std::remove("matrix_dist");
+    Gudhi::cover_complex::Cover_complex<Point> GIC;
+    GIC.set_type("GIC");
+    GIC.set_on_demand_distances(on_demand);
+    GIC.set_point_cloud_from_range(points);
+    GIC.set_color_from_coordinate();
+    GIC.set_function_from_coordinate(0);
+    GIC.set_graph_from_rips(0.3, Gudhi::Euclidean_distance());
+    GIC.set_resolution_with_interval_number(4);
+    GIC.set_gain(0.3);
+    GIC.set_cover_from_function();
+    GIC.find_simplices();
+    GIC.create_complex(stree[on_demand]);
+    std::remove("matrix_dist");
+  }
+
+  // The circle is recovered in both modes.
+  BOOST_CHECK(stree[0].num_vertices() == 6);
+  BOOST_CHECK(stree[0] == stree[1]);
+}
+
+BOOST_AUTO_TEST_CASE(check_functional_cover_components) {
+  using Point = std::vector<double>;
+  // Two parallel segments, which are disconnected in the graph.
+  std::vector<Point> points;
+  for (int i = 0; i < 20; i++) {
+    points.push_back({0.1 * i, 0.});
+    points.push_back({0.1 * i, 5.});
+  }
+
+  Gudhi::cover_complex::Cover_complex<Point> GIC;
+  GIC.set_type("GIC");
+  GIC.set_on_demand_distances();
+  GIC.set_point_cloud_from_range(points);
+  GIC.set_color_from_coordinate();
+  GIC.set_function_from_coordinate(0);
+  GIC.set_graph_from_rips(0.15, Gudhi::Euclidean_distance());
+  GIC.set_resolution_with_interval_number(3);
+  GIC.set_gain(0.3);
+  GIC.set_cover_from_function();
+  GIC.find_simplices();
+  Gudhi::Simplex_tree<> stree;
+  GIC.create_complex(stree);
+
+  // Each preimage has two components, numbered consecutively.
+  BOOST_CHECK(stree.num_vertices() == 6);
+  BOOST_CHECK((stree.num_simplices() - stree.num_vertices()) == 4);
+  std::vector<int> vertices;
+  for (auto vertex : stree.complex_vertex_range()) vertices.push_back(vertex);
+  std::sort(vertices.begin(), vertices.end());
+  BOOST_CHECK(vertices == std::vector<int>({0, 1, 2, 3, 4, 5}));
+}
+
+// Quantiles of the bootstrap distribution of a GIC of points on a circle, and its p-value
+std::vector<double> bootstrap_quantiles(int num_bootstraps, double& p_value) {
+  using Point = std::vector<double>;
+  std::vector<Point> points;
+  for (int i = 0; i < 100; i++) points.push_back({std::cos(2 * M_PI * i / 100), std::sin(2 * M_PI * i / 100)});
+
+  Gudhi::cover_complex::Cover_complex<Point> GIC;
+  GIC.set_type("GIC");
+  GIC.set_on_demand_distances();
+  GIC.set_point_cloud_from_range(points);
+  GIC.set_color_from_coordinate();
+  GIC.set_function_from_coordinate(0);
+  GIC.set_graph_from_rips(0.2, Gudhi::Euclidean_distance());
+  GIC.set_resolution_with_interval_number(4);
+  GIC.set_gain(0.3);
+  GIC.set_cover_from_function();
+  GIC.find_simplices();
+  GIC.compute_PD();
+
+  GIC.compute_distribution(num_bootstraps);
+  std::vector<double> quantiles;
+  for (int i = 0; i < num_bootstraps; i++)
+    quantiles.push_back(GIC.compute_distance_from_confidence_level((i + 0.5) / num_bootstraps));
+  p_value = GIC.compute_p_value();
+  return quantiles;
+}
+
+BOOST_AUTO_TEST_CASE(check_bootstrap) {
+  // Each thread starts with the same random number generator, so two computations in new threads draw the same
+  // resamplings. The bootstrap iterations, run in parallel with TBB, must give the same distances in both.
+  std::vector<double> quantiles[2];
+  double p_values[2];
+  for (int i = 0; i < 2; i++) {
+    std::thread thread([&quantiles, &p_values, i]() { quantiles[i] = bootstrap_quantiles(20, p_values[i]); });
+    thread.join();
+  }
+  BOOST_CHECK(quantiles[0] == quantiles[1]);
+  BOOST_CHECK(p_values[0] == p_values[1]);
+  BOOST_CHECK(p_values[0] >= 0 && p_values[0] <= 1);
+
+  // The resamplings differ, and so do the distances
+  BOOST_CHECK(std::is_sorted(quantiles[0].begin(), quantiles[0].end()));
+  BOOST_CHECK(quantiles[0].front() >= 0);
+  BOOST_CHECK(quantiles[0].front() < quantiles[0].back());
+}
@@ -130,6 +130,9 @@ namespace Persistence_representations {
  \li Compute just a number of initial nonzero landscapes. This option is available from C++ level as a last parameter of
  the constructor of persistence landscape (set by default to std::numeric_limits<size_t>::max()).
 
+ The points of all the levels of a landscape are stored in a single contiguous array. To build the landscapes of many
+ diagrams at once, the function construct_persistence_landscapes() processes them in parallel when TBB is available.
+
 
 
  \section sec_landscapes_on_grid Persistence Landscapes on a grid
@@ -172,6 +175,12 @@ namespace Persistence_representations {
  Therefore to compute scalar product of two corresponding levels of landscapes,
  we sum up the integrals of products of line segments for every pair of constitutive grid points.
 
+ The vectors of all the grid points are stored in a single array, padded with zeros to the same length, so that these
+ distances and scalar products are computed grid point after grid point without building the difference of the
+ landscapes. The functions compute_distance_matrix_of_landscapes_on_grid() and
+ compute_inner_product_matrix_of_landscapes_on_grid() compute them for all the pairs of a collection of landscapes,
+ in parallel when TBB is available.
+
  Note that for this representation we need to specify a few parameters:
 
  \li Begin and end point of a grid -- the interval \f$[x,y]\f$ (real numbers).
@@ -215,6 +224,12 @@ namespace Persistence_representations {
  to diagonal are given then sometimes the kernel have support that reaches the region
  below the diagonal. If the value of this parameter is true, then the values below diagonal can be erased.
 
+ The points of the diagram are first gathered in a histogram on the grid of pixels, which is then convolved with the
+ filter. When the filter is a product of a horizontal and a vertical filter, which is the case of the Gaussian filters
+ given by create_Gaussian_filter(), the convolution is done in one direction after the other. To build the heat maps
+ (or PSSK) of many diagrams at once, the functions construct_persistence_heat_maps() and construct_PSSKs() process them
+ in parallel when TBB is available.
+
  In addition to the previous method, we also provide two more methods to perform exact calculations, in the sense that we use functions
  instead of matrices to define the kernel between the points of the diagrams.
  Indeed, in both of these exact methods, the kernel is no longer provided as a square matrix, or a filter (see parameters above), but rather as
@@ -245,6 +260,11 @@ namespace Persistence_representations {
  We pick the smallest of those and add it to a vector. The obtained vector of numbers is then sorted in decreasing
  order. This way we obtain a persistence vector representing the diagram.
 
+ Only the first coordinates of the vector are kept. They are computed without enumerating all the pairs of points: the
+ points are processed by decreasing distance to the diagonal, which bounds the values of all the pairs involving the
+ remaining points, and for every point only its distances to the nearby points are computed. The function
+ construct_persistence_vectors() builds the vectors of many diagrams at once, in parallel when TBB is available.
+
  Given two persistence vectors, the computation of distances, averages and scalar products is straightforward. Average
  is simply a coordinate-wise average of a collection of vectors. In this section we
  assume that the vectors are extended by zeros if they are of a different size. To compute distances we compute
@@ -267,6 +287,10 @@ namespace Persistence_representations {
  called the <i>Sliced Wasserstein distance</i>: \f$k(D_1,D_2)={\rm exp}\left(-\frac{SW(D_1,D_2)}{2\sigma^2}\right)\f$. Other kernels such as the Persistence Weighted Gaussian kernel or
  the Persistence Scale Space kernel are implemented in Persistence_heat_maps.
 
+ To compute the matrix of the approximate Sliced Wasserstein distances (or kernel values) of many diagrams, the
+ functions sliced_wasserstein_distance_matrix() and sliced_wasserstein_kernel_matrix() project every diagram only once,
+ with Sliced_wasserstein_projections, and compare the pairs of diagrams by blocks, in parallel when TBB is available.
+
  When launching:
 
  \code $> ./Sliced_Wasserstein
@@ -97,59 +97,41 @@ void PSSK::construct(const std::vector<std::pair<double, double> >& intervals_,
   this->min_ = min_;
   this->max_ = max_;
 
-  // initialization of the structure heat_map
-  std::vector<std::vector<double> > heat_map_;
+  // The image is the sum of the kernels at the points (p,q) minus its transpose, which holds the negative kernels at
+  // the points (q,p).
+  std::vector<double> weights_(intervals_.size(), 1.);
+  std::vector<double> image = rasterize(intervals_, weights_, filter, number_of_pixels, this->min_, this->max_);
   for (size_t i = 0; i != number_of_pixels; ++i) {
-    std::vector<double> v(number_of_pixels, 0);
-    heat_map_.push_back(v);
-  }
-  this->heat_map = heat_map_;
-
-  if (dbg) std::cerr << "Done creating of the heat map, now we will fill in the structure \n";
-
-  for (size_t pt_nr = 0; pt_nr != intervals_.size(); ++pt_nr) {
-    // compute the value of intervals_[pt_nr] in the grid:
-    int x_grid =
-        static_cast<int>((intervals_[pt_nr].first - this->min_) / (this->max_ - this->min_) * number_of_pixels);
-    int y_grid =
-        static_cast<int>((intervals_[pt_nr].second - this->min_) / (this->max_ - this->min_) * number_of_pixels);
-
-    if (dbg) {
-      std::cerr << "point : " << intervals_[pt_nr].first << " , " << intervals_[pt_nr].second << std::endl;
-      std::cerr << "x_grid : " << x_grid << std::endl;
-      std::cerr << "y_grid : " << y_grid << std::endl;
-    }
-
-    // x_grid and y_grid gives a center of the kernel. We want to have its lower left corner. To get this, we need to
-    // shift x_grid and y_grid by a grid diameter.
-    x_grid -= filter.size() / 2;
-    y_grid -= filter.size() / 2;
-    // note that the numbers x_grid and y_grid may be negative.
-
-    if (dbg) {
-      std::cerr << "After shift : \n";
-      std::cerr << "x_grid : " << x_grid << std::endl;
-      std::cerr << "y_grid : " << y_grid << std::endl;
-      std::cerr << "filter.size() : " << filter.size() << std::endl;
-      getchar();
-    }
-
-    for (size_t i = 0; i != filter.size(); ++i) {
-      for (size_t j = 0; j != filter.size(); ++j) {
-        // if the point (x_grid+i,y_grid+j) is the correct point in the grid.
-        if (((x_grid + i) >= 0) && (x_grid + i < this->heat_map.size()) && ((y_grid + j) >= 0) &&
-            (y_grid + j < this->heat_map.size())) {
-          if (dbg) {
-            std::cerr << y_grid + j << " " << x_grid + i << std::endl;
-          }
-          this->heat_map[y_grid + j][x_grid + i] += filter[i][j];
-          this->heat_map[x_grid + i][y_grid + j] += -filter[i][j];
-        }
-      }
+    for (size_t j = 0; j != i; ++j) {
+      double difference = image[i * number_of_pixels + j] - image[j * number_of_pixels + i];
+      image[i * number_of_pixels + j] = difference;
+      image[j * number_of_pixels + i] = -difference;
     }
+    image[i * number_of_pixels + i] = 0;
   }
+  this->set_heat_map(image, number_of_pixels);
 }  // construct
 
+/**
+ * Constructs the PSSK of a collection of persistence diagrams (given as vectors of birth-death pairs), in parallel when
+ * TBB is available. The i-th PSSK is the one of diagrams[i], as given by the constructor
+ * PSSK(diagrams[i], filter, number_of_pixels, min_, max_).
+**/
+inline std::vector<PSSK> construct_PSSKs(const std::vector<std::vector<std::pair<double, double> > >& diagrams,
+                                         const std::vector<std::vector<double> >& filter = create_Gaussian_filter(5, 1),
+                                         size_t number_of_pixels = 1000, double min_ = -1, double max_ = -1) {
+  std::vector<PSSK> pssks(diagrams.size());
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(size_t(0), diagrams.size(),
+                    [&](size_t i) { pssks[i] = PSSK(diagrams[i], filter, number_of_pixels, min_, max_); });
+#else
+  for (size_t i = 0; i != diagrams.size(); ++i) {
+    pssks[i] = PSSK(diagrams[i], filter, number_of_pixels, min_, max_);
+  }
+#endif
+  return pssks;
+}
+
 }  // namespace Persistence_representations
 }  // namespace Gudhi
 
@@ -18,6 +18,10 @@
 #include <gudhi/read_persistence_from_file.h>
 #include <gudhi/common_persistence_representations.h>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 // standard include
 #include <vector>
 #include <sstream>
@@ -526,6 +530,19 @@ class Persistence_heat_maps {
     this->number_of_functions_for_projections_to_reals = 1;
   }
 
+  static std::vector<double> rasterize(const std::vector<std::pair<double, double> >& intervals_,
+                                       const std::vector<double>& weights_,
+                                       const std::vector<std::vector<double> >& filter, size_t number_of_pixels,
+                                       double min_, double max_);
+
+  void set_heat_map(const std::vector<double>& image, size_t number_of_pixels) {
+    this->heat_map.assign(number_of_pixels, std::vector<double>(number_of_pixels));
+    for (size_t i = 0; i != number_of_pixels; ++i) {
+      std::copy(image.begin() + i * number_of_pixels, image.begin() + (i + 1) * number_of_pixels,
+                this->heat_map[i].begin());
+    }
+  }
+
   // Boolean indicating if we are computing persistence image (true) or persistence weighted gaussian kernel (false)
   bool discrete = true;
   std::function<double(std::pair<double, double>, std::pair<double, double>)> kernel;
@@ -620,70 +637,126 @@ void Persistence_heat_maps<Scalling_of_kernels>::construct(const std::vector<std
   this->min_ = min_;
   this->max_ = max_;
 
-  // initialization of the structure heat_map
-  std::vector<std::vector<double> > heat_map_;
-  for (size_t i = 0; i != number_of_pixels; ++i) {
-    std::vector<double> v(number_of_pixels, 0);
-    heat_map_.push_back(v);
-  }
-  this->heat_map = heat_map_;
+  std::vector<double> weights_;
+  weights_.reserve(intervals_.size());
+  for (size_t pt_nr = 0; pt_nr != intervals_.size(); ++pt_nr) weights_.push_back(this->f(intervals_[pt_nr]));
+  this->set_heat_map(rasterize(intervals_, weights_, filter, number_of_pixels, this->min_, this->max_),
+                     number_of_pixels);
 
-  if (dbg) std::clog << "Done creating of the heat map, now we will fill in the structure \n";
+  // now it remains to cut everything below diagonal if the user wants us to.
+  if (erase_below_diagonal) {
+    for (size_t i = 0; i != this->heat_map.size(); ++i) {
+      for (size_t j = i; j != this->heat_map.size(); ++j) {
+        this->heat_map[i][j] = 0;
+      }
+    }
+  }
+}  // construct
 
+// Adds, for every point of intervals_, the filter multiplied by the weight of the point to a number_of_pixels times
+// number_of_pixels image stored row by row. The lower left corner of the filter is put filter.size() / 2 pixels below
+// and on the left of the pixel containing the point, and the parts of the filter outside of the image are lost.
+//
+// The points are first gathered in a histogram, so that points falling in the same pixel are added only once. When
+// the filter is the product of a horizontal and a vertical filter, like the ones of create_Gaussian_filter, the
+// histogram is then convolved with them one after the other, which costs O(number_of_pixels * filter.size()) per row
+// of the histogram instead of O(filter.size()^2) per pixel of the histogram. The cheaper of the two is used.
+template <typename Scalling_of_kernels>
+std::vector<double> Persistence_heat_maps<Scalling_of_kernels>::rasterize(
+    const std::vector<std::pair<double, double> >& intervals_, const std::vector<double>& weights_,
+    const std::vector<std::vector<double> >& filter, size_t number_of_pixels, double min_, double max_) {
+  const int n = static_cast<int>(number_of_pixels);
+  const int size = static_cast<int>(filter.size());
+  std::vector<double> image(number_of_pixels * number_of_pixels, 0);
+  if (size == 0 || n == 0) return image;
+
+  // Histogram of the lower left corners of the filters. Only the corners in [1-size, n-1]^2 touch the image.
+  std::vector<std::pair<std::pair<int, int>, double> > histogram;
+  histogram.reserve(intervals_.size());
   for (size_t pt_nr = 0; pt_nr != intervals_.size(); ++pt_nr) {
-    // compute the value of intervals_[pt_nr] in the grid:
-    int x_grid =
-        static_cast<int>((intervals_[pt_nr].first - this->min_) / (this->max_ - this->min_) * number_of_pixels);
-    int y_grid =
-        static_cast<int>((intervals_[pt_nr].second - this->min_) / (this->max_ - this->min_) * number_of_pixels);
-
-    if (dbg) {
-      std::clog << "point : " << intervals_[pt_nr].first << " , " << intervals_[pt_nr].second << std::endl;
-      std::clog << "x_grid : " << x_grid << std::endl;
-      std::clog << "y_grid : " << y_grid << std::endl;
+    int x_grid = static_cast<int>((intervals_[pt_nr].first - min_) / (max_ - min_) * number_of_pixels);
+    int y_grid = static_cast<int>((intervals_[pt_nr].second - min_) / (max_ - min_) * number_of_pixels);
+    x_grid -= size / 2;
+    y_grid -= size / 2;
+    if (x_grid <= -size || x_grid >= n || y_grid <= -size || y_grid >= n) continue;
+    histogram.emplace_back(std::make_pair(y_grid, x_grid), weights_[pt_nr]);
+  }
+  std::sort(histogram.begin(), histogram.end(),
+            [](const std::pair<std::pair<int, int>, double>& a, const std::pair<std::pair<int, int>, double>& b) {
+              return a.first < b.first;
+            });
+  size_t number_of_bins = 0;
+  size_t number_of_rows = 0;
+  for (size_t i = 0; i != histogram.size(); ++i) {
+    if (number_of_bins != 0 && histogram[number_of_bins - 1].first == histogram[i].first) {
+      histogram[number_of_bins - 1].second += histogram[i].second;
+    } else {
+      if (number_of_bins == 0 || histogram[number_of_bins - 1].first.first != histogram[i].first.first)
+        ++number_of_rows;
+      histogram[number_of_bins++] = histogram[i];
     }
-
-    // x_grid and y_grid gives a center of the kernel. We want to have its lower left corner. To get this, we need to
-    // shift x_grid and y_grid by a grid diameter.
-    x_grid -= filter.size() / 2;
-    y_grid -= filter.size() / 2;
-    // note that the numbers x_grid and y_grid may be negative.
-
-    if (dbg) {
-      std::clog << "After shift : \n";
-      std::clog << "x_grid : " << x_grid << std::endl;
-      std::clog << "y_grid : " << y_grid << std::endl;
+  }
+  histogram.resize(number_of_bins);
+
+  // Look for a decomposition filter[i][j] = horizontal[i] * vertical[j], starting from the largest coefficient.
+  int pivot_i = 0, pivot_j = 0;
+  for (int i = 0; i != size; ++i) {
+    for (int j = 0; j != size; ++j) {
+      if (std::fabs(filter[i][j]) > std::fabs(filter[pivot_i][pivot_j])) {
+        pivot_i = i;
+        pivot_j = j;
+      }
     }
-
-    double scaling_value = this->f(intervals_[pt_nr]);
-
-    for (size_t i = 0; i != filter.size(); ++i) {
-      for (size_t j = 0; j != filter.size(); ++j) {
-        // if the point (x_grid+i,y_grid+j) is the correct point in the grid.
-        if (((x_grid + i) >= 0) && (x_grid + i < this->heat_map.size()) && ((y_grid + j) >= 0) &&
-            (y_grid + j < this->heat_map.size())) {
-          if (dbg) {
-            std::clog << y_grid + j << " " << x_grid + i << std::endl;
-          }
-          this->heat_map[y_grid + j][x_grid + i] += scaling_value * filter[i][j];
-          if (dbg) {
-            std::clog << "Position : (" << x_grid + i << "," << y_grid + j
-                      << ") got increased by the value : " << filter[i][j] << std::endl;
-          }
-        }
+  }
+  const double pivot = filter[pivot_i][pivot_j];
+  if (pivot == 0) return image;
+  std::vector<double> horizontal(size), vertical(size);
+  for (int i = 0; i != size; ++i) {
+    horizontal[i] = filter[i][pivot_j];
+    vertical[i] = filter[pivot_i][i] / pivot;
+  }
+  bool separable = true;
+  for (int i = 0; i != size && separable; ++i) {
+    for (int j = 0; j != size; ++j) {
+      if (std::fabs(filter[i][j] - horizontal[i] * vertical[j]) > 1e-12 * std::fabs(pivot)) {
+        separable = false;
+        break;
       }
     }
   }
 
-  // now it remains to cut everything below diagonal if the user wants us to.
-  if (erase_below_diagonal) {
-    for (size_t i = 0; i != this->heat_map.size(); ++i) {
-      for (size_t j = i; j != this->heat_map.size(); ++j) {
-        this->heat_map[i][j] = 0;
+  if (separable && number_of_rows * number_of_pixels + number_of_bins < number_of_bins * filter.size()) {
+    // Convolve each row of the histogram with the horizontal filter, then spread it with the vertical filter.
+    std::vector<double> row(number_of_pixels);
+    size_t bin = 0;
+    while (bin != number_of_bins) {
+      const int y_grid = histogram[bin].first.first;
+      std::fill(row.begin(), row.end(), 0.);
+      for (; bin != number_of_bins && histogram[bin].first.first == y_grid; ++bin) {
+        const int x_grid = histogram[bin].first.second;
+        const double value = histogram[bin].second;
+        for (int i = std::max(0, -x_grid); i < std::min(size, n - x_grid); ++i)
+          row[x_grid + i] += value * horizontal[i];
+      }
+      for (int j = std::max(0, -y_grid); j < std::min(size, n - y_grid); ++j) {
+        double* image_row = image.data() + static_cast<size_t>(y_grid + j) * number_of_pixels;
+        for (size_t x = 0; x != number_of_pixels; ++x) image_row[x] += vertical[j] * row[x];
+      }
+    }
+  } else {
+    for (size_t bin = 0; bin != number_of_bins; ++bin) {
+      const int y_grid = histogram[bin].first.first;
+      const int x_grid = histogram[bin].first.second;
+      const double value = histogram[bin].second;
+      for (int j = std::max(0, -y_grid); j < std::min(size, n - y_grid); ++j) {
+        double* image_row = image.data() + static_cast<size_t>(y_grid + j) * number_of_pixels;
+        for (int i = std::max(0, -x_grid); i < std::min(size, n - x_grid); ++i)
+          image_row[x_grid + i] += value * filter[i][j];
       }
     }
   }
-}  // construct
+  return image;
+}
 
 template <typename Scalling_of_kernels>
 Persistence_heat_maps<Scalling_of_kernels>::Persistence_heat_maps(
@@ -987,6 +1060,35 @@ double Persistence_heat_maps<Scalling_of_kernels>::compute_scalar_product(const
   }
 }
 
+/**
+ * Constructs the persistence heat maps of a collection of persistence diagrams (given as vectors of birth-death pairs),
+ * in parallel when TBB is available. The i-th heat map is the one of diagrams[i], as given by the constructor
+ * Persistence_heat_maps(diagrams[i], filter, erase_below_diagonal, number_of_pixels, min_, max_). In particular, if
+ * min_ and max_ are not given, the range of each heat map is computed from its own diagram.
+ *
+ * \ingroup Persistence_representations
+**/
+template <typename Scalling_of_kernels = constant_scaling_function>
+std::vector<Persistence_heat_maps<Scalling_of_kernels> > construct_persistence_heat_maps(
+    const std::vector<std::vector<std::pair<double, double> > >& diagrams,
+    const std::vector<std::vector<double> >& filter = create_Gaussian_filter(5, 1), bool erase_below_diagonal = false,
+    size_t number_of_pixels = 1000, double min_ = std::numeric_limits<double>::max(),
+    double max_ = std::numeric_limits<double>::max()) {
+  std::vector<Persistence_heat_maps<Scalling_of_kernels> > heat_maps(diagrams.size());
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(size_t(0), diagrams.size(), [&](size_t i) {
+    heat_maps[i] = Persistence_heat_maps<Scalling_of_kernels>(diagrams[i], filter, erase_below_diagonal,
+                                                              number_of_pixels, min_, max_);
+  });
+#else
+  for (size_t i = 0; i != diagrams.size(); ++i) {
+    heat_maps[i] = Persistence_heat_maps<Scalling_of_kernels>(diagrams[i], filter, erase_below_diagonal,
+                                                              number_of_pixels, min_, max_);
+  }
+#endif
+  return heat_maps;
+}
+
 }  // namespace Persistence_representations
 }  // namespace Gudhi
 
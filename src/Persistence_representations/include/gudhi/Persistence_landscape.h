@@ -15,6 +15,10 @@
 #include <gudhi/read_persistence_from_file.h>
 #include <gudhi/common_persistence_representations.h>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 // standard include
 #include <cmath>
 #include <iostream>
@@ -26,6 +30,8 @@
 #include <string>
 #include <utility>
 #include <functional>
+#include <iterator>
+#include <cstddef>
 
 namespace Gudhi {
 namespace Persistence_representations {
@@ -170,16 +176,16 @@ class Persistence_landscape {
   /**
    * Operator +=. The second parameter is persistence landscape.
   **/
-  Persistence_landscape operator+=(const Persistence_landscape& rhs) {
-    *this = *this + rhs;
+  Persistence_landscape& operator+=(const Persistence_landscape& rhs) {
+    this->operation_in_place<std::plus<double> >(rhs);
     return *this;
   }
 
   /**
    * Operator -=. The second parameter is a persistence landscape.
   **/
-  Persistence_landscape operator-=(const Persistence_landscape& rhs) {
-    *this = *this - rhs;
+  Persistence_landscape& operator-=(const Persistence_landscape& rhs) {
+    this->operation_in_place<std::minus<double> >(rhs);
     return *this;
   }
 
@@ -187,17 +193,17 @@ class Persistence_landscape {
    * Operator *=. The second parameter is a real number by which the y values of all landscape functions are multiplied.
    *The x-values remain unchanged.
   **/
-  Persistence_landscape operator*=(double x) {
-    *this = *this * x;
+  Persistence_landscape& operator*=(double x) {
+    this->multiply_lanscape_by_real_number_overwrite(x);
     return *this;
   }
 
   /**
    * Operator /=. The second parameter is a real number.
   **/
-  Persistence_landscape operator/=(double x) {
+  Persistence_landscape& operator/=(double x) {
     if (x == 0) throw("In operator /=, division by 0. Program terminated.");
-    *this = *this * (1 / x);
+    this->multiply_lanscape_by_real_number_overwrite(1 / x);
     return *this;
   }
 
@@ -340,54 +346,31 @@ class Persistence_landscape {
    * This function is required by Topological_data_with_averages concept.
   **/
   void compute_average(const std::vector<Persistence_landscape*>& to_average) {
-    bool dbg = false;
-
-    if (dbg) {
-      std::clog << "to_average.size() : " << to_average.size() << std::endl;
+    if (to_average.empty()) {
+      this->land.clear();
+      return;
     }
-
-    std::vector<Persistence_landscape*> nextLevelMerge(to_average.size());
-    for (size_t i = 0; i != to_average.size(); ++i) {
-      nextLevelMerge[i] = to_average[i];
-    }
-    bool is_this_first_level = true;  // in the loop, we will create dynamically a number of intermediate complexes. We
-                                      // have to clean that up, but we cannot erase the initial landscapes we have
-    // to average. In this case, we simply check if the nextLevelMerge are the input landscapes or the ones created in
-    // that loop by using this extra variable.
-
-    while (nextLevelMerge.size() != 1) {
-      if (dbg) {
-        std::clog << "nextLevelMerge.size() : " << nextLevelMerge.size() << std::endl;
+    // The landscapes are summed pairwise, so that the intermediate landscapes stay small.
+    std::vector<Persistence_landscape> merged;
+    merged.reserve((to_average.size() + 1) / 2);
+    for (size_t i = 0; i < to_average.size(); i = i + 2) {
+      if (i + 1 != to_average.size()) {
+        merged.push_back((*to_average[i]) + (*to_average[i + 1]));
+      } else {
+        merged.push_back(*to_average[i]);
       }
-      std::vector<Persistence_landscape*> nextNextLevelMerge;
-      nextNextLevelMerge.reserve(to_average.size());
-      for (size_t i = 0; i < nextLevelMerge.size(); i = i + 2) {
-        if (dbg) {
-          std::clog << "i : " << i << std::endl;
-        }
-        Persistence_landscape* l = new Persistence_landscape;
-        if (i + 1 != nextLevelMerge.size()) {
-          (*l) = (*nextLevelMerge[i]) + (*nextLevelMerge[i + 1]);
+    }
+    while (merged.size() != 1) {
+      for (size_t i = 0; i < merged.size(); i = i + 2) {
+        if (i + 1 != merged.size()) {
+          merged[i / 2] = merged[i] + merged[i + 1];
         } else {
-          (*l) = *nextLevelMerge[i];
+          merged[i / 2] = std::move(merged[i]);
         }
-        nextNextLevelMerge.push_back(l);
       }
-      if (dbg) {
-        std::clog << "After this iteration \n";
-        getchar();
-      }
-
-      if (!is_this_first_level) {
-        // deallocate the memory if the vector nextLevelMerge do not consist of the initial landscapes
-        for (size_t i = 0; i != nextLevelMerge.size(); ++i) {
-          delete nextLevelMerge[i];
-        }
-      }
-      is_this_first_level = false;
-      nextLevelMerge.swap(nextNextLevelMerge);
+      merged.resize((merged.size() + 1) / 2);
     }
-    (*this) = (*nextLevelMerge[0]);
+    (*this) = std::move(merged[0]);
     (*this) *= 1 / static_cast<double>(to_average.size());
   }
 
@@ -439,7 +422,88 @@ class Persistence_landscape {
             int to = std::numeric_limits<int>::max());
 
  protected:
-  std::vector<std::vector<std::pair<double, double> > > land;
+  /**
+   * \private Storage of the levels of a landscape. The points of all the levels are stored contiguously, level i
+   * being made of the points between offsets_[i] and offsets_[i+1]. Levels are appended, either from a vector of
+   * points or point by point, and accessed through lightweight views.
+  **/
+  class Levels {
+   public:
+    typedef std::pair<double, double> Point;
+
+    template <typename Pointer>
+    class Basic_level {
+     public:
+      Basic_level(Pointer first, size_t size) : first_(first), size_(size) {}
+      size_t size() const { return size_; }
+      typename std::iterator_traits<Pointer>::reference operator[](size_t i) const { return first_[i]; }
+      Pointer begin() const { return first_; }
+      Pointer end() const { return first_ + size_; }
+
+     private:
+      Pointer first_;
+      size_t size_;
+    };
+    typedef Basic_level<Point*> Level;
+    typedef Basic_level<const Point*> Const_level;
+
+    Levels() : offsets_(1, 0) {}
+
+    size_t size() const { return offsets_.size() - 1; }
+    Level operator[](size_t level) {
+      return Level(points_.data() + offsets_[level], offsets_[level + 1] - offsets_[level]);
+    }
+    Const_level operator[](size_t level) const {
+      return Const_level(points_.data() + offsets_[level], offsets_[level + 1] - offsets_[level]);
+    }
+    size_t number_of_points() const { return points_.size(); }
+
+    void clear() {
+      points_.clear();
+      offsets_.assign(1, 0);
+    }
+    void reserve(size_t number_of_points, size_t number_of_levels) {
+      points_.reserve(number_of_points);
+      offsets_.reserve(number_of_levels + 1);
+    }
+    void swap(Levels& other) {
+      points_.swap(other.points_);
+      offsets_.swap(other.offsets_);
+    }
+
+    // Appends a whole level.
+    void push_back(const std::vector<Point>& level) {
+      points_.insert(points_.end(), level.begin(), level.end());
+      offsets_.push_back(points_.size());
+    }
+    // Appends a point to the level being built, which is closed by close_level().
+    void add_point(const Point& point) { points_.push_back(point); }
+    void close_level() { offsets_.push_back(points_.size()); }
+
+    // Gives the levels the new sizes, which are not smaller than the old ones (levels may be added at the end). The
+    // levels are then rewritten, from the last one to the first one, by update(i, old_level, new_level). As no level
+    // shrinks, new_level only overlaps the old points of the levels i and above, so old_level is still intact when
+    // update is called, and so are the levels below i.
+    template <typename Update>
+    void grow_levels(const std::vector<size_t>& sizes, Update update) {
+      std::vector<size_t> old_offsets(sizes.size() + 1);
+      old_offsets.swap(offsets_);
+      for (size_t i = 0; i != sizes.size(); ++i) offsets_[i + 1] = offsets_[i] + sizes[i];
+      points_.resize(offsets_.back());
+      for (size_t i = sizes.size(); i-- != 0;) {
+        Const_level old_level(points_.data(), 0);
+        if (i + 1 < old_offsets.size())
+          old_level = Const_level(points_.data() + old_offsets[i], old_offsets[i + 1] - old_offsets[i]);
+        update(i, old_level, (*this)[i]);
+      }
+    }
+
+   private:
+    std::vector<Point> points_;
+    std::vector<size_t> offsets_;
+  };
+
+  Levels land;
   size_t number_of_functions_for_vectorization;
   size_t number_of_functions_for_projections_to_reals;
 
@@ -455,6 +519,22 @@ class Persistence_landscape {
     this->number_of_functions_for_vectorization = this->land.size();
     this->number_of_functions_for_projections_to_reals = this->land.size();
   }
+
+  // Helpers working on a single level (a view on the storage, or a vector of points used as a buffer).
+  template <typename Level>
+  static double compute_integral_of_a_level(const Level& level);
+  template <typename Level>
+  static double compute_integral_of_a_level(const Level& level, double p);
+  template <typename Level>
+  static void compute_abs_of_a_level(const Level& level, std::vector<std::pair<double, double> >& result);
+  template <typename operation>
+  static void operation_on_pair_of_levels(typename Levels::Const_level level1, typename Levels::Const_level level2,
+                                          std::vector<std::pair<double, double> >& result);
+  static size_t size_of_operation_on_pair_of_levels(typename Levels::Const_level level1,
+                                                    typename Levels::Const_level level2);
+  // Computes (*this) = operation(*this, rhs) in the storage of this landscape.
+  template <typename operation>
+  void operation_in_place(const Persistence_landscape& rhs);
 };
 
 Persistence_landscape::Persistence_landscape(const char* filename, size_t dimension, size_t number_of_levels) {
@@ -529,7 +609,9 @@ void Persistence_landscape::construct_persistence_landscape_from_barcode(
     characteristicPoints[i] =
         std::make_pair((bars[i].first + bars[i].second) / 2.0, (bars[i].second - bars[i].first) / 2.0);
   }
-  std::vector<std::vector<std::pair<double, double> > > Persistence_landscape;
+  // The buffers are reused from one level to the next, and each level is then appended to the flat storage.
+  std::vector<std::pair<double, double> > lambda_n;
+  std::vector<std::pair<double, double> > newCharacteristicPoints;
   size_t number_of_levels_in_the_landscape = 0;
   while (!characteristicPoints.empty()) {
     if (dbg) {
@@ -539,7 +621,7 @@ void Persistence_landscape::construct_persistence_landscape_from_barcode(
       std::cin.ignore();
     }
 
-    std::vector<std::pair<double, double> > lambda_n;
+    lambda_n.clear();
     lambda_n.push_back(std::make_pair(-std::numeric_limits<int>::max(), 0));
     lambda_n.push_back(std::make_pair(minus_length(characteristicPoints[0]), 0));
     lambda_n.push_back(characteristicPoints[0]);
@@ -551,7 +633,7 @@ void Persistence_landscape::construct_persistence_landscape_from_barcode(
     }
 
     size_t i = 1;
-    std::vector<std::pair<double, double> > newCharacteristicPoints;
+    newCharacteristicPoints.clear();
     while (i < characteristicPoints.size()) {
       size_t p = 1;
       if ((minus_length(characteristicPoints[i]) >= minus_length(lambda_n[lambda_n.size() - 1])) &&
@@ -635,7 +717,7 @@ void Persistence_landscape::construct_persistence_landscape_from_barcode(
     lambda_n.push_back(std::make_pair(birth_plus_deaths(lambda_n[lambda_n.size() - 1]), 0));
     lambda_n.push_back(std::make_pair(std::numeric_limits<int>::max(), 0));
 
-    characteristicPoints = newCharacteristicPoints;
+    characteristicPoints.swap(newCharacteristicPoints);
 
     lambda_n.erase(std::unique(lambda_n.begin(), lambda_n.end()), lambda_n.end());
     this->land.push_back(lambda_n);
@@ -657,67 +739,62 @@ double Persistence_landscape::find_max(unsigned lambda) const {
   return maximum;
 }
 
+template <typename Level>
+double Persistence_landscape::compute_integral_of_a_level(const Level& level) {
+  double result = 0;
+  for (size_t nr = 2; nr + 1 < level.size(); ++nr) {
+    // it suffices to compute every planar integral and then sum them up for each lambda_n
+    result += 0.5 * (level[nr].first - level[nr - 1].first) * (level[nr].second + level[nr - 1].second);
+  }
+  return result;
+}
+
+template <typename Level>
+double Persistence_landscape::compute_integral_of_a_level(const Level& level, double p) {
+  double result = 0;
+  for (size_t nr = 2; nr + 1 < level.size(); ++nr) {
+    // In this interval, the landscape has a form f(x) = ax+b. We want to compute integral of (ax+b)^p = 1/a *
+    // (ax+b)^{p+1}/(p+1)
+    const std::pair<double, double>& current = level[nr];
+    const std::pair<double, double>& previous = level[nr - 1];
+    if (current.first == previous.first) continue;
+    std::pair<double, double> coef = compute_parameters_of_a_line(current, previous);
+    double a = coef.first;
+    double b = coef.second;
+    if (a != 0) {
+      result += 1 / (a * (p + 1)) * (pow((a * current.first + b), p + 1) - pow((a * previous.first + b), p + 1));
+    } else {
+      result += (current.first - previous.first) * (pow(current.second, p));
+    }
+  }
+  return result;
+}
+
 double Persistence_landscape::compute_integral_of_landscape() const {
   double result = 0;
   for (size_t i = 0; i != this->land.size(); ++i) {
-    for (size_t nr = 2; nr != this->land[i].size() - 1; ++nr) {
-      // it suffices to compute every planar integral and then sum them up for each lambda_n
-      result += 0.5 * (this->land[i][nr].first - this->land[i][nr - 1].first) *
-                (this->land[i][nr].second + this->land[i][nr - 1].second);
-    }
+    result += compute_integral_of_a_level(this->land[i]);
   }
   return result;
 }
 
 double Persistence_landscape::compute_integral_of_a_level_of_a_landscape(size_t level) const {
-  double result = 0;
   if (level >= this->land.size()) {
     // this landscape function is constantly equal 0, so is the integral.
-    return result;
-  }
-  // also negative landscapes are assumed to be zero.
-  if (level < 0) return 0;
-
-  for (size_t nr = 2; nr != this->land[level].size() - 1; ++nr) {
-    // it suffices to compute every planar integral and then sum them up for each lambda_n
-    result += 0.5 * (this->land[level][nr].first - this->land[level][nr - 1].first) *
-              (this->land[level][nr].second + this->land[level][nr - 1].second);
+    return 0;
   }
-
-  return result;
+  return compute_integral_of_a_level(this->land[level]);
 }
 
 double Persistence_landscape::compute_integral_of_landscape(double p) const {
-  bool dbg = false;
   double result = 0;
   for (size_t i = 0; i != this->land.size(); ++i) {
-    for (size_t nr = 2; nr != this->land[i].size() - 1; ++nr) {
-      if (dbg) std::clog << "nr : " << nr << "\n";
-      // In this interval, the landscape has a form f(x) = ax+b. We want to compute integral of (ax+b)^p = 1/a *
-      // (ax+b)^{p+1}/(p+1)
-      std::pair<double, double> coef = compute_parameters_of_a_line(this->land[i][nr], this->land[i][nr - 1]);
-      double a = coef.first;
-      double b = coef.second;
-
-      if (dbg)
-        std::clog << "(" << this->land[i][nr].first << "," << this->land[i][nr].second << ") , "
-                  << this->land[i][nr - 1].first << "," << this->land[i][nr].second << ")" << std::endl;
-      if (this->land[i][nr].first == this->land[i][nr - 1].first) continue;
-      if (a != 0) {
-        result += 1 / (a * (p + 1)) *
-                  (pow((a * this->land[i][nr].first + b), p + 1) - pow((a * this->land[i][nr - 1].first + b), p + 1));
-      } else {
-        result += (this->land[i][nr].first - this->land[i][nr - 1].first) * (pow(this->land[i][nr].second, p));
-      }
-      if (dbg) {
-        std::clog << "a : " << a << " , b : " << b << std::endl;
-        std::clog << "result : " << result << std::endl;
-      }
-    }
+    result += compute_integral_of_a_level(this->land[i], p);
   }
   return result;
 }
 
+
 // this is O(log(n)) algorithm, where n is number of points in this->land.
 double Persistence_landscape::compute_value_at_a_given_point(unsigned level, double x) const {
   bool compute_value_at_a_given_pointDbg = false;
@@ -805,102 +882,39 @@ void Persistence_landscape::multiply_lanscape_by_real_number_overwrite(double x)
   }
 }
 
-bool AbsDbg = false;
-Persistence_landscape Persistence_landscape::abs() {
-  Persistence_landscape result;
-  for (size_t level = 0; level != this->land.size(); ++level) {
-    if (AbsDbg) {
-      std::clog << "level: " << level << std::endl;
-    }
-    std::vector<std::pair<double, double> > lambda_n;
-    lambda_n.push_back(std::make_pair(-std::numeric_limits<int>::max(), 0));
-    for (size_t i = 1; i != this->land[level].size(); ++i) {
-      if (AbsDbg) {
-        std::clog << "this->land[" << level << "][" << i << "] : " << this->land[level][i].first << " "
-                  << this->land[level][i].second << std::endl;
-      }
-      // if a line segment between this->land[level][i-1] and this->land[level][i] crosses the x-axis, then we have to
-      // add one landscape point t o result
-      if ((this->land[level][i - 1].second) * (this->land[level][i].second) < 0) {
-        double zero =
-            find_zero_of_a_line_segment_between_those_two_points(this->land[level][i - 1], this->land[level][i]);
-
-        lambda_n.push_back(std::make_pair(zero, 0));
-        lambda_n.push_back(std::make_pair(this->land[level][i].first, fabs(this->land[level][i].second)));
-        if (AbsDbg) {
-          std::clog << "Adding pair : (" << zero << ",0)" << std::endl;
-          std::clog << "In the same step adding pair : (" << this->land[level][i].first << ","
-                    << fabs(this->land[level][i].second) << ") " << std::endl;
-          std::cin.ignore();
-        }
-      } else {
-        lambda_n.push_back(std::make_pair(this->land[level][i].first, fabs(this->land[level][i].second)));
-        if (AbsDbg) {
-          std::clog << "Adding pair : (" << this->land[level][i].first << "," << fabs(this->land[level][i].second)
-                    << ") " << std::endl;
-          std::cin.ignore();
-        }
-      }
+template <typename Level>
+void Persistence_landscape::compute_abs_of_a_level(const Level& level,
+                                                   std::vector<std::pair<double, double> >& result) {
+  result.clear();
+  result.push_back(std::make_pair(-std::numeric_limits<int>::max(), 0));
+  for (size_t i = 1; i < level.size(); ++i) {
+    // if a line segment between level[i-1] and level[i] crosses the x-axis, then we have to add one landscape point
+    // to result
+    if ((level[i - 1].second) * (level[i].second) < 0) {
+      double zero = find_zero_of_a_line_segment_between_those_two_points(level[i - 1], level[i]);
+      result.push_back(std::make_pair(zero, 0));
     }
-    result.land.push_back(lambda_n);
+    result.push_back(std::make_pair(level[i].first, fabs(level[i].second)));
   }
-  return result;
 }
 
-Persistence_landscape* Persistence_landscape::new_abs() {
-  Persistence_landscape* result = new Persistence_landscape(*this);
+Persistence_landscape Persistence_landscape::abs() {
+  Persistence_landscape result;
+  result.land.reserve(this->land.number_of_points(), this->land.size());
+  std::vector<std::pair<double, double> > lambda_n;
   for (size_t level = 0; level != this->land.size(); ++level) {
-    if (AbsDbg) {
-      std::clog << "level: " << level << std::endl;
-    }
-    std::vector<std::pair<double, double> > lambda_n;
-    lambda_n.push_back(std::make_pair(-std::numeric_limits<int>::max(), 0));
-    for (size_t i = 1; i != this->land[level].size(); ++i) {
-      if (AbsDbg) {
-        std::clog << "this->land[" << level << "][" << i << "] : " << this->land[level][i].first << " "
-                  << this->land[level][i].second << std::endl;
-      }
-      // if a line segment between this->land[level][i-1] and this->land[level][i] crosses the x-axis, then we have to
-      // add one landscape point t o result
-      if ((this->land[level][i - 1].second) * (this->land[level][i].second) < 0) {
-        double zero =
-            find_zero_of_a_line_segment_between_those_two_points(this->land[level][i - 1], this->land[level][i]);
-
-        lambda_n.push_back(std::make_pair(zero, 0));
-        lambda_n.push_back(std::make_pair(this->land[level][i].first, fabs(this->land[level][i].second)));
-        if (AbsDbg) {
-          std::clog << "Adding pair : (" << zero << ",0)" << std::endl;
-          std::clog << "In the same step adding pair : (" << this->land[level][i].first << ","
-                    << fabs(this->land[level][i].second) << ") " << std::endl;
-          std::cin.ignore();
-        }
-      } else {
-        lambda_n.push_back(std::make_pair(this->land[level][i].first, fabs(this->land[level][i].second)));
-        if (AbsDbg) {
-          std::clog << "Adding pair : (" << this->land[level][i].first << "," << fabs(this->land[level][i].second)
-                    << ") " << std::endl;
-          std::cin.ignore();
-        }
-      }
-    }
-    result->land.push_back(lambda_n);
+    compute_abs_of_a_level(this->land[level], lambda_n);
+    result.land.push_back(lambda_n);
   }
   return result;
 }
 
+Persistence_landscape* Persistence_landscape::new_abs() { return new Persistence_landscape(this->abs()); }
+
 Persistence_landscape Persistence_landscape::multiply_lanscape_by_real_number_not_overwrite(double x) const {
-  std::vector<std::vector<std::pair<double, double> > > result(this->land.size());
-  for (size_t dim = 0; dim != this->land.size(); ++dim) {
-    std::vector<std::pair<double, double> > lambda_dim(this->land[dim].size());
-    for (size_t i = 0; i != this->land[dim].size(); ++i) {
-      lambda_dim[i] = std::make_pair(this->land[dim][i].first, x * this->land[dim][i].second);
-    }
-    result[dim] = lambda_dim;
-  }
   Persistence_landscape res;
-  // CHANGE
-  // res.land = result;
-  res.land.swap(result);
+  res.land = this->land;
+  res.multiply_lanscape_by_real_number_overwrite(x);
   return res;
 }  // multiply_lanscape_by_real_number_overwrite
 
@@ -971,139 +985,121 @@ void Persistence_landscape::load_landscape_from_file(const char* filename) {
 }
 
 template <typename T>
-Persistence_landscape operation_on_pair_of_landscapes(const Persistence_landscape& land1,
-                                                      const Persistence_landscape& land2) {
-  bool operation_on_pair_of_landscapesDBG = false;
-  if (operation_on_pair_of_landscapesDBG) {
-    std::clog << "operation_on_pair_of_landscapes\n";
-    std::cin.ignore();
-  }
-  Persistence_landscape result;
-  std::vector<std::vector<std::pair<double, double> > > land(std::max(land1.land.size(), land2.land.size()));
-  result.land = land;
+void Persistence_landscape::operation_on_pair_of_levels(typename Levels::Const_level level1,
+                                                        typename Levels::Const_level level2,
+                                                        std::vector<std::pair<double, double> >& lambda_n) {
   T oper;
-
-  if (operation_on_pair_of_landscapesDBG) {
-    for (size_t i = 0; i != std::min(land1.land.size(), land2.land.size()); ++i) {
-      std::clog << "land1.land[" << i << "].size() : " << land1.land[i].size() << std::endl;
-      std::clog << "land2.land[" << i << "].size() : " << land2.land[i].size() << std::endl;
+  lambda_n.clear();
+  size_t p = 0;
+  size_t q = 0;
+  while ((p + 1 < level1.size()) && (q + 1 < level2.size())) {
+    if (level1[p].first < level2[q].first) {
+      lambda_n.push_back(std::make_pair(
+          level1[p].first,
+          oper(static_cast<double>(level1[p].second), function_value(level2[q - 1], level2[q], level1[p].first))));
+      ++p;
+      continue;
     }
-    getchar();
-  }
-
-  for (size_t i = 0; i != std::min(land1.land.size(), land2.land.size()); ++i) {
-    std::vector<std::pair<double, double> > lambda_n;
-    size_t p = 0;
-    size_t q = 0;
-    while ((p + 1 < land1.land[i].size()) && (q + 1 < land2.land[i].size())) {
-      if (operation_on_pair_of_landscapesDBG) {
-        std::clog << "p : " << p << "\n";
-        std::clog << "q : " << q << "\n";
-        std::clog << "land1.land.size() : " << land1.land.size() << std::endl;
-        std::clog << "land2.land.size() : " << land2.land.size() << std::endl;
-        std::clog << "land1.land[" << i << "].size() : " << land1.land[i].size() << std::endl;
-        std::clog << "land2.land[" << i << "].size() : " << land2.land[i].size() << std::endl;
-        std::clog << "land1.land[i][p].first : " << land1.land[i][p].first << "\n";
-        std::clog << "land2.land[i][q].first : " << land2.land[i][q].first << "\n";
-      }
-
-      if (land1.land[i][p].first < land2.land[i][q].first) {
-        if (operation_on_pair_of_landscapesDBG) {
-          std::clog << "first \n";
-          std::clog << " function_value(land2.land[i][q-1],land2.land[i][q],land1.land[i][p].first) : "
-                    << function_value(land2.land[i][q - 1], land2.land[i][q], land1.land[i][p].first) << "\n";
-        }
-        lambda_n.push_back(
-            std::make_pair(land1.land[i][p].first,
-                           oper(static_cast<double>(land1.land[i][p].second),
-                                function_value(land2.land[i][q - 1], land2.land[i][q], land1.land[i][p].first))));
-        ++p;
-        continue;
-      }
-      if (land1.land[i][p].first > land2.land[i][q].first) {
-        if (operation_on_pair_of_landscapesDBG) {
-          std::clog << "Second \n";
-          std::clog << "function_value(" << land1.land[i][p - 1].first << " " << land1.land[i][p - 1].second << " ,"
-                    << land1.land[i][p].first << " " << land1.land[i][p].second << ", " << land2.land[i][q].first
-                    << " ) : " << function_value(land1.land[i][p - 1], land1.land[i][p - 1], land2.land[i][q].first)
-                    << "\n";
-          std::clog << "oper( " << function_value(land1.land[i][p], land1.land[i][p - 1], land2.land[i][q].first) << ","
-                    << land2.land[i][q].second << " : "
-                    << oper(land2.land[i][q].second,
-                            function_value(land1.land[i][p], land1.land[i][p - 1], land2.land[i][q].first))
-                    << "\n";
-        }
-        lambda_n.push_back(std::make_pair(
-            land2.land[i][q].first, oper(function_value(land1.land[i][p], land1.land[i][p - 1], land2.land[i][q].first),
-                                         land2.land[i][q].second)));
-        ++q;
-        continue;
-      }
-      if (land1.land[i][p].first == land2.land[i][q].first) {
-        if (operation_on_pair_of_landscapesDBG) std::clog << "Third \n";
-        lambda_n.push_back(
-            std::make_pair(land2.land[i][q].first, oper(land1.land[i][p].second, land2.land[i][q].second)));
-        ++p;
-        ++q;
-      }
-      if (operation_on_pair_of_landscapesDBG) {
-        std::clog << "Next iteration \n";
-      }
+    if (level1[p].first > level2[q].first) {
+      lambda_n.push_back(std::make_pair(
+          level2[q].first, oper(function_value(level1[p], level1[p - 1], level2[q].first), level2[q].second)));
+      ++q;
+      continue;
     }
-    while ((p + 1 < land1.land[i].size()) && (q + 1 >= land2.land[i].size())) {
-      if (operation_on_pair_of_landscapesDBG) {
-        std::clog << "New point : " << land1.land[i][p].first
-                  << "  oper(land1.land[i][p].second,0) : " << oper(land1.land[i][p].second, 0) << std::endl;
-      }
-      lambda_n.push_back(std::make_pair(land1.land[i][p].first, oper(land1.land[i][p].second, 0)));
+    if (level1[p].first == level2[q].first) {
+      lambda_n.push_back(std::make_pair(level2[q].first, oper(level1[p].second, level2[q].second)));
       ++p;
-    }
-    while ((p + 1 >= land1.land[i].size()) && (q + 1 < land2.land[i].size())) {
-      if (operation_on_pair_of_landscapesDBG) {
-        std::clog << "New point : " << land2.land[i][q].first
-                  << " oper(0,land2.land[i][q].second) : " << oper(0, land2.land[i][q].second) << std::endl;
-      }
-      lambda_n.push_back(std::make_pair(land2.land[i][q].first, oper(0, land2.land[i][q].second)));
       ++q;
     }
-    lambda_n.push_back(std::make_pair(std::numeric_limits<int>::max(), 0));
-    // CHANGE
-    // result.land[i] = lambda_n;
-    result.land[i].swap(lambda_n);
   }
-  if (land1.land.size() > std::min(land1.land.size(), land2.land.size())) {
-    if (operation_on_pair_of_landscapesDBG) {
-      std::clog << "land1.land.size() > std::min( land1.land.size() , land2.land.size() )" << std::endl;
-    }
-    for (size_t i = std::min(land1.land.size(), land2.land.size()); i != std::max(land1.land.size(), land2.land.size());
-         ++i) {
-      std::vector<std::pair<double, double> > lambda_n(land1.land[i]);
-      for (size_t nr = 0; nr != land1.land[i].size(); ++nr) {
-        lambda_n[nr] = std::make_pair(land1.land[i][nr].first, oper(land1.land[i][nr].second, 0));
-      }
-      // CHANGE
-      // result.land[i] = lambda_n;
-      result.land[i].swap(lambda_n);
-    }
+  while ((p + 1 < level1.size()) && (q + 1 >= level2.size())) {
+    lambda_n.push_back(std::make_pair(level1[p].first, oper(level1[p].second, 0)));
+    ++p;
+  }
+  while ((p + 1 >= level1.size()) && (q + 1 < level2.size())) {
+    lambda_n.push_back(std::make_pair(level2[q].first, oper(0, level2[q].second)));
+    ++q;
   }
-  if (land2.land.size() > std::min(land1.land.size(), land2.land.size())) {
-    if (operation_on_pair_of_landscapesDBG) {
-      std::clog << "( land2.land.size() > std::min( land1.land.size() , land2.land.size() ) ) " << std::endl;
+  lambda_n.push_back(std::make_pair(std::numeric_limits<int>::max(), 0));
+}
+
+// The number of points written by operation_on_pair_of_levels.
+inline size_t Persistence_landscape::size_of_operation_on_pair_of_levels(typename Levels::Const_level level1,
+                                                                         typename Levels::Const_level level2) {
+  size_t p = 0;
+  size_t q = 0;
+  size_t size = 1;
+  while ((p + 1 < level1.size()) && (q + 1 < level2.size())) {
+    double x1 = level1[p].first;
+    double x2 = level2[q].first;
+    if (x1 <= x2) ++p;
+    if (x2 <= x1) ++q;
+    ++size;
+  }
+  if (p + 1 < level1.size()) size += level1.size() - 1 - p;
+  if (q + 1 < level2.size()) size += level2.size() - 1 - q;
+  return size;
+}
+
+template <typename T>
+void Persistence_landscape::operation_in_place(const Persistence_landscape& rhs) {
+  if (&rhs == this) {
+    Persistence_landscape copy(rhs);
+    this->operation_in_place<T>(copy);
+    return;
+  }
+  T oper;
+  const Levels& levels = this->land;
+  const size_t common_levels = std::min(levels.size(), rhs.land.size());
+  std::vector<size_t> sizes(std::max(levels.size(), rhs.land.size()));
+  for (size_t i = 0; i != sizes.size(); ++i) {
+    if (i < common_levels) {
+      sizes[i] = size_of_operation_on_pair_of_levels(levels[i], rhs.land[i]);
+    } else {
+      sizes[i] = i < levels.size() ? levels[i].size() : rhs.land[i].size();
     }
-    for (size_t i = std::min(land1.land.size(), land2.land.size()); i != std::max(land1.land.size(), land2.land.size());
-         ++i) {
-      std::vector<std::pair<double, double> > lambda_n(land2.land[i]);
-      for (size_t nr = 0; nr != land2.land[i].size(); ++nr) {
-        lambda_n[nr] = std::make_pair(land2.land[i][nr].first, oper(0, land2.land[i][nr].second));
-      }
-      // CHANGE
-      // result.land[i] = lambda_n;
-      result.land[i].swap(lambda_n);
+  }
+
+  // A common level is merged in a buffer, reused from one level to the next, before being written over its old
+  // points. The other levels are moved backward, as they do not move to lower positions.
+  std::vector<std::pair<double, double> > lambda_n;
+  const size_t old_levels = this->land.size();
+  this->land.grow_levels(sizes, [&](size_t i, typename Levels::Const_level old_level, typename Levels::Level level) {
+    if (i < common_levels) {
+      operation_on_pair_of_levels<T>(old_level, rhs.land[i], lambda_n);
+      std::copy(lambda_n.begin(), lambda_n.end(), level.begin());
+    } else if (i < old_levels) {
+      for (size_t j = level.size(); j-- != 0;)
+        level[j] = std::make_pair(old_level[j].first, oper(old_level[j].second, 0));
+    } else {
+      for (size_t j = 0; j != level.size(); ++j)
+        level[j] = std::make_pair(rhs.land[i][j].first, oper(0, rhs.land[i][j].second));
     }
+  });
+}
+
+template <typename T>
+Persistence_landscape operation_on_pair_of_landscapes(const Persistence_landscape& land1,
+                                                      const Persistence_landscape& land2) {
+  Persistence_landscape result;
+  T oper;
+  const size_t common_levels = std::min(land1.land.size(), land2.land.size());
+  result.land.reserve(land1.land.number_of_points() + land2.land.number_of_points(),
+                      std::max(land1.land.size(), land2.land.size()));
+
+  // The levels are merged in a buffer reused from one level to the next.
+  std::vector<std::pair<double, double> > lambda_n;
+  for (size_t i = 0; i != common_levels; ++i) {
+    Persistence_landscape::operation_on_pair_of_levels<T>(land1.land[i], land2.land[i], lambda_n);
+    result.land.push_back(lambda_n);
   }
-  if (operation_on_pair_of_landscapesDBG) {
-    std::clog << "operation_on_pair_of_landscapes END\n";
-    std::cin.ignore();
+  for (size_t i = common_levels; i < land1.land.size(); ++i) {
+    for (auto const& point : land1.land[i]) result.land.add_point(std::make_pair(point.first, oper(point.second, 0)));
+    result.land.close_level();
+  }
+  for (size_t i = common_levels; i < land2.land.size(); ++i) {
+    for (auto const& point : land2.land[i]) result.land.add_point(std::make_pair(point.first, oper(0, point.second)));
+    result.land.close_level();
   }
   return result;
 }  // operation_on_pair_of_landscapes
@@ -1170,37 +1166,48 @@ double compute_maximal_distance_non_symmetric(const Persistence_landscape& pl1,
 
 double compute_distance_of_landscapes(const Persistence_landscape& first, const Persistence_landscape& second,
                                       double p) {
-  bool dbg = false;
-  // This is what we want to compute: (\int_{- \infty}^{+\infty}| first-second |^p)^(1/p). We will do it one step at a
-  // time:
-
-  // first-second :
-  Persistence_landscape lan = first - second;
-
-  //| first-second |:
-  lan = lan.abs();
-
-  if (dbg) {
-    std::clog << "Abs of difference ; " << lan << std::endl;
-    getchar();
-  }
+  // This is what we want to compute: (\int_{- \infty}^{+\infty}| first-second |^p)^(1/p). It is computed level by
+  // level, the difference of the two levels and its absolute value being stored in buffers reused for all the levels.
+  std::vector<std::pair<double, double> > difference;
+  std::vector<std::pair<double, double> > absolute_difference;
+  auto compute_level = [&](size_t level) {
+    if (level < first.land.size() && level < second.land.size()) {
+      Persistence_landscape::operation_on_pair_of_levels<std::minus<double> >(first.land[level], second.land[level],
+                                                                               difference);
+    } else {
+      difference.clear();
+      if (level < first.land.size()) {
+        for (auto const& point : first.land[level]) difference.push_back(point);
+      } else {
+        for (auto const& point : second.land[level]) difference.push_back(std::make_pair(point.first, -point.second));
+      }
+    }
+    Persistence_landscape::compute_abs_of_a_level(difference, absolute_difference);
+  };
+  const size_t number_of_levels = std::max(first.land.size(), second.land.size());
 
   if (p < std::numeric_limits<double>::max()) {
     // \int_{- \infty}^{+\infty}| first-second |^p
-    double result;
-    if (p != 1) {
-      if (dbg) std::clog << "Power != 1, compute integral to the power p\n";
-      result = lan.compute_integral_of_landscape(p);
-    } else {
-      if (dbg) std::clog << "Power = 1, compute integral \n";
-      result = lan.compute_integral_of_landscape();
+    double result = 0;
+    for (size_t level = 0; level != number_of_levels; ++level) {
+      compute_level(level);
+      if (p != 1) {
+        result += Persistence_landscape::compute_integral_of_a_level(absolute_difference, p);
+      } else {
+        result += Persistence_landscape::compute_integral_of_a_level(absolute_difference);
+      }
     }
     // (\int_{- \infty}^{+\infty}| first-second |^p)^(1/p)
     return pow(result, 1.0 / p);
   } else {
-    // p == infty
-    if (dbg) std::clog << "Power = infty, compute maximum \n";
-    return lan.compute_maximum();
+    // p == infty, the maximum of the first level
+    if (number_of_levels == 0) return 0;
+    compute_level(0);
+    double maxValue = -std::numeric_limits<int>::max();
+    for (auto const& point : absolute_difference) {
+      if (point.second > maxValue) maxValue = point.second;
+    }
+    return maxValue;
   }
 }
 
@@ -1365,6 +1372,29 @@ void Persistence_landscape::plot(const char* filename, double xRangeBegin, doubl
             << gnuplot_script.str().c_str() << "\'\"" << std::endl;
 }
 
+/**
+ * Constructs the persistence landscapes of a collection of persistence diagrams (given as vectors of birth-death
+ * pairs), in parallel when TBB is available. The i-th landscape is the one of diagrams[i], as given by the
+ * constructor Persistence_landscape(diagrams[i], number_of_levels).
+ *
+ * \ingroup Persistence_representations
+**/
+inline std::vector<Persistence_landscape> construct_persistence_landscapes(
+    const std::vector<std::vector<std::pair<double, double> > >& diagrams,
+    size_t number_of_levels = std::numeric_limits<size_t>::max()) {
+  std::vector<Persistence_landscape> landscapes(diagrams.size());
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(size_t(0), diagrams.size(), [&](size_t i) {
+    landscapes[i] = Persistence_landscape(diagrams[i], number_of_levels);
+  });
+#else
+  for (size_t i = 0; i != diagrams.size(); ++i) {
+    landscapes[i] = Persistence_landscape(diagrams[i], number_of_levels);
+  }
+#endif
+  return landscapes;
+}
+
 }  // namespace Persistence_representations
 }  // namespace Gudhi
 
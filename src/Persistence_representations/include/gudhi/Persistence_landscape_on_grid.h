@@ -15,6 +15,10 @@
 #include <gudhi/read_persistence_from_file.h>
 #include <gudhi/common_persistence_representations.h>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 // standard include
 #include <iostream>
 #include <vector>
@@ -49,6 +53,10 @@ Persistence_landscape_on_grid operation_on_pair_of_landscapes_on_grid(const Pers
  * It implements the following concepts: Vectorized_topological_data, Topological_data_with_distances,
  * Real_valued_topological_data, Topological_data_with_averages, Topological_data_with_scalar_product
  *
+ * The values of the landscapes are stored in a single array, grid point after grid point. At every grid point, the
+ * values of all the levels are sorted decreasingly and padded with zeros up to the number of levels of the landscape,
+ * so that distances, scalar products and averages are simple loops over contiguous memory.
+ *
  * Note that at the moment, due to rounding errors during the construction of persistence landscapes on a grid,
  * elements which are different by 0.000005 are considered the same. If the scale in your persistence diagrams
  * is comparable to this value, please rescale them before use this code.
@@ -62,6 +70,7 @@ class Persistence_landscape_on_grid {
    * Default constructor.
   **/
   Persistence_landscape_on_grid() {
+    this->number_of_grid_points = this->number_of_stored_levels = 0;
     this->set_up_numbers_of_functions_for_vectorization_and_projections_to_reals();
     this->grid_min = this->grid_max = 0;
   }
@@ -152,27 +161,24 @@ class Persistence_landscape_on_grid {
   double compute_integral_of_landscape(size_t level) const {
     bool dbg = false;
     double result = 0;
-    double dx = (this->grid_max - this->grid_min) / static_cast<double>(this->values_of_landscapes.size() - 1);
+    double dx = (this->grid_max - this->grid_min) / static_cast<double>(this->number_of_grid_points - 1);
 
     if (dbg) {
       std::clog << "this->grid_max : " << this->grid_max << std::endl;
       std::clog << "this->grid_min : " << this->grid_min << std::endl;
-      std::clog << "this->values_of_landscapes.size() : " << this->values_of_landscapes.size() << std::endl;
+      std::clog << "this->number_of_grid_points : " << this->number_of_grid_points << std::endl;
       getchar();
     }
 
     double previous_x = this->grid_min - dx;
     double previous_y = 0;
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
+    for (size_t i = 0; i != this->number_of_grid_points; ++i) {
       double current_x = previous_x + dx;
-      double current_y = 0;
-      if (this->values_of_landscapes[i].size() > level) current_y = this->values_of_landscapes[i][level];
+      double current_y = this->value(i, level);
 
       if (dbg) {
-        std::clog << "this->values_of_landscapes[i].size() : " << this->values_of_landscapes[i].size()
-                  << " , level : " << level << std::endl;
-        if (this->values_of_landscapes[i].size() > level)
-          std::clog << "this->values_of_landscapes[i][level] : " << this->values_of_landscapes[i][level] << std::endl;
+        std::clog << "this->number_of_stored_levels : " << this->number_of_stored_levels << " , level : " << level
+                  << std::endl;
         std::clog << "previous_y : " << previous_y << std::endl;
         std::clog << "current_y : " << current_y << std::endl;
         std::clog << "dx : " << dx << std::endl;
@@ -207,10 +213,9 @@ class Persistence_landscape_on_grid {
     bool dbg = false;
 
     double result = 0;
-    double dx = (this->grid_max - this->grid_min) / static_cast<double>(this->values_of_landscapes.size() - 1);
+    double dx = (this->grid_max - this->grid_min) / static_cast<double>(this->number_of_grid_points - 1);
     double previous_x = this->grid_min;
-    double previous_y = 0;
-    if (this->values_of_landscapes[0].size() > level) previous_y = this->values_of_landscapes[0][level];
+    double previous_y = this->value(0, level);
 
     if (dbg) {
       std::clog << "dx : " << dx << std::endl;
@@ -220,10 +225,9 @@ class Persistence_landscape_on_grid {
       getchar();
     }
 
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
+    for (size_t i = 0; i != this->number_of_grid_points; ++i) {
       double current_x = previous_x + dx;
-      double current_y = 0;
-      if (this->values_of_landscapes[i].size() > level) current_y = this->values_of_landscapes[i][level];
+      double current_y = this->value(i, level);
 
       if (dbg) std::clog << "current_y : " << current_y << std::endl;
 
@@ -266,12 +270,12 @@ class Persistence_landscape_on_grid {
 * Shall those points be joined with lines, we will obtain the i-th landscape function.
 **/
   friend std::ostream& operator<<(std::ostream& out, const Persistence_landscape_on_grid& land) {
-    double dx = (land.grid_max - land.grid_min) / static_cast<double>(land.values_of_landscapes.size() - 1);
+    double dx = (land.grid_max - land.grid_min) / static_cast<double>(land.number_of_grid_points - 1);
     double x = land.grid_min;
-    for (size_t i = 0; i != land.values_of_landscapes.size(); ++i) {
+    for (size_t i = 0; i != land.number_of_grid_points; ++i) {
       out << x << " : ";
-      for (size_t j = 0; j != land.values_of_landscapes[i].size(); ++j) {
-        out << land.values_of_landscapes[i][j] << " ";
+      for (size_t j = 0; j != land.number_of_nonzero_values(i); ++j) {
+        out << land.value(i, j) << " ";
       }
       out << std::endl;
       x += dx;
@@ -293,7 +297,7 @@ class Persistence_landscape_on_grid {
     if ((x < this->grid_min) || (x > this->grid_max)) return 0;
 
     // find a position of a vector closest to x:
-    double dx = (this->grid_max - this->grid_min) / static_cast<double>(this->values_of_landscapes.size() - 1);
+    double dx = (this->grid_max - this->grid_min) / static_cast<double>(this->number_of_grid_points - 1);
     size_t position = size_t((x - this->grid_min) / dx);
 
     if (dbg) {
@@ -304,35 +308,12 @@ class Persistence_landscape_on_grid {
     }
     // check if we are not exactly in the grid point:
     if (almost_equal(position * dx + this->grid_min, x)) {
-      if (this->values_of_landscapes[position].size() < level) {
-        return this->values_of_landscapes[position][level];
-      } else {
-        return 0;
-      }
+      return this->value(position, level);
     }
     // in the other case, approximate with a line:
-    std::pair<double, double> line;
-    if ((this->values_of_landscapes[position].size() > level) &&
-        (this->values_of_landscapes[position + 1].size() > level)) {
-      line = compute_parameters_of_a_line(
-          std::make_pair(position * dx + this->grid_min, this->values_of_landscapes[position][level]),
-          std::make_pair((position + 1) * dx + this->grid_min, this->values_of_landscapes[position + 1][level]));
-    } else {
-      if ((this->values_of_landscapes[position].size() > level) ||
-          (this->values_of_landscapes[position + 1].size() > level)) {
-        if ((this->values_of_landscapes[position].size() > level)) {
-          line = compute_parameters_of_a_line(
-              std::make_pair(position * dx + this->grid_min, this->values_of_landscapes[position][level]),
-              std::make_pair((position + 1) * dx + this->grid_min, 0));
-        } else {
-          line = compute_parameters_of_a_line(
-              std::make_pair(position * dx + this->grid_min, 0),
-              std::make_pair((position + 1) * dx + this->grid_min, this->values_of_landscapes[position + 1][level]));
-        }
-      } else {
-        return 0;
-      }
-    }
+    std::pair<double, double> line = compute_parameters_of_a_line(
+        std::make_pair(position * dx + this->grid_min, this->value(position, level)),
+        std::make_pair((position + 1) * dx + this->grid_min, this->value(position + 1, level)));
     // compute the value of the linear function parametrized by line on a point x:
     return line.first * x + line.second;
   }
@@ -386,7 +367,7 @@ class Persistence_landscape_on_grid {
 
   friend bool check_if_defined_on_the_same_domain(const Persistence_landscape_on_grid& land1,
                                                   const Persistence_landscape_on_grid& land2) {
-    if (land1.values_of_landscapes.size() != land2.values_of_landscapes.size()) return false;
+    if (land1.number_of_grid_points != land2.number_of_grid_points) return false;
     if (land1.grid_min != land2.grid_min) return false;
     if (land1.grid_max != land2.grid_max) return false;
     return true;
@@ -413,7 +394,7 @@ class Persistence_landscape_on_grid {
    *The x-values remain unchanged.
   **/
   Persistence_landscape_on_grid operator*=(double x) {
-    *this = *this * x;
+    for (double& value : this->values_of_landscapes) value *= x;
     return *this;
   }
 
@@ -422,7 +403,7 @@ class Persistence_landscape_on_grid {
   **/
   Persistence_landscape_on_grid operator/=(double x) {
     if (x == 0) throw("In operator /=, division by 0. Program terminated.");
-    *this = *this * (1 / x);
+    *this *= 1 / x;
     return *this;
   }
 
@@ -431,7 +412,7 @@ class Persistence_landscape_on_grid {
   **/
   bool operator==(const Persistence_landscape_on_grid& rhs) const {
     bool dbg = true;
-    if (this->values_of_landscapes.size() != rhs.values_of_landscapes.size()) {
+    if (this->number_of_grid_points != rhs.number_of_grid_points) {
       if (dbg) std::clog << "values_of_landscapes of incompatible sizes\n";
       return false;
     }
@@ -443,12 +424,13 @@ class Persistence_landscape_on_grid {
       if (dbg) std::clog << "grid_max not equal\n";
       return false;
     }
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-      for (size_t aa = 0; aa != this->values_of_landscapes[i].size(); ++aa) {
-        if (!almost_equal(this->values_of_landscapes[i][aa], rhs.values_of_landscapes[i][aa])) {
+    // only the nonzero values of *this are compared, the remaining values of rhs are ignored.
+    for (size_t i = 0; i != this->number_of_grid_points; ++i) {
+      for (size_t aa = 0; aa != this->number_of_nonzero_values(i); ++aa) {
+        if (!almost_equal(this->value(i, aa), rhs.value(i, aa))) {
           if (dbg) {
             std::clog << "Problem in the position : " << i << " of values_of_landscapes. \n";
-            std::clog << this->values_of_landscapes[i][aa] << " " << rhs.values_of_landscapes[i][aa] << std::endl;
+            std::clog << this->value(i, aa) << " " << rhs.value(i, aa) << std::endl;
           }
           return false;
         }
@@ -466,15 +448,9 @@ class Persistence_landscape_on_grid {
    * Computations of maximum (y) value of landscape.
   **/
   double compute_maximum() const {
-    // since the function can only be entirely positive or negative, the maximal value will be an extremal value in the
-    // arrays:
     double max_value = -std::numeric_limits<double>::max();
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-      if (this->values_of_landscapes[i].size()) {
-        if (this->values_of_landscapes[i][0] > max_value) max_value = this->values_of_landscapes[i][0];
-        if (this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1] > max_value)
-          max_value = this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1];
-      }
+    for (double value : this->values_of_landscapes) {
+      if (value > max_value) max_value = value;
     }
     return max_value;
   }
@@ -483,20 +459,11 @@ class Persistence_landscape_on_grid {
        * Computations of minimum and maximum value of landscape.
       **/
   std::pair<double, double> compute_minimum_maximum() const {
-    // since the function can only be entirely positive or negative, the maximal value will be an extremal value in the
-    // arrays:
     double max_value = -std::numeric_limits<double>::max();
     double min_value = 0;
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-      if (this->values_of_landscapes[i].size()) {
-        if (this->values_of_landscapes[i][0] > max_value) max_value = this->values_of_landscapes[i][0];
-        if (this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1] > max_value)
-          max_value = this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1];
-
-        if (this->values_of_landscapes[i][0] < min_value) min_value = this->values_of_landscapes[i][0];
-        if (this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1] < min_value)
-          min_value = this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1];
-      }
+    for (double value : this->values_of_landscapes) {
+      if (value > max_value) max_value = value;
+      if (value < min_value) min_value = value;
     }
     return std::make_pair(min_value, max_value);
   }
@@ -518,20 +485,14 @@ class Persistence_landscape_on_grid {
   /**
    * This function computes maximal lambda for which lambda-level landscape is nonzero.
   **/
-  size_t number_of_nonzero_levels() const {
-    size_t result = 0;
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-      if (this->values_of_landscapes[i].size() > result) result = this->values_of_landscapes[i].size();
-    }
-    return result;
-  }
+  size_t number_of_nonzero_levels() const { return this->number_of_stored_levels; }
 
   /**
    * Computations of a \f$L^i\f$ norm of landscape, where i is the input parameter.
   **/
   double compute_norm_of_landscape(double i) const {
     std::vector<std::pair<double, double> > p;
-    Persistence_landscape_on_grid l(p, this->grid_min, this->grid_max, this->values_of_landscapes.size() - 1);
+    Persistence_landscape_on_grid l(p, this->grid_min, this->grid_max, this->number_of_grid_points - 1);
 
     if (i < std::numeric_limits<double>::max()) {
       return compute_distance_of_landscapes_on_grid(*this, l, i);
@@ -558,11 +519,7 @@ class Persistence_landscape_on_grid {
    *distance, we need to take its absolute value. This is the purpose of this procedure.
   **/
   void abs() {
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-      for (size_t j = 0; j != this->values_of_landscapes[i].size(); ++j) {
-        this->values_of_landscapes[i][j] = std::abs(this->values_of_landscapes[i][j]);
-      }
-    }
+    for (double& value : this->values_of_landscapes) value = std::abs(value);
   }
 
   /**
@@ -575,10 +532,9 @@ class Persistence_landscape_on_grid {
   **/
   double find_max(unsigned lambda) const {
     double max_value = -std::numeric_limits<double>::max();
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-      if (this->values_of_landscapes[i].size() > lambda) {
-        if (this->values_of_landscapes[i][lambda] > max_value) max_value = this->values_of_landscapes[i][lambda];
-      }
+    if (lambda >= this->number_of_stored_levels) return max_value;
+    for (size_t i = 0; i != this->number_of_grid_points; ++i) {
+      if (this->value(i, lambda) > max_value) max_value = this->value(i, lambda);
     }
     return max_value;
   }
@@ -590,12 +546,7 @@ class Persistence_landscape_on_grid {
                                       const Persistence_landscape_on_grid& l2) {
     if (!check_if_defined_on_the_same_domain(l1, l2))
       throw "Landscapes are not defined on the same grid, the program will now terminate";
-    size_t maximal_level = l1.number_of_nonzero_levels();
-    double result = 0;
-    for (size_t i = 0; i != maximal_level; ++i) {
-      result += compute_inner_product(l1, l2, i);
-    }
-    return result;
+    return inner_product_of_levels(l1, l2);
   }
 
   /**
@@ -609,20 +560,17 @@ class Persistence_landscape_on_grid {
       throw "Landscapes are not defined on the same grid, the program will now terminate";
     double result = 0;
 
-    double dx = (l1.grid_max - l1.grid_min) / static_cast<double>(l1.values_of_landscapes.size() - 1);
+    double dx = (l1.grid_max - l1.grid_min) / static_cast<double>(l1.number_of_grid_points - 1);
 
     double previous_x = l1.grid_min - dx;
     double previous_y_l1 = 0;
     double previous_y_l2 = 0;
-    for (size_t i = 0; i != l1.values_of_landscapes.size(); ++i) {
+    for (size_t i = 0; i != l1.number_of_grid_points; ++i) {
       if (dbg) std::clog << "i : " << i << std::endl;
 
       double current_x = previous_x + dx;
-      double current_y_l1 = 0;
-      if (l1.values_of_landscapes[i].size() > level) current_y_l1 = l1.values_of_landscapes[i][level];
-
-      double current_y_l2 = 0;
-      if (l2.values_of_landscapes[i].size() > level) current_y_l2 = l2.values_of_landscapes[i][level];
+      double current_y_l1 = l1.value(i, level);
+      double current_y_l2 = l2.value(i, level);
 
       if (dbg) {
         std::clog << "previous_x  : " << previous_x << std::endl;
@@ -698,55 +646,14 @@ class Persistence_landscape_on_grid {
   **/
   friend double compute_distance_of_landscapes_on_grid(const Persistence_landscape_on_grid& first,
                                                        const Persistence_landscape_on_grid& second, double p) {
-    bool dbg = false;
-    // This is what we want to compute: (\int_{- \infty}^{+\infty}| first-second |^p)^(1/p). We will do it one step at a
-    // time:
-
-    if (dbg) {
-      std::clog << "first : " << first << std::endl;
-      std::clog << "second : " << second << std::endl;
-      getchar();
-    }
-
-    // first-second :
-    Persistence_landscape_on_grid lan = first - second;
-
-    if (dbg) {
-      std::clog << "Difference : " << lan << std::endl;
-    }
-
-    //| first-second |:
-    lan.abs();
-
-    if (dbg) {
-      std::clog << "Abs : " << lan << std::endl;
-    }
-
+    // This is what we want to compute: (\int_{- \infty}^{+\infty}| first-second |^p)^(1/p). The values of
+    // | first-second | are computed on the fly, grid point after grid point.
+    if (!check_if_defined_on_the_same_domain(first, second)) throw "Two grids are not compatible";
     if (p < std::numeric_limits<double>::max()) {
-      // \int_{- \infty}^{+\infty}| first-second |^p
-      double result;
-      if (p != 1) {
-        if (dbg) {
-          std::clog << "p : " << p << std::endl;
-          getchar();
-        }
-        result = lan.compute_integral_of_landscape(p);
-        if (dbg) {
-          std::clog << "integral : " << result << std::endl;
-          getchar();
-        }
-      } else {
-        result = lan.compute_integral_of_landscape();
-        if (dbg) {
-          std::clog << "integral, without power : " << result << std::endl;
-          getchar();
-        }
-      }
-      // (\int_{- \infty}^{+\infty}| first-second |^p)^(1/p)
-      return pow(result, 1.0 / p);
+      return pow(integral_of_difference(first, second, p), 1.0 / p);
     } else {
       // p == infty
-      return lan.compute_maximum();
+      return compute_max_norm_distance_of_landscapes(first, second);
     }
   }
 
@@ -776,15 +683,12 @@ class Persistence_landscape_on_grid {
   */
   std::vector<double> vectorize(int number_of_function) const {
     // TODO(PD) think of something smarter over here
-    if ((number_of_function < 0) || ((size_t)number_of_function >= this->values_of_landscapes.size())) {
+    if ((number_of_function < 0) || ((size_t)number_of_function >= this->number_of_grid_points)) {
       throw "Wrong number of function\n";
     }
-    std::vector<double> v(this->values_of_landscapes.size());
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-      v[i] = 0;
-      if (this->values_of_landscapes[i].size() > (size_t)number_of_function) {
-        v[i] = this->values_of_landscapes[i][number_of_function];
-      }
+    std::vector<double> v(this->number_of_grid_points);
+    for (size_t i = 0; i != this->number_of_grid_points; ++i) {
+      v[i] = this->value(i, number_of_function);
     }
     return v;
   }
@@ -804,6 +708,7 @@ class Persistence_landscape_on_grid {
     // After execution of this procedure, the average is supposed to be in the current object. To make sure that this is
     // the case, we need to do some cleaning first.
     this->values_of_landscapes.clear();
+    this->number_of_grid_points = this->number_of_stored_levels = 0;
     this->grid_min = this->grid_max = 0;
 
     // if there is nothing to average, then the average is a zero landscape.
@@ -815,44 +720,32 @@ class Persistence_landscape_on_grid {
         throw "Two grids are not compatible";
     }
 
-    this->values_of_landscapes = std::vector<std::vector<double> >((to_average[0])->values_of_landscapes.size());
     this->grid_min = (to_average[0])->grid_min;
     this->grid_max = (to_average[0])->grid_max;
+    this->number_of_grid_points = (to_average[0])->number_of_grid_points;
+    for (size_t land_no = 0; land_no != to_average.size(); ++land_no) {
+      this->number_of_stored_levels =
+          std::max(this->number_of_stored_levels, to_average[land_no]->number_of_stored_levels);
+    }
+    this->values_of_landscapes.assign(this->number_of_grid_points * this->number_of_stored_levels, 0);
 
     if (dbg) {
       std::clog << "Computations of average. The data from the current landscape have been cleared. We are ready to do "
                    "the computations. \n";
     }
 
-    // for every point in the grid:
-    for (size_t grid_point = 0; grid_point != (to_average[0])->values_of_landscapes.size(); ++grid_point) {
-      // set up a vector of the correct size:
-      size_t maximal_size_of_vector = 0;
-      for (size_t land_no = 0; land_no != to_average.size(); ++land_no) {
-        if ((to_average[land_no])->values_of_landscapes[grid_point].size() > maximal_size_of_vector)
-          maximal_size_of_vector = (to_average[land_no])->values_of_landscapes[grid_point].size();
-      }
-      this->values_of_landscapes[grid_point] = std::vector<double>(maximal_size_of_vector);
-
-      if (dbg) {
-        std::clog << "We are considering the point : " << grid_point
-                  << " of the grid. In this point, there are at most : " << maximal_size_of_vector
-                  << " nonzero landscape functions \n";
-      }
-
-      // and compute an arithmetic average:
-      for (size_t land_no = 0; land_no != to_average.size(); ++land_no) {
-        // summing:
-        for (size_t i = 0; i != (to_average[land_no])->values_of_landscapes[grid_point].size(); ++i) {
-          // compute the average in a smarter way.
-          this->values_of_landscapes[grid_point][i] += (to_average[land_no])->values_of_landscapes[grid_point][i];
-        }
-      }
-      // normalizing:
-      for (size_t i = 0; i != this->values_of_landscapes[grid_point].size(); ++i) {
-        this->values_of_landscapes[grid_point][i] /= static_cast<double>(to_average.size());
+    // summing, grid point after grid point:
+    for (size_t land_no = 0; land_no != to_average.size(); ++land_no) {
+      const Persistence_landscape_on_grid& land = *(to_average[land_no]);
+      for (size_t grid_point = 0; grid_point != this->number_of_grid_points; ++grid_point) {
+        const double* values = land.values_of_landscapes.data() + grid_point * land.number_of_stored_levels;
+        double* sum = this->values_of_landscapes.data() + grid_point * this->number_of_stored_levels;
+        for (size_t i = 0; i != land.number_of_stored_levels; ++i) sum[i] += values[i];
       }
     }
+    // normalizing:
+    for (double& value : this->values_of_landscapes) value /= static_cast<double>(to_average.size());
+    this->set_up_numbers_of_functions_for_vectorization_and_projections_to_reals();
   }  // compute_average
 
   /**
@@ -881,9 +774,17 @@ class Persistence_landscape_on_grid {
   // end of implementation of functions needed for concepts.
 
   /**
-  * A function that returns values of landscapes. It can be used for visualization
+  * A function that returns values of landscapes at the grid points, the zeros at the end being removed. It can be used
+  * for visualization
   **/
-  std::vector<std::vector<double> > output_for_visualization() const { return this->values_of_landscapes; }
+  std::vector<std::vector<double> > output_for_visualization() const {
+    std::vector<std::vector<double> > result(this->number_of_grid_points);
+    for (size_t i = 0; i != this->number_of_grid_points; ++i) {
+      const double* values = this->values_of_landscapes.data() + i * this->number_of_stored_levels;
+      result[i].assign(values, values + this->number_of_nonzero_values(i));
+    }
+    return result;
+  }
 
   /**
   * function used to create a gnuplot script for visualization of landscapes. Over here we need to specify which
@@ -911,14 +812,135 @@ class Persistence_landscape_on_grid {
  protected:
   double grid_min;
   double grid_max;
-  std::vector<std::vector<double> > values_of_landscapes;
+  size_t number_of_grid_points;
+  // number of values stored at every grid point
+  size_t number_of_stored_levels;
+  // values of the landscapes at the grid points, see the description of the class
+  std::vector<double> values_of_landscapes;
   size_t number_of_functions_for_vectorization;
   size_t number_of_functions_for_projections_to_reals;
 
   void set_up_numbers_of_functions_for_vectorization_and_projections_to_reals() {
     // warning, this function can be only called after filling in the values_of_landscapes vector.
-    this->number_of_functions_for_vectorization = this->values_of_landscapes.size();
-    this->number_of_functions_for_projections_to_reals = this->values_of_landscapes.size();
+    this->number_of_functions_for_vectorization = this->number_of_grid_points;
+    this->number_of_functions_for_projections_to_reals = this->number_of_grid_points;
+  }
+
+  // value of the given level of the landscape at the given grid point, zero if the level is not stored
+  double value(size_t grid_point, size_t level) const {
+    if (level >= this->number_of_stored_levels) return 0;
+    return this->values_of_landscapes[grid_point * this->number_of_stored_levels + level];
+  }
+
+  // number of values at the given grid point without the zeros at the end
+  size_t number_of_nonzero_values(size_t grid_point) const {
+    size_t size = this->number_of_stored_levels;
+    while (size != 0 && this->value(grid_point, size - 1) == 0) --size;
+    return size;
+  }
+
+  // stores the values given grid point after grid point, padding them with zeros
+  void set_values_of_landscapes(const std::vector<std::vector<double> >& values) {
+    this->number_of_grid_points = values.size();
+    this->number_of_stored_levels = 0;
+    for (size_t i = 0; i != values.size(); ++i) {
+      this->number_of_stored_levels = std::max(this->number_of_stored_levels, values[i].size());
+    }
+    this->values_of_landscapes.assign(this->number_of_grid_points * this->number_of_stored_levels, 0);
+    for (size_t i = 0; i != values.size(); ++i) {
+      std::copy(values[i].begin(), values[i].end(),
+                this->values_of_landscapes.begin() + i * this->number_of_stored_levels);
+    }
+    this->set_up_numbers_of_functions_for_vectorization_and_projections_to_reals();
+  }
+
+  // Calls f(values1, values2, n) for every grid point, where values1 and values2 are the values of first and second
+  // at this grid point, both padded with zeros up to n values. The padding is only done for the grid points of the
+  // landscape with less levels, in a buffer.
+  template <typename F>
+  static void for_each_pair_of_grid_points(const Persistence_landscape_on_grid& first,
+                                           const Persistence_landscape_on_grid& second, F f) {
+    const size_t levels1 = first.number_of_stored_levels, levels2 = second.number_of_stored_levels;
+    const size_t levels = std::max(levels1, levels2);
+    std::vector<double> buffer(levels, 0);
+    for (size_t i = 0; i != first.number_of_grid_points; ++i) {
+      const double* values1 = first.values_of_landscapes.data() + i * levels1;
+      const double* values2 = second.values_of_landscapes.data() + i * levels2;
+      if (levels1 < levels) {
+        std::copy(values1, values1 + levels1, buffer.begin());
+        values1 = buffer.data();
+      } else if (levels2 < levels) {
+        std::copy(values2, values2 + levels2, buffer.begin());
+        values2 = buffer.data();
+      }
+      f(values1, values2, levels);
+    }
+  }
+
+  // The integral of | first-second |^p, i.e. compute_integral_of_landscape(p) (or compute_integral_of_landscape() if
+  // p == 1) of the absolute value of the difference of the landscapes, computed without building that difference.
+  static double integral_of_difference(const Persistence_landscape_on_grid& first,
+                                       const Persistence_landscape_on_grid& second, double p) {
+    const double dx = (first.grid_max - first.grid_min) / static_cast<double>(first.number_of_grid_points - 1);
+    if (p == 1) {
+      // The trapezoid rule of compute_integral_of_landscape(level) sums all the values, and half of the last ones.
+      double sum = 0, last = 0;
+      for_each_pair_of_grid_points(first, second, [&](const double* values1, const double* values2, size_t n) {
+        double sum0 = 0, sum1 = 0;
+        size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+          sum0 += std::abs(values1[i] - values2[i]);
+          sum1 += std::abs(values1[i + 1] - values2[i + 1]);
+        }
+        if (i < n) sum0 += std::abs(values1[i] - values2[i]);
+        last = sum0 + sum1;
+        sum += last;
+      });
+      return dx * (sum - 0.5 * last);
+    }
+    // As in compute_integral_of_landscape(p, level), for every level, the segments between two consecutive values are
+    // integrated over a length dx, except when the values are equal.
+    std::vector<double> previous;
+    double result = 0;
+    bool first_grid_point = true;
+    for_each_pair_of_grid_points(first, second, [&](const double* values1, const double* values2, size_t n) {
+      if (first_grid_point) {
+        previous.resize(n);
+        for (size_t i = 0; i != n; ++i) previous[i] = std::abs(values1[i] - values2[i]);
+        first_grid_point = false;
+        return;
+      }
+      for (size_t i = 0; i != n; ++i) {
+        double current = std::abs(values1[i] - values2[i]);
+        if (current == previous[i]) continue;
+        result += dx * (pow(current, p + 1) - pow(previous[i], p + 1)) / ((p + 1) * (current - previous[i]));
+        previous[i] = current;
+      }
+    });
+    return result;
+  }
+
+  // The sum over the levels of compute_inner_product(l1, l2, level). On every interval of length dx, the integral of
+  // the product of two linear functions with values y0, y1 and z0, z1 at its ends is
+  // dx/6 (2y0z0 + y0z1 + y1z0 + 2y1z1).
+  static double inner_product_of_levels(const Persistence_landscape_on_grid& l1,
+                                        const Persistence_landscape_on_grid& l2) {
+    const double dx = (l1.grid_max - l1.grid_min) / static_cast<double>(l1.number_of_grid_points - 1);
+    const size_t levels = std::min(l1.number_of_stored_levels, l2.number_of_stored_levels);
+    double squares = 0, crossed = 0, last = 0;
+    for (size_t i = 0; i != l1.number_of_grid_points; ++i) {
+      const double* y = l1.values_of_landscapes.data() + i * l1.number_of_stored_levels;
+      const double* z = l2.values_of_landscapes.data() + i * l2.number_of_stored_levels;
+      double product = 0;
+      for (size_t j = 0; j != levels; ++j) product += y[j] * z[j];
+      squares += product;
+      last = product;
+      if (i == 0) continue;
+      const double* previous_y = y - l1.number_of_stored_levels;
+      const double* previous_z = z - l2.number_of_stored_levels;
+      for (size_t j = 0; j != levels; ++j) crossed += previous_y[j] * z[j] + y[j] * previous_z[j];
+    }
+    return dx / 6 * (4 * squares - 2 * last + crossed);
   }
   void set_up_values_of_landscapes(const std::vector<std::pair<double, double> >& p, double grid_min_, double grid_max_,
                                    size_t number_of_points_,
@@ -959,7 +981,7 @@ void Persistence_landscape_on_grid::set_up_values_of_landscapes(const std::vecto
   // if number_of_levels == std::numeric_limits<size_t>::max(), then we will have all the nonzero values of landscapes,
   // and will store them in a vector
   // if number_of_levels != std::numeric_limits<size_t>::max(), then we will use those vectors as heaps.
-  this->values_of_landscapes = std::vector<std::vector<double> >(number_of_points_ + 1);
+  std::vector<std::vector<double> > values_of_landscapes(number_of_points_ + 1);
 
   this->grid_min = grid_min_;
   this->grid_max = grid_max_;
@@ -993,27 +1015,27 @@ void Persistence_landscape_on_grid::set_up_values_of_landscapes(const std::vecto
         // we have a heap of no more that number_of_levels values.
         // Note that if we are using heaps, we want to know the shortest distance in the heap.
         // This is achieved by putting -distance to the heap.
-        if (this->values_of_landscapes[i].size() >= number_of_levels) {
+        if (values_of_landscapes[i].size() >= number_of_levels) {
           // in this case, the full heap is build, and we need to check if the landscape_value is not larger than the
           // smallest element in the heap.
-          if (-landscape_value < this->values_of_landscapes[i].front()) {
+          if (-landscape_value < values_of_landscapes[i].front()) {
             // if it is, we remove the largest value in the heap, and move on.
-            std::pop_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
-            this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1] = -landscape_value;
-            std::push_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
+            std::pop_heap(values_of_landscapes[i].begin(), values_of_landscapes[i].end());
+            values_of_landscapes[i][values_of_landscapes[i].size() - 1] = -landscape_value;
+            std::push_heap(values_of_landscapes[i].begin(), values_of_landscapes[i].end());
           }
         } else {
           // in this case we are still filling in the array.
-          this->values_of_landscapes[i].push_back(-landscape_value);
-          if (this->values_of_landscapes[i].size() == number_of_levels - 1) {
-            // this->values_of_landscapes[i].size() == number_of_levels
+          values_of_landscapes[i].push_back(-landscape_value);
+          if (values_of_landscapes[i].size() == number_of_levels - 1) {
+            // values_of_landscapes[i].size() == number_of_levels
             // in this case we need to create the heap.
-            std::make_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
+            std::make_heap(values_of_landscapes[i].begin(), values_of_landscapes[i].end());
           }
         }
       } else {
         // we have vector of all values
-        this->values_of_landscapes[i].push_back(landscape_value);
+        values_of_landscapes[i].push_back(landscape_value);
       }
       landscape_value += dx;
     }
@@ -1021,26 +1043,26 @@ void Persistence_landscape_on_grid::set_up_values_of_landscapes(const std::vecto
       if (landscape_value > 0) {
         if (number_of_levels != std::numeric_limits<unsigned>::max()) {
           // we have a heap of no more that number_of_levels values
-          if (this->values_of_landscapes[i].size() >= number_of_levels) {
+          if (values_of_landscapes[i].size() >= number_of_levels) {
             // in this case, the full heap is build, and we need to check if the landscape_value is not larger than the
             // smallest element in the heap.
-            if (-landscape_value < this->values_of_landscapes[i].front()) {
+            if (-landscape_value < values_of_landscapes[i].front()) {
               // if it is, we remove the largest value in the heap, and move on.
-              std::pop_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
-              this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1] = -landscape_value;
-              std::push_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
+              std::pop_heap(values_of_landscapes[i].begin(), values_of_landscapes[i].end());
+              values_of_landscapes[i][values_of_landscapes[i].size() - 1] = -landscape_value;
+              std::push_heap(values_of_landscapes[i].begin(), values_of_landscapes[i].end());
             }
           } else {
             // in this case we are still filling in the array.
-            this->values_of_landscapes[i].push_back(-landscape_value);
-            if (this->values_of_landscapes[i].size() == number_of_levels - 1) {
-              // this->values_of_landscapes[i].size() == number_of_levels
+            values_of_landscapes[i].push_back(-landscape_value);
+            if (values_of_landscapes[i].size() == number_of_levels - 1) {
+              // values_of_landscapes[i].size() == number_of_levels
               // in this case we need to create the heap.
-              std::make_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
+              std::make_heap(values_of_landscapes[i].begin(), values_of_landscapes[i].end());
             }
           }
         } else {
-          this->values_of_landscapes[i].push_back(landscape_value);
+          values_of_landscapes[i].push_back(landscape_value);
         }
 
         if (dbg) {
@@ -1056,17 +1078,18 @@ void Persistence_landscape_on_grid::set_up_values_of_landscapes(const std::vecto
     // in this case, vectors are used as heaps. And, since we want to have the smallest element at the top of
     // each heap, we store minus distances. To get if right at the end, we need to multiply each value
     // in the heap by -1 to get real vector of distances.
-    for (size_t pt = 0; pt != this->values_of_landscapes.size(); ++pt) {
-      for (size_t j = 0; j != this->values_of_landscapes[pt].size(); ++j) {
-        this->values_of_landscapes[pt][j] *= -1;
+    for (size_t pt = 0; pt != values_of_landscapes.size(); ++pt) {
+      for (size_t j = 0; j != values_of_landscapes[pt].size(); ++j) {
+        values_of_landscapes[pt][j] *= -1;
       }
     }
   }
 
   // and now we need to sort the values:
-  for (size_t pt = 0; pt != this->values_of_landscapes.size(); ++pt) {
-    std::sort(this->values_of_landscapes[pt].begin(), this->values_of_landscapes[pt].end(), std::greater<double>());
+  for (size_t pt = 0; pt != values_of_landscapes.size(); ++pt) {
+    std::sort(values_of_landscapes[pt].begin(), values_of_landscapes[pt].end(), std::greater<double>());
   }
+  this->set_values_of_landscapes(values_of_landscapes);
 }  // set_up_values_of_landscapes
 
 Persistence_landscape_on_grid::Persistence_landscape_on_grid(const std::vector<std::pair<double, double> >& p,
@@ -1167,7 +1190,7 @@ void Persistence_landscape_on_grid::load_landscape_from_file(const char* filenam
     }
     v[i] = vv;
   }
-  this->values_of_landscapes = v;
+  this->set_values_of_landscapes(v);
   in.close();
 }
 
@@ -1176,12 +1199,12 @@ void Persistence_landscape_on_grid::print_to_file(const char* filename) const {
   out.open(filename);
 
   // first we store the parameters of the grid:
-  out << grid_min << std::endl << grid_max << std::endl << this->values_of_landscapes.size() << std::endl;
+  out << grid_min << std::endl << grid_max << std::endl << this->number_of_grid_points << std::endl;
 
   // and now in the following lines, the values of this->values_of_landscapes for the following arguments:
-  for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-    for (size_t j = 0; j != this->values_of_landscapes[i].size(); ++j) {
-      out << this->values_of_landscapes[i][j] << " ";
+  for (size_t i = 0; i != this->number_of_grid_points; ++i) {
+    for (size_t j = 0; j != this->number_of_nonzero_values(i); ++j) {
+      out << this->value(i, j) << " ";
     }
     out << std::endl;
   }
@@ -1208,7 +1231,7 @@ void Persistence_landscape_on_grid::plot(const char* filename, double min_x, dou
   }
 
   size_t number_of_nonzero_levels = this->number_of_nonzero_levels();
-  double dx = (this->grid_max - this->grid_min) / static_cast<double>(this->values_of_landscapes.size() - 1);
+  double dx = (this->grid_max - this->grid_min) / static_cast<double>(this->number_of_grid_points - 1);
 
   size_t from = 0;
   if (from_ != std::numeric_limits<size_t>::max()) {
@@ -1236,12 +1259,8 @@ void Persistence_landscape_on_grid::plot(const char* filename, double min_x, dou
 
   for (size_t lambda = from; lambda != to; ++lambda) {
     double point = this->grid_min;
-    for (size_t i = 0; i != this->values_of_landscapes.size(); ++i) {
-      double value = 0;
-      if (this->values_of_landscapes[i].size() > lambda) {
-        value = this->values_of_landscapes[i][lambda];
-      }
-      out << point << " " << value << std::endl;
+    for (size_t i = 0; i != this->number_of_grid_points; ++i) {
+      out << point << " " << this->value(i, lambda) << std::endl;
       point += dx;
     }
     out << "EOF" << std::endl;
@@ -1258,44 +1277,28 @@ Persistence_landscape_on_grid operation_on_pair_of_landscapes_on_grid(const Pers
 
   T oper;
   Persistence_landscape_on_grid result;
-  result.values_of_landscapes = std::vector<std::vector<double> >(land1.values_of_landscapes.size());
   result.grid_min = land1.grid_min;
   result.grid_max = land1.grid_max;
+  result.number_of_grid_points = land1.number_of_grid_points;
+  result.number_of_stored_levels = std::max(land1.number_of_stored_levels, land2.number_of_stored_levels);
+  result.values_of_landscapes.resize(result.number_of_grid_points * result.number_of_stored_levels);
+  result.set_up_numbers_of_functions_for_vectorization_and_projections_to_reals();
 
   // now we perform the operations:
-  for (size_t grid_point = 0; grid_point != land1.values_of_landscapes.size(); ++grid_point) {
-    result.values_of_landscapes[grid_point] = std::vector<double>(
-        std::max(land1.values_of_landscapes[grid_point].size(), land2.values_of_landscapes[grid_point].size()));
-    for (size_t lambda = 0; lambda != std::max(land1.values_of_landscapes[grid_point].size(),
-                                               land2.values_of_landscapes[grid_point].size());
-         ++lambda) {
-      double value1 = 0;
-      double value2 = 0;
-      if (lambda < land1.values_of_landscapes[grid_point].size())
-        value1 = land1.values_of_landscapes[grid_point][lambda];
-      if (lambda < land2.values_of_landscapes[grid_point].size())
-        value2 = land2.values_of_landscapes[grid_point][lambda];
-      result.values_of_landscapes[grid_point][lambda] = oper(value1, value2);
-    }
-  }
+  double* values = result.values_of_landscapes.data();
+  Persistence_landscape_on_grid::for_each_pair_of_grid_points(
+      land1, land2, [&](const double* values1, const double* values2, size_t n) {
+        for (size_t lambda = 0; lambda != n; ++lambda) values[lambda] = oper(values1[lambda], values2[lambda]);
+        values += n;
+      });
 
   return result;
 }
 
 Persistence_landscape_on_grid Persistence_landscape_on_grid::multiply_lanscape_by_real_number_not_overwrite(
     double x) const {
-  Persistence_landscape_on_grid result;
-  result.values_of_landscapes = std::vector<std::vector<double> >(this->values_of_landscapes.size());
-  result.grid_min = this->grid_min;
-  result.grid_max = this->grid_max;
-
-  for (size_t grid_point = 0; grid_point != this->values_of_landscapes.size(); ++grid_point) {
-    result.values_of_landscapes[grid_point] = std::vector<double>(this->values_of_landscapes[grid_point].size());
-    for (size_t i = 0; i != this->values_of_landscapes[grid_point].size(); ++i) {
-      result.values_of_landscapes[grid_point][i] = x * this->values_of_landscapes[grid_point][i];
-    }
-  }
-
+  Persistence_landscape_on_grid result(*this);
+  result *= x;
   return result;
 }
 
@@ -1306,29 +1309,58 @@ double compute_max_norm_distance_of_landscapes(const Persistence_landscape_on_gr
   // first we need to check if first and second is defined on the same domain"
   if (!check_if_defined_on_the_same_domain(first, second)) throw "Two grids are not compatible";
 
-  for (size_t i = 0; i != first.values_of_landscapes.size(); ++i) {
-    for (size_t j = 0; j != std::min(first.values_of_landscapes[i].size(), second.values_of_landscapes[i].size());
-         ++j) {
-      if (result < abs(first.values_of_landscapes[i][j] - second.values_of_landscapes[i][j])) {
-        result = abs(first.values_of_landscapes[i][j] - second.values_of_landscapes[i][j]);
-      }
-    }
-    if (first.values_of_landscapes[i].size() ==
-        std::min(first.values_of_landscapes[i].size(), second.values_of_landscapes[i].size())) {
-      for (size_t j = first.values_of_landscapes[i].size(); j != second.values_of_landscapes[i].size(); ++j) {
-        if (result < second.values_of_landscapes[i][j]) result = second.values_of_landscapes[i][j];
-      }
-    }
-    if (second.values_of_landscapes[i].size() ==
-        std::min(first.values_of_landscapes[i].size(), second.values_of_landscapes[i].size())) {
-      for (size_t j = second.values_of_landscapes[i].size(); j != first.values_of_landscapes[i].size(); ++j) {
-        if (result < first.values_of_landscapes[i][j]) result = first.values_of_landscapes[i][j];
-      }
-    }
-  }
+  Persistence_landscape_on_grid::for_each_pair_of_grid_points(
+      first, second, [&](const double* values1, const double* values2, size_t n) {
+        for (size_t j = 0; j != n; ++j) result = std::max(result, std::abs(values1[j] - values2[j]));
+      });
   return result;
 }
 
+/**
+ * Computes the matrix of the \f$L^p\f$ distances between all the pairs of a collection of persistence landscapes on
+ * the same grid, as given by Persistence_landscape_on_grid::distance(second, p), in parallel when TBB is available. The
+ * distance between landscapes[i] and landscapes[j] is at position i * landscapes.size() + j.
+ *
+ * \ingroup Persistence_representations
+**/
+inline std::vector<double> compute_distance_matrix_of_landscapes_on_grid(
+    const std::vector<Persistence_landscape_on_grid>& landscapes, double p = 1) {
+  const size_t n = landscapes.size();
+  std::vector<double> matrix(n * n, 0);
+  auto compute_row = [&](size_t i) {
+    for (size_t j = i + 1; j < n; ++j) matrix[i * n + j] = matrix[j * n + i] = landscapes[i].distance(landscapes[j], p);
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(size_t(0), n, compute_row);
+#else
+  for (size_t i = 0; i < n; ++i) compute_row(i);
+#endif
+  return matrix;
+}
+
+/**
+ * Computes the matrix of the scalar products between all the pairs of a collection of persistence landscapes on the
+ * same grid, as given by compute_inner_product(), in parallel when TBB is available. The scalar product of
+ * landscapes[i] and landscapes[j] is at position i * landscapes.size() + j.
+ *
+ * \ingroup Persistence_representations
+**/
+inline std::vector<double> compute_inner_product_matrix_of_landscapes_on_grid(
+    const std::vector<Persistence_landscape_on_grid>& landscapes) {
+  const size_t n = landscapes.size();
+  std::vector<double> matrix(n * n, 0);
+  auto compute_row = [&](size_t i) {
+    for (size_t j = i; j < n; ++j)
+      matrix[i * n + j] = matrix[j * n + i] = compute_inner_product(landscapes[i], landscapes[j]);
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(size_t(0), n, compute_row);
+#else
+  for (size_t i = 0; i < n; ++i) compute_row(i);
+#endif
+  return matrix;
+}
+
 }  // namespace Persistence_representations
 }  // namespace Gudhi
 
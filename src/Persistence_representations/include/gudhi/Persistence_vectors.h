@@ -16,6 +16,10 @@
 #include <gudhi/common_persistence_representations.h>
 #include <gudhi/distance_functions.h>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <fstream>
 #include <cmath>
 #include <algorithm>
@@ -24,6 +28,8 @@
 #include <functional>
 #include <utility>
 #include <vector>
+#include <map>
+#include <queue>
 
 namespace Gudhi {
 namespace Persistence_representations {
@@ -47,6 +53,12 @@ struct Maximum_distance {
  * The parameter of the class is the class that computes distance used to construct the vectors. The typical function
  * is either Euclidean of maximum (Manhattan) distance.
  *
+ * Only the where_to_cut largest distances are computed: the points of the diagram are processed by decreasing distance
+ * to the diagonal, which bounds all the distances involving the remaining points, and the construction stops as soon as
+ * none of them can enter the vector. For the point being processed, only the distances to the points in a box around
+ * it are computed, the other points being too far to change the value. This requires that the distance is at least
+ * the maximum distance, which is the case for both the Euclidean and the maximum distance.
+ *
  * This class implements the following concepts: Vectorized_topological_data, Topological_data_with_distances,
  * Real_valued_topological_data, Topological_data_with_averages, Topological_data_with_scalar_product
  **/
@@ -316,6 +328,7 @@ class Vector_distances_in_diagram {
 
   void compute_sorted_vector_of_distances_via_heap(size_t where_to_cut);
   void compute_sorted_vector_of_distances_via_vector_sorting(size_t where_to_cut);
+  void compute_sorted_vector_of_distances_via_pruning(size_t where_to_cut);
 
   Vector_distances_in_diagram(const std::vector<double>& sorted_vector_of_distances_)
       : sorted_vector_of_distances(sorted_vector_of_distances_) {
@@ -335,8 +348,7 @@ Vector_distances_in_diagram<F>::Vector_distances_in_diagram(const std::vector<st
     : where_to_cut(where_to_cut_) {
   std::vector<std::pair<double, double> > i(intervals_);
   this->intervals = i;
-  // this->compute_sorted_vector_of_distances_via_heap( where_to_cut );
-  this->compute_sorted_vector_of_distances_via_vector_sorting(where_to_cut);
+  this->compute_sorted_vector_of_distances_via_pruning(where_to_cut);
   this->set_up_numbers_of_functions_for_vectorization_and_projections_to_reals();
 }
 
@@ -351,8 +363,7 @@ Vector_distances_in_diagram<F>::Vector_distances_in_diagram(const char* filename
     intervals = read_persistence_intervals_in_one_dimension_from_file(filename, dimension);
   }
   this->intervals = intervals;
-  this->compute_sorted_vector_of_distances_via_heap(where_to_cut);
-  // this->compute_sorted_vector_of_distances_via_vector_sorting( where_to_cut );
+  this->compute_sorted_vector_of_distances_via_pruning(where_to_cut);
   set_up_numbers_of_functions_for_vectorization_and_projections_to_reals();
 }
 
@@ -471,6 +482,76 @@ void Vector_distances_in_diagram<F>::compute_sorted_vector_of_distances_via_vect
   this->sorted_vector_of_distances = distances;
 }
 
+template <typename F>
+void Vector_distances_in_diagram<F>::compute_sorted_vector_of_distances_via_pruning(size_t where_to_cut) {
+  const size_t n = this->intervals.size();
+  const size_t number_of_distances = (size_t)(0.5 * n * (n - 1) + n);
+  if (where_to_cut == 0) {
+    this->sorted_vector_of_distances.clear();
+    return;
+  }
+  if (where_to_cut >= number_of_distances) {
+    // all the distances are needed.
+    this->compute_sorted_vector_of_distances_via_vector_sorting(where_to_cut);
+    return;
+  }
+  F f;
+
+  // distances of the points from the diagonal, and the points sorted by decreasing distance from the diagonal.
+  std::vector<double> distance_from_diagonal(n);
+  std::vector<size_t> order(n);
+  for (size_t i = 0; i != n; ++i) {
+    double middle = 0.5 * (this->intervals[i].first + this->intervals[i].second);
+    distance_from_diagonal[i] = f(this->intervals[i], std::make_pair(middle, middle));
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+            [&](size_t i, size_t j) { return distance_from_diagonal[i] > distance_from_diagonal[j]; });
+
+  // the where_to_cut largest values found so far, the smallest of them on top.
+  std::priority_queue<double, std::vector<double>, std::greater<double> > heap;
+  // returns false if value, and hence any smaller value, cannot enter the heap.
+  auto insert = [&](double value) {
+    if (heap.size() < where_to_cut) {
+      heap.push(value);
+    } else {
+      if (value <= heap.top()) return false;
+      heap.pop();
+      heap.push(value);
+    }
+    return true;
+  };
+
+  // the points processed so far, indexed by their birth.
+  std::multimap<double, size_t> processed;
+  for (size_t i : order) {
+    // The value for the pair of points i and j, with j processed before i, is the minimum of their distance and of the
+    // distance of i from the diagonal. None of the remaining values is larger than the distance of i from the diagonal.
+    const double radius = distance_from_diagonal[i];
+    if (!insert(radius)) break;
+
+    // the points in the box of radius radius around i, the other points are further than radius from i.
+    size_t points_in_the_box = 0;
+    auto end = processed.upper_bound(this->intervals[i].first + radius);
+    for (auto it = processed.lower_bound(this->intervals[i].first - radius); it != end; ++it) {
+      const std::pair<double, double>& point = this->intervals[it->second];
+      if (std::fabs(point.second - this->intervals[i].second) > radius) continue;
+      ++points_in_the_box;
+      insert(std::min(f(this->intervals[i], point), radius));
+    }
+    for (size_t j = points_in_the_box; j != processed.size(); ++j) {
+      if (!insert(radius)) break;
+    }
+    processed.emplace(this->intervals[i].first, i);
+  }
+
+  this->sorted_vector_of_distances.resize(heap.size());
+  for (size_t i = heap.size(); i != 0; --i) {
+    this->sorted_vector_of_distances[i - 1] = heap.top();
+    heap.pop();
+  }
+}
+
 // Implementations of functions for various concepts.
 template <typename F>
 double Vector_distances_in_diagram<F>::project_to_R(int number_of_function) const {
@@ -622,6 +703,29 @@ double Vector_distances_in_diagram<F>::compute_scalar_product(const Vector_dista
   return result;
 }
 
+/**
+ * Constructs the persistence vectors of a collection of persistence diagrams (given as vectors of birth-death pairs),
+ * in parallel when TBB is available. The i-th vector is the one of diagrams[i], as given by the constructor
+ * Vector_distances_in_diagram<F>(diagrams[i], where_to_cut).
+ *
+ * \ingroup Persistence_representations
+**/
+template <typename F>
+std::vector<Vector_distances_in_diagram<F> > construct_persistence_vectors(
+    const std::vector<std::vector<std::pair<double, double> > >& diagrams, size_t where_to_cut) {
+  std::vector<Vector_distances_in_diagram<F> > vectors(diagrams.size());
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(size_t(0), diagrams.size(), [&](size_t i) {
+    vectors[i] = Vector_distances_in_diagram<F>(diagrams[i], where_to_cut);
+  });
+#else
+  for (size_t i = 0; i != diagrams.size(); ++i) {
+    vectors[i] = Vector_distances_in_diagram<F>(diagrams[i], where_to_cut);
+  }
+#endif
+  return vectors;
+}
+
 }  // namespace Persistence_representations
 }  // namespace Gudhi
 
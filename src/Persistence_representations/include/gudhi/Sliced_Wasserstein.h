@@ -16,16 +16,202 @@
 #include <gudhi/common_persistence_representations.h>
 #include <gudhi/Debug_utils.h>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <vector>     // for std::vector<>
 #include <utility>    // for std::pair<>, std::move
-#include <algorithm>  // for std::sort, std::max, std::merge
+#include <algorithm>  // for std::sort, std::max, std::merge, std::reverse_copy
 #include <cmath>      // for std::abs, std::sqrt
 #include <stdexcept>  // for std::invalid_argument
 #include <random>     // for std::random_device
+#include <iterator>   // for std::begin, std::end
+#include <tuple>      // for std::get
+#include <cstddef>    // for std::size_t
+#include <limits>     // for std::numeric_limits
 
 namespace Gudhi {
 namespace Persistence_representations {
 
+/**
+ * \class Sliced_wasserstein_projections gudhi/Sliced_Wasserstein.h
+ * \brief The sorted projections of a collection of persistence diagrams onto evenly spaced lines, from which the
+ * approximate Sliced Wasserstein distances between the diagrams are computed.
+ *
+ * \ingroup Persistence_representations
+ *
+ * \details
+ * The lines are the ones of angles \f$-\pi/2 + k\pi/N\f$ for \f$0\leq k<N\f$, as in Sliced_Wasserstein with a
+ * positive number \f$N\f$ of directions. The cosines and sines of the angles are computed once, and the projections of
+ * all the diagrams, and of the projections of their points onto the diagonal, are sorted and stored in a single array,
+ * diagram after diagram and line after line. The approximate Sliced Wasserstein distance between two diagrams is then
+ * the mean over the lines of the 1-norm between two merges of their sorted projections, which are read in place.
+ *
+ * The points of the diagrams must be finite.
+ **/
+class Sliced_wasserstein_projections {
+ public:
+  /** \brief Default constructor, with no diagram. */
+  Sliced_wasserstein_projections() : approx_(0), offsets_(1, 0) {}
+
+  /** \brief Projects a collection of persistence diagrams, in parallel when TBB is available.
+   *
+   * \tparam Persistence_diagram_range A range of ranges of points, whose coordinates are accessed with std::get<0> and
+   * std::get<1>, e.g. a std::vector of Persistence_diagram.
+   *
+   * @param[in] diagrams The persistence diagrams.
+   * @param[in] approx   The number of lines, which must be positive.
+   */
+  template <typename Persistence_diagram_range>
+  Sliced_wasserstein_projections(const Persistence_diagram_range& diagrams, int approx) : approx_(approx) {
+    GUDHI_CHECK(approx > 0, std::invalid_argument("Error: the number of directions must be positive"));
+    std::vector<std::vector<std::pair<double, double> > > points;
+    offsets_.push_back(0);
+    for (auto it = std::begin(diagrams); it != std::end(diagrams); ++it) {
+      points.emplace_back();
+      for (auto const& point : *it) points.back().emplace_back(std::get<0>(point), std::get<1>(point));
+      offsets_.push_back(offsets_.back() + points.back().size());
+    }
+    cosines_.resize(approx_);
+    sines_.resize(approx_);
+    double step = pi / approx_;
+    for (int k = 0; k < approx_; k++) {
+      cosines_[k] = cos(-pi / 2 + k * step);
+      sines_[k] = sin(-pi / 2 + k * step);
+    }
+    projections_.resize(2 * approx_ * (offsets_.back() + size()));
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), points.size(), [&](std::size_t i) { project(points[i], i); });
+#else
+    for (std::size_t i = 0; i < points.size(); i++) project(points[i], i);
+#endif
+  }
+
+  /** \brief Returns the number of diagrams. */
+  std::size_t size() const { return offsets_.size() - 1; }
+
+  /** \brief Returns the number of lines. */
+  int number_of_directions() const { return approx_; }
+
+  /** \brief Returns the approximate Sliced Wasserstein distance between the diagram i and the diagram j of other.
+   *
+   * @pre other has the same number of lines.
+   */
+  double distance(std::size_t i, const Sliced_wasserstein_projections& other, std::size_t j) const {
+    GUDHI_CHECK(this->approx_ == other.approx_,
+                std::invalid_argument("Error: different approx values for representations"));
+    const std::size_t n1 = this->offsets_[i + 1] - this->offsets_[i];
+    const std::size_t n2 = other.offsets_[j + 1] - other.offsets_[j];
+    const double* block1 = this->projections_.data() + this->block(i);
+    const double* block2 = other.projections_.data() + other.block(j);
+    double sw = 0;
+    for (int k = 0; k < approx_; k++) {
+      const double* p1 = block1 + 2 * k * (n1 + 1);
+      const double* d1 = p1 + n1 + 1;
+      const double* p2 = block2 + 2 * k * (n2 + 1);
+      const double* d2 = p2 + n2 + 1;
+      // Merge the projections of the first diagram with the diagonal projections of the second one, and the other way
+      // around, and compare the results on the fly. The infinite sentinels make the merges branch free.
+      std::size_t a1 = 0, a2 = 0, b1 = 0, b2 = 0;
+      double f = 0;
+      for (std::size_t l = 0; l < n1 + n2; l++) {
+        const bool take_a1 = p1[a1] <= d2[a2];
+        const bool take_b1 = p2[b1] <= d1[b2];
+        const double a = take_a1 ? p1[a1] : d2[a2];
+        const double b = take_b1 ? p2[b1] : d1[b2];
+        a1 += take_a1;
+        a2 += !take_a1;
+        b1 += take_b1;
+        b2 += !take_b1;
+        f += std::abs(a - b);
+      }
+      sw += f;
+    }
+    return sw / approx_;
+  }
+
+  /** \brief Returns the matrix of the approximate Sliced Wasserstein distances between all the pairs of diagrams, row
+   * by row. The pairs are processed by blocks, in parallel when TBB is available.
+   */
+  std::vector<double> distance_matrix() const { return distance_matrix(*this, true); }
+
+  /** \brief Returns the matrix of the approximate Sliced Wasserstein distances between the diagrams and the diagrams of
+   * other, row by row. The pairs are processed by blocks, in parallel when TBB is available.
+   *
+   * @pre other has the same number of lines.
+   */
+  std::vector<double> distance_matrix(const Sliced_wasserstein_projections& other) const {
+    return distance_matrix(other, false);
+  }
+
+ private:
+  // Number of diagrams in the blocks of the distance matrices, whose projections should stay in cache together
+  static constexpr std::size_t block_size = 16;
+
+  // Position of the projections of diagram i
+  std::size_t block(std::size_t i) const { return 2 * approx_ * (offsets_[i] + i); }
+
+  void project(const std::vector<std::pair<double, double> >& points, std::size_t i) {
+    const std::size_t n = points.size();
+    double* block = projections_.data() + this->block(i);
+    // The projections of the diagonal projections (m, m) are m * (cos + sin), so they are sorted once.
+    std::vector<double> x(n), y(n), middles(n);
+    for (std::size_t l = 0; l < n; l++) {
+      x[l] = points[l].first;
+      y[l] = points[l].second;
+      middles[l] = (x[l] + y[l]) / 2;
+    }
+    std::sort(middles.begin(), middles.end());
+    for (int k = 0; k < approx_; k++) {
+      double* projection = block + 2 * k * (n + 1);
+      double* projection_diagonal = projection + n + 1;
+      const double c = cosines_[k], s = sines_[k];
+      for (std::size_t l = 0; l < n; l++) projection[l] = x[l] * c + y[l] * s;
+      std::sort(projection, projection + n);
+      const double cs = c + s;
+      if (cs >= 0) {
+        for (std::size_t l = 0; l < n; l++) projection_diagonal[l] = middles[l] * cs;
+      } else {
+        for (std::size_t l = 0; l < n; l++) projection_diagonal[l] = middles[n - 1 - l] * cs;
+      }
+      projection[n] = projection_diagonal[n] = std::numeric_limits<double>::infinity();
+    }
+  }
+
+  std::vector<double> distance_matrix(const Sliced_wasserstein_projections& other, bool symmetric) const {
+    const std::size_t n1 = size(), n2 = other.size();
+    std::vector<double> matrix(n1 * n2, 0.);
+    const std::size_t blocks1 = (n1 + block_size - 1) / block_size;
+    const std::size_t blocks2 = (n2 + block_size - 1) / block_size;
+    auto compute_block = [&](std::size_t b) {
+      const std::size_t b1 = b / blocks2, b2 = b % blocks2;
+      if (symmetric && b2 < b1) return;
+      for (std::size_t i = b1 * block_size; i < std::min(n1, (b1 + 1) * block_size); i++) {
+        for (std::size_t j = b2 * block_size; j < std::min(n2, (b2 + 1) * block_size); j++) {
+          if (symmetric && j <= i) continue;
+          matrix[i * n2 + j] = distance(i, other, j);
+          if (symmetric) matrix[j * n2 + i] = matrix[i * n2 + j];
+        }
+      }
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), blocks1 * blocks2, compute_block);
+#else
+    for (std::size_t b = 0; b < blocks1 * blocks2; b++) compute_block(b);
+#endif
+    return matrix;
+  }
+
+  int approx_;
+  std::vector<double> cosines_, sines_;
+  // The points of diagram i are the points offsets_[i] to offsets_[i + 1] - 1 of the collection
+  std::vector<std::size_t> offsets_;
+  // For each diagram with n points, and each line, the n sorted projections of the points followed by the n sorted
+  // projections of their diagonal projections, each followed by an infinite sentinel
+  std::vector<double> projections_;
+};
+
 /**
  * \class Sliced_Wasserstein gudhi/Sliced_Wasserstein.h
  * \brief A class implementing the Sliced Wasserstein kernel.
@@ -64,7 +250,7 @@ class Sliced_Wasserstein {
   Persistence_diagram diagram;
   int approx;
   double sigma;
-  std::vector<std::vector<double> > projections, projections_diagonal;
+  Sliced_wasserstein_projections projections;
 
   // **********************************
   // Utils.
@@ -72,26 +258,7 @@ class Sliced_Wasserstein {
 
   void build_rep() {
     if (approx > 0) {
-      double step = pi / this->approx;
-      int n = diagram.size();
-
-      for (int i = 0; i < this->approx; i++) {
-        std::vector<double> l, l_diag;
-        for (int j = 0; j < n; j++) {
-          double px = diagram[j].first;
-          double py = diagram[j].second;
-          double proj_diag = (px + py) / 2;
-
-          l.push_back(px * cos(-pi / 2 + i * step) + py * sin(-pi / 2 + i * step));
-          l_diag.push_back(proj_diag * cos(-pi / 2 + i * step) + proj_diag * sin(-pi / 2 + i * step));
-        }
-
-        std::sort(l.begin(), l.end());
-        std::sort(l_diag.begin(), l_diag.end());
-        projections.push_back(std::move(l));
-        projections_diagonal.push_back(std::move(l_diag));
-      }
-
+      projections = Sliced_wasserstein_projections(std::vector<Persistence_diagram>(1, diagram), approx);
       diagram.clear();
     }
   }
@@ -309,21 +476,7 @@ class Sliced_Wasserstein {
         }
       }
     } else {
-      double step = pi / this->approx;
-      std::vector<double> v1, v2;
-      for (int i = 0; i < this->approx; i++) {
-        v1.clear();
-        v2.clear();
-        std::merge(this->projections[i].begin(), this->projections[i].end(), second.projections_diagonal[i].begin(),
-                   second.projections_diagonal[i].end(), std::back_inserter(v1));
-        std::merge(second.projections[i].begin(), second.projections[i].end(), this->projections_diagonal[i].begin(),
-                   this->projections_diagonal[i].end(), std::back_inserter(v2));
-
-        int n = v1.size();
-        double f = 0;
-        for (int j = 0; j < n; j++) f += std::abs(v1[j] - v2[j]);
-        sw += f * step;
-      }
+      return projections.distance(0, second.projections, 0);
     }
 
     return sw / pi;
@@ -374,6 +527,48 @@ class Sliced_Wasserstein {
   }
 
 };  // class Sliced_Wasserstein
+
+/**
+ * Computes the matrix of the approximate Sliced Wasserstein distances between all the pairs of persistence diagrams of
+ * a collection, with approx lines, as given by Sliced_wasserstein_projections::distance_matrix(). The entry (i, j) of
+ * the result is at position i * diagrams.size() + j.
+ *
+ * \ingroup Persistence_representations
+ **/
+template <typename Persistence_diagram_range>
+std::vector<double> sliced_wasserstein_distance_matrix(const Persistence_diagram_range& diagrams, int approx = 10) {
+  return Sliced_wasserstein_projections(diagrams, approx).distance_matrix();
+}
+
+/**
+ * Computes the matrix of the approximate Sliced Wasserstein distances between the persistence diagrams of two
+ * collections, with approx lines. The entry (i, j) of the result, at position i * diagrams2.size() + j, is the distance
+ * between diagrams1[i] and diagrams2[j].
+ *
+ * \ingroup Persistence_representations
+ **/
+template <typename Persistence_diagram_range1, typename Persistence_diagram_range2>
+std::vector<double> sliced_wasserstein_distance_matrix(const Persistence_diagram_range1& diagrams1,
+                                                       const Persistence_diagram_range2& diagrams2, int approx = 10) {
+  return Sliced_wasserstein_projections(diagrams1, approx)
+      .distance_matrix(Sliced_wasserstein_projections(diagrams2, approx));
+}
+
+/**
+ * Computes the matrix of the approximate Sliced Wasserstein kernel
+ * \f$k(D_1,D_2) = {\rm exp}\left(-\frac{SW(D_1,D_2)}{2\sigma^2}\right)\f$ between all the pairs of persistence
+ * diagrams of a collection, with approx lines. The entry (i, j) of the result is at position i * diagrams.size() + j.
+ *
+ * \ingroup Persistence_representations
+ **/
+template <typename Persistence_diagram_range>
+std::vector<double> sliced_wasserstein_kernel_matrix(const Persistence_diagram_range& diagrams, double sigma = 1.0,
+                                                     int approx = 10) {
+  std::vector<double> matrix = sliced_wasserstein_distance_matrix(diagrams, approx);
+  for (double& value : matrix) value = std::exp(-value / (2 * sigma * sigma));
+  return matrix;
+}
+
 }  // namespace Persistence_representations
 }  // namespace Gudhi
 
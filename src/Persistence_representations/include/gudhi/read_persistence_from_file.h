@@ -12,6 +12,7 @@
 #define READ_PERSISTENCE_FROM_FILE_H_
 
 #include <gudhi/reader_utils.h>
+#include <gudhi/Persistence_diagram_archive.h>
 
 #include <iostream>
 #include <fstream>
@@ -21,69 +22,56 @@
 #include <string>
 #include <utility>
 #include <limits>  // for std::numeric_limits<>
+#include <stdexcept>  // for std::invalid_argument
 
 namespace Gudhi {
 namespace Persistence_representations {
 
 /**
- * Universal procedure to read files with persistence. It ignores the lines starting from # (treat them as comments).
- * It reads the fist line which is not a comment and assume that there are some numerical entries over there. The
- *program assume
- * that each other line in the file, which is not a comment, have the same number of numerical entries (2, 3 or 4).
- * If there are two numerical entries per line, then the function assume that they are birth/death coordinates.
- * If there are three numerical entries per line, then the function assume that they are: dimension and birth/death
- *coordinates.
- * If there are four numerical entries per line, then the function assume that they are: the characteristic of a filed
- *over which
- * persistence was computed, dimension and birth/death coordinates.
- * The 'inf' string can appear only as a last element of a line.
- * The procedure returns vector of persistence pairs.
+ * Prepares persistence intervals read from a file for the representations: the intervals with birth > death are
+ * swapped, and the infinite intervals are ignored, unless what_to_substitute_for_infinite_bar is not -1, in which case
+ * their death is replaced by this value (and they are kept only if their birth is smaller than it).
 **/
-std::vector<std::pair<double, double> > read_persistence_intervals_in_one_dimension_from_file(
-    std::string const& filename, int dimension = -1, double what_to_substitute_for_infinite_bar = -1) {
+template <typename Interval_range>
+std::vector<std::pair<double, double> > finite_persistence_intervals(Interval_range const& barcode_initial,
+                                                                     double what_to_substitute_for_infinite_bar = -1) {
   bool dbg = false;
 
-  std::string line;
-  std::vector<std::pair<double, double> > barcode_initial =
-      read_persistence_intervals_in_dimension(filename, static_cast<int>(dimension));
   std::vector<std::pair<double, double> > final_barcode;
   final_barcode.reserve(barcode_initial.size());
 
   if (dbg) {
     std::clog << "Here are the intervals that we read from the file : \n";
-    for (size_t i = 0; i != barcode_initial.size(); ++i) {
-      std::clog << barcode_initial[i].first << " " << barcode_initial[i].second << std::endl;
+    for (auto const& interval : barcode_initial) {
+      std::clog << interval.first << " " << interval.second << std::endl;
     }
     getchar();
   }
 
-  for (size_t i = 0; i != barcode_initial.size(); ++i) {
+  for (auto const& interval : barcode_initial) {
     if (dbg) {
-      std::clog << "Considering interval : " << barcode_initial[i].first << " " << barcode_initial[i].second
-                << std::endl;
+      std::clog << "Considering interval : " << interval.first << " " << interval.second << std::endl;
     }
 
-    if (barcode_initial[i].first > barcode_initial[i].second) {
-      // note that in this case barcode_initial[i].second != std::numeric_limits<double>::infinity()
+    if (interval.first > interval.second) {
+      // note that in this case interval.second != std::numeric_limits<double>::infinity()
       if (dbg) std::clog << "Swap and enter \n";
       // swap them to make sure that birth < death
-      final_barcode.push_back(std::pair<double, double>(barcode_initial[i].second, barcode_initial[i].first));
+      final_barcode.push_back(std::pair<double, double>(interval.second, interval.first));
       continue;
     } else {
-      if (barcode_initial[i].second != std::numeric_limits<double>::infinity()) {
+      if (interval.second != std::numeric_limits<double>::infinity()) {
         if (dbg) std::clog << "Simply enters\n";
-        // in this case, due to the previous conditions we know that barcode_initial[i].first <
-        // barcode_initial[i].second, so we put them as they are
-        final_barcode.push_back(std::pair<double, double>(barcode_initial[i].first, barcode_initial[i].second));
+        // in this case, due to the previous conditions we know that interval.first < interval.second, so we put them
+        // as they are
+        final_barcode.push_back(std::pair<double, double>(interval.first, interval.second));
       }
     }
 
-    if ((barcode_initial[i].second == std::numeric_limits<double>::infinity()) &&
-        (what_to_substitute_for_infinite_bar != -1)) {
-      if (barcode_initial[i].first < what_to_substitute_for_infinite_bar) {
+    if ((interval.second == std::numeric_limits<double>::infinity()) && (what_to_substitute_for_infinite_bar != -1)) {
+      if (interval.first < what_to_substitute_for_infinite_bar) {
         // if only birth < death.
-        final_barcode.push_back(
-            std::pair<double, double>(barcode_initial[i].first, what_to_substitute_for_infinite_bar));
+        final_barcode.push_back(std::pair<double, double>(interval.first, what_to_substitute_for_infinite_bar));
       }
     } else {
       // if the variable what_to_substitute_for_infinite_bar is not set, then we ignore all the infinite bars.
@@ -100,8 +88,56 @@ std::vector<std::pair<double, double> > read_persistence_intervals_in_one_dimens
   }
 
   return final_barcode;
+}  // finite_persistence_intervals
+
+/**
+ * Universal procedure to read files with persistence. It ignores the lines starting from # (treat them as comments).
+ * It reads the fist line which is not a comment and assume that there are some numerical entries over there. The
+ *program assume
+ * that each other line in the file, which is not a comment, have the same number of numerical entries (2, 3 or 4).
+ * If there are two numerical entries per line, then the function assume that they are birth/death coordinates.
+ * If there are three numerical entries per line, then the function assume that they are: dimension and birth/death
+ *coordinates.
+ * If there are four numerical entries per line, then the function assume that they are: the characteristic of a filed
+ *over which
+ * persistence was computed, dimension and birth/death coordinates.
+ * The 'inf' string can appear only as a last element of a line.
+ * The file may also be a binary archive containing a single persistence diagram (see \ref FileFormatsPersArchive),
+ * which is then read without parsing.
+ * The procedure returns vector of persistence pairs.
+**/
+std::vector<std::pair<double, double> > read_persistence_intervals_in_one_dimension_from_file(
+    std::string const& filename, int dimension = -1, double what_to_substitute_for_infinite_bar = -1) {
+  if (is_persistence_diagram_archive(filename)) {
+    Persistence_diagram_archive archive(filename);
+    if (archive.size() != 1) {
+      std::string error_str("read_persistence_intervals_in_one_dimension_from_file - ");
+      error_str.append(filename).append(" must contain exactly one persistence diagram");
+      std::cerr << error_str << std::endl;
+      throw std::invalid_argument(error_str);
+    }
+    return finite_persistence_intervals(archive.intervals(0, dimension), what_to_substitute_for_infinite_bar);
+  }
+  return finite_persistence_intervals(read_persistence_intervals_in_dimension(filename, dimension),
+                                      what_to_substitute_for_infinite_bar);
 }  // read_persistence_intervals_in_one_dimension_from_file
 
+/**
+ * Reads all the persistence diagrams of a binary archive (see \ref FileFormatsPersArchive), in dimension `dimension`
+ * (all the dimensions if -1), and prepares them as read_persistence_intervals_in_one_dimension_from_file does. The
+ * result can be given to the batch functions of the representations, like construct_persistence_vectors.
+**/
+inline std::vector<std::vector<std::pair<double, double> > > read_persistence_intervals_in_one_dimension_from_archive(
+    std::string const& filename, int dimension = -1, double what_to_substitute_for_infinite_bar = -1) {
+  Persistence_diagram_archive archive(filename);
+  std::vector<std::vector<std::pair<double, double> > > diagrams;
+  diagrams.reserve(archive.size());
+  for (std::size_t i = 0; i != archive.size(); ++i)
+    diagrams.push_back(finite_persistence_intervals(archive.intervals(i, dimension),
+                                                    what_to_substitute_for_infinite_bar));
+  return diagrams;
+}  // read_persistence_intervals_in_one_dimension_from_archive
+
 }  // namespace Persistence_representations
 }  // namespace Gudhi
 
@@ -47,3 +47,31 @@ BOOST_AUTO_TEST_CASE(check_SW) {
   SW sw2(v2, 1.0, 100); SW swex2(v2, 1.0, -1);
   BOOST_CHECK(std::abs(sw1.compute_scalar_product(sw2) - swex1.compute_scalar_product(swex2)) <= 1e-1);
 }
+
+BOOST_AUTO_TEST_CASE(check_SW_matrices) {
+  std::vector<Persistence_diagram> diagrams(40);
+  for (std::size_t i = 0; i < diagrams.size(); i++) {
+    for (std::size_t j = 0; j < i % 7; j++) diagrams[i].emplace_back(0.1 * j, 0.1 * j + 0.05 * (i % 5) + 0.3);
+  }
+  diagrams[3].emplace_back(diagrams[3][0]);
+  std::vector<double> matrix = Gudhi::Persistence_representations::sliced_wasserstein_distance_matrix(diagrams, 20);
+  std::vector<double> kernel = Gudhi::Persistence_representations::sliced_wasserstein_kernel_matrix(diagrams, 2., 20);
+  const std::size_t n = diagrams.size();
+  BOOST_CHECK(matrix.size() == n * n);
+  for (std::size_t i = 0; i < n; i++) {
+    SW swi(diagrams[i], 2., 20);
+    BOOST_CHECK(matrix[i * n + i] == 0);
+    for (std::size_t j = 0; j < n; j++) {
+      SW swj(diagrams[j], 2., 20);
+      BOOST_CHECK(matrix[i * n + j] == matrix[j * n + i]);
+      BOOST_CHECK(std::abs(kernel[i * n + j] - swi.compute_scalar_product(swj)) <= 1e-12);
+    }
+  }
+  std::vector<Persistence_diagram> others(diagrams.begin() + 5, diagrams.begin() + 25);
+  std::vector<double> cross =
+      Gudhi::Persistence_representations::sliced_wasserstein_distance_matrix(diagrams, others, 20);
+  BOOST_CHECK(cross.size() == n * others.size());
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < others.size(); j++) BOOST_CHECK(cross[i * others.size() + j] == matrix[i * n + j + 5]);
+  }
+}
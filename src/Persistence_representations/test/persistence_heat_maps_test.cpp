@@ -13,9 +13,12 @@
 #include <boost/test/unit_test.hpp>
 #include <gudhi/reader_utils.h>
 #include <gudhi/Persistence_heat_maps.h>
+#include <gudhi/PSSK.h>
 #include <gudhi/Unitary_tests_utils.h>
 
 #include <iostream>
+#include <vector>
+#include <utility>
 
 using namespace Gudhi;
 using namespace Gudhi::Persistence_representations;
@@ -208,6 +211,58 @@ BOOST_AUTO_TEST_CASE(check_distance_of_heat_maps_infinite_power_parameters) {
   BOOST_CHECK(distance_max_double_parameter == distance_inf_double_parameter);
 }
 
+BOOST_AUTO_TEST_CASE(check_rasterization_and_batch_construction_of_heat_maps) {
+  std::vector<std::vector<std::pair<double, double> > > diagrams(4);
+  diagrams[0] = {{0.1, 0.3}, {0.2, 0.9}, {0.2, 0.9}, {0.45, 0.5}, {0.7, 1.}};
+  diagrams[1] = {{0., 1.}, {0.3, 0.31}};
+  diagrams[2] = {{-0.5, 0.2}, {0.6, 1.8}};
+  // Enough points for the filter to be applied in one direction after the other
+  for (int i = 0; i != 300; ++i) diagrams[3].emplace_back((i % 17) / 20., (i % 17) / 20. + (i % 13) / 26.);
+  std::vector<std::vector<double> > filter = create_Gaussian_filter(4, 1);
+  // A filter which is not a product of a horizontal and a vertical filter
+  std::vector<std::vector<double> > cross(5, std::vector<double>(5, 0));
+  for (size_t i = 0; i != 5; ++i) cross[i][2] = cross[2][i] = 1;
+
+  std::vector<Persistence_heat_maps<distance_from_diagonal_scaling> > maps =
+      construct_persistence_heat_maps<distance_from_diagonal_scaling>(diagrams, filter, false, 20, 0, 1);
+  BOOST_CHECK(maps.size() == diagrams.size());
+  for (size_t d = 0; d != diagrams.size(); ++d) {
+    BOOST_CHECK(maps[d] == Persistence_heat_maps<distance_from_diagonal_scaling>(diagrams[d], filter, false, 20, 0, 1));
+    for (auto const& f : {filter, cross}) {
+      // Stamp the filter at every point
+      Persistence_heat_maps<distance_from_diagonal_scaling> map(diagrams[d], f, false, 20, 0, 1);
+      std::vector<std::vector<double> > expected(20, std::vector<double>(20, 0));
+      distance_from_diagonal_scaling scaling;
+      for (auto const& point : diagrams[d]) {
+        int x_grid = static_cast<int>(point.first * 20) - static_cast<int>(f.size() / 2);
+        int y_grid = static_cast<int>(point.second * 20) - static_cast<int>(f.size() / 2);
+        for (int i = 0; i != static_cast<int>(f.size()); ++i) {
+          for (int j = 0; j != static_cast<int>(f.size()); ++j) {
+            if (x_grid + i >= 0 && x_grid + i < 20 && y_grid + j >= 0 && y_grid + j < 20)
+              expected[y_grid + j][x_grid + i] += scaling(point) * f[i][j];
+          }
+        }
+      }
+      std::vector<double> values = map.vectorize(0);
+      for (size_t i = 0; i != 20; ++i) {
+        for (size_t j = 0; j != 20; ++j) GUDHI_TEST_FLOAT_EQUALITY_CHECK(values[i * 20 + j], expected[i][j], 1e-12);
+      }
+    }
+  }
+
+  std::vector<PSSK> pssks = construct_PSSKs(diagrams, filter, 20, 0, 1);
+  BOOST_CHECK(pssks.size() == diagrams.size());
+  for (size_t d = 0; d != diagrams.size(); ++d) {
+    Persistence_heat_maps<constant_scaling_function> map(diagrams[d], filter, false, 20, 0, 1);
+    std::vector<double> values = map.vectorize(0);
+    std::vector<double> pssk_values = pssks[d].vectorize(0);
+    for (size_t i = 0; i != 20; ++i) {
+      for (size_t j = 0; j != 20; ++j)
+        GUDHI_TEST_FLOAT_EQUALITY_CHECK(pssk_values[i * 20 + j], values[i * 20 + j] - values[j * 20 + i], 1e-12);
+    }
+  }
+}
+
 // Below I am storing the code used to generate tests for that functionality.
 /*
         std::vector< std::pair< double,double > > intervals;
@@ -214,6 +214,30 @@ BOOST_AUTO_TEST_CASE(check_computations_of_scalar_product) {
   GUDHI_TEST_FLOAT_EQUALITY_CHECK(p.compute_scalar_product(q), 0.754367, epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(check_distance_and_scalar_product_matrices) {
+  std::vector<Persistence_landscape_on_grid> landscapes;
+  landscapes.push_back(Persistence_landscape_on_grid("data/file_with_diagram", 0., 1., 1000));
+  landscapes.push_back(Persistence_landscape_on_grid("data/file_with_diagram_1", 0., 1., 1000));
+  landscapes.push_back(Persistence_landscape_on_grid("data/file_with_diagram_2", 0., 1., 1000, 3u));
+  const size_t n = landscapes.size();
+  for (double p : {1., 2., std::numeric_limits<double>::max()}) {
+    std::vector<double> distances = compute_distance_matrix_of_landscapes_on_grid(landscapes, p);
+    BOOST_CHECK(distances.size() == n * n);
+    for (size_t i = 0; i != n; ++i) {
+      BOOST_CHECK(distances[i * n + i] == 0);
+      for (size_t j = 0; j != n; ++j) {
+        if (i != j) GUDHI_TEST_FLOAT_EQUALITY_CHECK(distances[i * n + j], landscapes[i].distance(landscapes[j], p));
+      }
+    }
+  }
+  std::vector<double> products = compute_inner_product_matrix_of_landscapes_on_grid(landscapes);
+  for (size_t i = 0; i != n; ++i) {
+    for (size_t j = 0; j != n; ++j) {
+      GUDHI_TEST_FLOAT_EQUALITY_CHECK(products[i * n + j], landscapes[i].compute_scalar_product(landscapes[j]));
+    }
+  }
+}
+
 // Below I am storing the code used to generate tests for that functionality.
 /*
         Persistence_landscape_on_grid l( "file_with_diagram_1" , 100 );
@@ -17,6 +17,7 @@
 
 #include <iostream>
 #include <limits>
+#include <cmath>
 
 using namespace Gudhi;
 using namespace Gudhi::Persistence_representations;
@@ -344,3 +345,47 @@ endl;
                 cout << "Scalar product : " <<  p.compute_scalar_product( &q ) << endl;
         }
 */
+
+BOOST_AUTO_TEST_CASE(check_batch_construction_and_compound_operators) {
+  std::vector<std::vector<std::pair<double, double> > > diags;
+  diags.push_back(read_persistence_intervals_in_one_dimension_from_file("data/file_with_diagram"));
+  diags.push_back(read_persistence_intervals_in_one_dimension_from_file("data/file_with_diagram_1"));
+  diags.push_back(std::vector<std::pair<double, double> >());
+  std::vector<Persistence_landscape> landscapes = construct_persistence_landscapes(diags);
+  BOOST_CHECK(landscapes.size() == diags.size());
+  for (size_t i = 0; i != diags.size(); ++i) BOOST_CHECK(landscapes[i] == Persistence_landscape(diags[i]));
+  BOOST_CHECK(landscapes[2].size() == 0);
+
+  std::vector<Persistence_landscape> truncated = construct_persistence_landscapes(diags, 3);
+  BOOST_CHECK(truncated[0].size() == 3);
+  BOOST_CHECK(truncated[0] == Persistence_landscape(diags[0], 3));
+
+  Persistence_landscape p = landscapes[0];
+  const Persistence_landscape& q = landscapes[1];
+  p += q;
+  BOOST_CHECK(p == landscapes[0] + q);
+  p -= q;
+  BOOST_CHECK(p == landscapes[0] + q - q);
+  // The compound operators also work with different numbers of levels, or with the landscape itself
+  p = truncated[0];
+  p += q;
+  BOOST_CHECK(p == truncated[0] + q);
+  p = q;
+  p -= truncated[0];
+  BOOST_CHECK(p == q - truncated[0]);
+  p = landscapes[2];
+  p -= q;
+  BOOST_CHECK(p == landscapes[2] - q);
+  p = landscapes[0];
+  p += p;
+  BOOST_CHECK(p == landscapes[0] + landscapes[0]);
+  p = landscapes[0];
+  p *= 10;
+  BOOST_CHECK(p == 10 * landscapes[0]);
+  p /= 10;
+  BOOST_CHECK(p == landscapes[0]);
+  // The distance is computed without building the difference of the landscapes
+  Persistence_landscape difference = landscapes[0] - landscapes[1];
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(compute_distance_of_landscapes(landscapes[0], landscapes[1], 2),
+                                  std::sqrt(difference.abs().compute_integral_of_landscape(2.)), epsilon);
+}
@@ -13,7 +13,11 @@
 #include <boost/test/unit_test.hpp>
 #include <gudhi/read_persistence_from_file.h>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
 
 using namespace Gudhi;
 using namespace Gudhi::Persistence_representations;
@@ -77,3 +81,29 @@ BOOST_AUTO_TEST_CASE(test_read_file_with_two_elements_per_line) {
     BOOST_CHECK(what_we_should_get[i] == what_we_get[i]);
   }
 }
+
+BOOST_AUTO_TEST_CASE(test_read_persistence_diagram_archive) {
+  const char* text_file = "data/persistence_file_with_four_entries_per_line";
+  {
+    Persistence_diagram_archive_writer writer("persistence_file_with_four_entries_per_line.pda");
+    writer.add_diagram(read_persistence_intervals_grouped_by_dimension(text_file));
+  }
+  // The archive is read as the text file it was made from, up to the order of the dimensions.
+  for (int dimension = -1; dimension != 3; ++dimension) {
+    std::vector<std::pair<double, double> > what_we_get = read_persistence_intervals_in_one_dimension_from_file(
+        "persistence_file_with_four_entries_per_line.pda", dimension, 1000);
+    std::vector<std::pair<double, double> > what_we_should_get =
+        read_persistence_intervals_in_one_dimension_from_file(text_file, dimension, 1000);
+    std::sort(what_we_get.begin(), what_we_get.end());
+    std::sort(what_we_should_get.begin(), what_we_should_get.end());
+    BOOST_CHECK(what_we_get == what_we_should_get);
+  }
+
+  std::vector<std::vector<std::pair<double, double> > > diagrams = {{{2, 0}, {1, 3}},
+                                                                    {{0, std::numeric_limits<double>::infinity()}}};
+  write_persistence_diagram_archive("two_diagrams.pda", diagrams);
+  std::vector<std::vector<std::pair<double, double> > > what_we_should_get = {{{0, 2}, {1, 3}}, {{0, 5}}};
+  BOOST_CHECK(read_persistence_intervals_in_one_dimension_from_archive("two_diagrams.pda", -1, 5) ==
+              what_we_should_get);
+  BOOST_CHECK_THROW(read_persistence_intervals_in_one_dimension_from_file("two_diagrams.pda"), std::invalid_argument);
+}
@@ -367,3 +367,38 @@ BOOST_AUTO_TEST_CASE(check_arythmetic_operations) {
   BOOST_CHECK(almost_equal(prod1.vector_in_position(4), 1.41421));
   BOOST_CHECK(almost_equal(prod1.vector_in_position(5), 1.41421));
 }
+
+BOOST_AUTO_TEST_CASE(check_largest_distances_of_large_diagrams) {
+  std::vector<std::vector<std::pair<double, double> > > diagrams(4);
+  for (size_t d = 0; d != diagrams.size(); ++d) {
+    for (size_t i = 0; i != 60 + 10 * d; ++i) {
+      // a grid of points, with many equal distances and a cluster of close points
+      double birth = (d == 0) ? 0.01 * (i % 7) : 0.1 * (i % 9) + 0.01 * d;
+      diagrams[d].push_back(std::make_pair(birth, birth + 0.05 * (i % 11) + 0.01 * d));
+    }
+  }
+  for (size_t where_to_cut : {1, 7, 100, 1000}) {
+    std::vector<Vector_distances_in_diagram<Euclidean_distance> > vectors =
+        construct_persistence_vectors<Euclidean_distance>(diagrams, where_to_cut);
+    BOOST_CHECK(vectors.size() == diagrams.size());
+    for (size_t d = 0; d != diagrams.size(); ++d) {
+      // all the values, sorted
+      const std::vector<std::pair<double, double> >& diagram = diagrams[d];
+      Euclidean_distance f;
+      std::vector<double> to_diagonal, values;
+      for (size_t i = 0; i != diagram.size(); ++i) {
+        double middle = 0.5 * (diagram[i].first + diagram[i].second);
+        to_diagonal.push_back(f(diagram[i], std::make_pair(middle, middle)));
+        values.push_back(to_diagonal[i]);
+        for (size_t j = 0; j != i; ++j) {
+          values.push_back(std::min(f(diagram[i], diagram[j]), std::min(to_diagonal[i], to_diagonal[j])));
+        }
+      }
+      std::sort(values.begin(), values.end(), std::greater<double>());
+      values.resize(std::min(values.size(), where_to_cut));
+
+      BOOST_CHECK(vectors[d].size() == values.size());
+      for (size_t i = 0; i != values.size(); ++i) BOOST_CHECK(vectors[d].vector_in_position(i) == values[i]);
+    }
+  }
+}
@@ -0,0 +1,119 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <cstdint>  // for std::int32_t
+#include <fstream>
+#include <iterator>  // for istreambuf_iterator
+#include <sstream>
+#include <stdexcept>  // for std::invalid_argument
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "hasse_boundary_matrix"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Hasse_complex.h>
+#include <gudhi/Mapped_hasse_complex.h>
+#include <gudhi/Persistent_cohomology.h>
+
+using Simplex_tree = Gudhi::Simplex_tree<>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+
+template <class FilteredComplex>
+std::string persistence_diagram(FilteredComplex& cpx) {
+  Gudhi::persistent_cohomology::Persistent_cohomology<FilteredComplex, Field_Zp> pcoh(cpx);
+  pcoh.init_coefficients(11);
+  pcoh.compute_persistent_cohomology(0.);
+  std::ostringstream diagram;
+  pcoh.output_diagram(diagram);
+  return diagram.str();
+}
+
+std::string file_content(std::string const& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void read_simplex_tree(Simplex_tree& st) {
+  // file is copied in CMakeLists.txt
+  std::ifstream simplex_tree_stream("simplex_tree_file_for_unit_test.txt");
+  simplex_tree_stream >> st;
+}
+
+BOOST_AUTO_TEST_CASE( hasse_boundary_matrix_round_trip )
+{
+  Simplex_tree st;
+  read_simplex_tree(st);
+  Gudhi::write_hasse_boundary_matrix("simplex_tree.hbm", st);
+  BOOST_CHECK(Gudhi::is_hasse_boundary_matrix("simplex_tree.hbm"));
+  BOOST_CHECK(!Gudhi::is_hasse_boundary_matrix("simplex_tree_file_for_unit_test.txt"));
+
+  Gudhi::Mapped_hasse_complex mapped_cpx("simplex_tree.hbm");
+  BOOST_CHECK(mapped_cpx.num_simplices() == st.num_simplices());
+  BOOST_CHECK(mapped_cpx.dimension() == st.dimension());
+
+  // The writer sets the keys to the positions in the filtration
+  int num_vertices = 0;
+  for (auto sh : st.filtration_simplex_range()) {
+    int mapped_sh = st.key(sh);
+    BOOST_CHECK(mapped_cpx.filtration(mapped_sh) == st.filtration(sh));
+    BOOST_CHECK(mapped_cpx.dimension(mapped_sh) == st.dimension(sh));
+    std::vector<int> boundary;
+    for (auto b_sh : st.boundary_simplex_range(sh)) boundary.push_back(st.key(b_sh));
+    BOOST_CHECK(std::vector<int>(mapped_cpx.boundary_simplex_range(mapped_sh).begin(),
+                                 mapped_cpx.boundary_simplex_range(mapped_sh).end()) == boundary);
+    if (st.dimension(sh) == 0) ++num_vertices;
+  }
+  BOOST_CHECK(static_cast<int>(mapped_cpx.skeleton_simplex_range(0).size()) == num_vertices);
+
+  // A Hasse_complex built from the mapped complex, whose keys are still the positions in the filtration, has the same
+  // persistence and is written to the same file
+  Gudhi::Hasse_complex<> hcpx(mapped_cpx);
+  std::string diagram = persistence_diagram(st);
+  BOOST_CHECK(persistence_diagram(mapped_cpx) == diagram);
+  BOOST_CHECK(persistence_diagram(hcpx) == diagram);
+  Gudhi::write_hasse_boundary_matrix("hasse_complex.hbm", hcpx);
+  BOOST_CHECK(file_content("hasse_complex.hbm") == file_content("simplex_tree.hbm"));
+}
+
+BOOST_AUTO_TEST_CASE( hasse_boundary_matrix_empty_complex )
+{
+  Simplex_tree st;
+  Gudhi::write_hasse_boundary_matrix("empty.hbm", st);
+  Gudhi::Mapped_hasse_complex mapped_cpx("empty.hbm");
+  BOOST_CHECK(mapped_cpx.num_simplices() == 0);
+  BOOST_CHECK(mapped_cpx.dimension() == -1);
+  BOOST_CHECK(mapped_cpx.filtration_simplex_range().empty());
+}
+
+BOOST_AUTO_TEST_CASE( hasse_boundary_matrix_invalid_files )
+{
+  BOOST_CHECK_THROW(Gudhi::Mapped_hasse_complex("does_not_exist.hbm"), std::invalid_argument);
+  BOOST_CHECK_THROW(Gudhi::Mapped_hasse_complex("simplex_tree_file_for_unit_test.txt"), std::invalid_argument);
+
+  Simplex_tree st;
+  read_simplex_tree(st);
+  Gudhi::write_hasse_boundary_matrix("valid.hbm", st);
+  std::string content = file_content("valid.hbm");
+
+  std::ofstream("truncated.hbm", std::ios::binary) << content.substr(0, content.size() - 1);
+  BOOST_CHECK_THROW(Gudhi::Mapped_hasse_complex("truncated.hbm"), std::invalid_argument);
+
+  // The last boundary entry, i.e. a face of the last simplex, refers to the simplex itself
+  std::size_t num_simplices = st.num_simplices();
+  std::int32_t last_simplex = static_cast<std::int32_t>(num_simplices - 1);
+  std::string forward_boundary = content;
+  forward_boundary.replace(content.size() - 4 * num_simplices - 4, 4, reinterpret_cast<char const*>(&last_simplex),
+                           4);
+  std::ofstream("forward_boundary.hbm", std::ios::binary) << forward_boundary;
+  BOOST_CHECK_THROW(Gudhi::Mapped_hasse_complex("forward_boundary.hbm"), std::invalid_argument);
+}
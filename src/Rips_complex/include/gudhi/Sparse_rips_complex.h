@@ -14,6 +14,7 @@
 #include <gudhi/Debug_utils.h>
 #include <gudhi/graph_simplicial_complex.h>
 #include <gudhi/choose_n_farthest_points.h>
+#include <gudhi/Vantage_point_tree.h>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/range/metafunctions.hpp>
@@ -73,6 +74,29 @@ class Sparse_rips_complex {
     compute_sparse_graph(dist_fun, epsilon, mini, maxi);
   }
 
+  /** \brief Sparse_rips_complex constructor from a metric tree.
+   *
+   * Same as the constructor from a list of points, but the farthest point sampling and the search of the edges only
+   * evaluate the distances of the pairs of points that are close enough, through radius queries in the tree.
+   * The distance must be a metric.
+   *
+   * @param[in] tree Metric tree built on all the points.
+   * @param[in] epsilon Approximation parameter. epsilon must be positive.
+   * @param[in] mini Minimal filtration value. Ignore anything below this scale. This is a less efficient version of `Gudhi::subsampling::sparsify_point_set()`.
+   * @param[in] maxi Maximal filtration value. Ignore anything above this scale.
+   *
+   */
+  template <typename RandomAccessPointRange, typename Distance>
+  Sparse_rips_complex(const spatial_searching::Vantage_point_tree<RandomAccessPointRange, Distance>& tree,
+                      double epsilon, Filtration_value mini=-std::numeric_limits<Filtration_value>::infinity(),
+                      Filtration_value maxi=std::numeric_limits<Filtration_value>::infinity())
+      : epsilon_(epsilon) {
+    GUDHI_CHECK(epsilon > 0, "epsilon must be positive");
+    subsampling::choose_n_farthest_points_metric(tree, -1, -1, std::back_inserter(sorted_points),
+                                                 std::back_inserter(params));
+    compute_sparse_graph_from_tree(tree, epsilon, mini, maxi);
+  }
+
   /** \brief Sparse_rips_complex constructor from a distance matrix.
    *
    * @param[in] distance_matrix Range of range of distances.
@@ -188,6 +212,62 @@ class Sparse_rips_complex {
     }
   }
 
+  // Same as compute_sparse_graph, but only the pairs of points closer than 2 * li / epsilon are considered.
+  template <typename Metric_tree>
+  void compute_sparse_graph_from_tree(const Metric_tree& tree, double epsilon, Filtration_value mini,
+                                      Filtration_value maxi) {
+    const auto& points = sorted_points; // convenience alias
+    const int n = boost::size(points);
+    double cst = epsilon * (1 - epsilon) / 2;
+    graph_.~Graph();
+    new (&graph_) Graph(n);
+    typename boost::graph_traits<Graph>::vertex_iterator v_i, v_e;
+    for (std::tie(v_i, v_e) = vertices(graph_); v_i != v_e; ++v_i) {
+      put(vertex_filtration_t(), graph_, *v_i, 0);
+    }
+
+    // rank[original_order]=sorted_order
+    std::vector<int> rank(n);
+    for (int i = 0; i < n; ++i) rank[points[i]] = i;
+    // Points after this rank are ignored, as in compute_sparse_graph
+    int end = 0;
+    while (end < n && params[end] >= mini) ++end;
+
+    std::vector<typename Metric_tree::Neighbor> neighbors;
+    for (int i = 0; i < end; ++i) {
+      auto&& pi = points[i];
+      auto li = params[i];
+      // Edges with d * epsilon > li + lj are skipped, and lj <= li
+      neighbors.clear();
+      tree.all_near_neighbors_with_distances(*(std::begin(tree.points()) + pi), 2 * li / epsilon,
+                                             std::back_inserter(neighbors));
+      for (auto const& nghb : neighbors) {
+        int j = rank[nghb.first];
+        if (j <= i || j >= end) continue;
+        auto&& pj = points[j];
+        auto d = nghb.second;
+        auto lj = params[j];
+        GUDHI_CHECK(lj <= li, "Bad furthest point sorting");
+        Filtration_value alpha;
+
+        // The paper has d/2 and d-lj/e to match the Cech, but we use doubles to match the Rips
+        if (d * epsilon <= 2 * lj)
+          alpha = d;
+        else if (d * epsilon > li + lj)
+          continue;
+        else {
+          alpha = (d - lj / epsilon) * 2;
+          // Keep the test exactly the same as in block to avoid inconsistencies
+          if (epsilon < 1 && alpha * cst > lj)
+            continue;
+        }
+
+        if (alpha <= maxi)
+          add_edge(pi, pj, alpha, graph_);
+      }
+    }
+  }
+
   Graph graph_;
   double epsilon_;
   // Because of the arbitrary split between constructor and create_complex
@@ -285,6 +285,25 @@ BOOST_AUTO_TEST_CASE(Sparse_rips_complex_from_points) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(Sparse_rips_complex_from_metric_tree) {
+  Gudhi::Points_off_reader<Point> off_reader("alphacomplexdoc.off");
+  auto const& points = off_reader.get_point_cloud();
+  Gudhi::spatial_searching::Vantage_point_tree<Vector_of_points, Gudhi::Euclidean_distance> tree(points);
+
+  // .001 is small enough that both complexes match the exact Rips
+  Sparse_rips_complex sparse_rips(points, Gudhi::Euclidean_distance(), .001);
+  Sparse_rips_complex sparse_rips_from_tree(tree, .001);
+
+  std::clog << "========== Sparse_rips_complex_from_metric_tree ==========" << std::endl;
+  Simplex_tree st;
+  sparse_rips.create_complex(st, 3);
+  Simplex_tree st_from_tree;
+  sparse_rips_from_tree.create_complex(st_from_tree, 3);
+  std::clog << "st.num_simplices()=" << st.num_simplices() << std::endl;
+  std::clog << "st_from_tree.num_simplices()=" << st_from_tree.num_simplices() << std::endl;
+  BOOST_CHECK(st == st_from_tree);
+}
+
 BOOST_AUTO_TEST_CASE(Rips_doc_csv_file) {
   // ----------------------------------------------------------------------------
   //
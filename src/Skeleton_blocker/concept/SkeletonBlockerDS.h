@@ -106,6 +106,19 @@ struct SkeletonBlockerDS {
 
     friend ostream& operator<<(ostream& o, const Simple_edge & v);
   };
+
+  /**
+   * \brief Optional, the boost selector of the out edge lists of the graph, boost::setS if not defined.
+   * Skeleton_blocker_flat_traits uses sorted_vecS, a vector sorted by target vertex.
+   */
+  typedef boost::setS Out_edge_list_selector;
+
+  /**
+   * \brief Optional, the selector of the map from the vertices to the blockers, Multimap_blocker_map_selector if not
+   * defined. Skeleton_blocker_flat_traits uses Vertex_indexed_blocker_map_selector, which stores the blockers in an
+   * arena.
+   */
+  typedef Multimap_blocker_map_selector Blocker_map_selector;
 };
 
 }  // namespace skeleton_blocker
@@ -18,6 +18,7 @@
 
 #include <gudhi/Skeleton_blocker/Skeleton_blocker_simple_traits.h>
 #include <gudhi/Skeleton_blocker/Skeleton_blocker_simple_geometric_traits.h>
+#include <gudhi/Skeleton_blocker/Skeleton_blocker_flat_traits.h>
 
 #include <gudhi/Debug_utils.h>
 
@@ -94,6 +95,12 @@ edge contractions
 The class Skeleton_blocker_geometric_complex supports the same methods as Skeleton_blocker_complex
 and point access in addition.
 
+Both classes are parameterized by the traits of the complex. With Skeleton_blocker_simple_traits, the neighbors of
+a vertex are stored in a std::set and the blockers in a std::multimap. Skeleton_blocker_flat_traits (and
+Skeleton_blocker_flat_geometric_traits) stores the neighbors of a vertex in a sorted vector and the blockers in
+vectors indexed by the vertices, the blockers being allocated in an arena. It gives the same complexes and is faster
+for large meshes, whose vertices have a low degree, for instance when simplifying them with edge contractions.
+
 
 
 \subsection skblvisitor Visitor
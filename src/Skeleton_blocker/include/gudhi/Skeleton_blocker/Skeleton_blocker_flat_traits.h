@@ -0,0 +1,57 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef SKELETON_BLOCKER_SKELETON_BLOCKER_FLAT_TRAITS_H_
+#define SKELETON_BLOCKER_SKELETON_BLOCKER_FLAT_TRAITS_H_
+
+#include <gudhi/Skeleton_blocker/Skeleton_blocker_simple_traits.h>
+#include <gudhi/Skeleton_blocker/Skeleton_blocker_simple_geometric_traits.h>
+#include <gudhi/Skeleton_blocker/internal/Blocker_map.h>
+#include <gudhi/Skeleton_blocker/internal/Sorted_out_edge_list.h>
+
+namespace Gudhi {
+
+namespace skeleton_blocker {
+
+/**
+ * @extends SkeletonBlockerDS
+ * @ingroup skbl
+ * @brief Traits similar to Skeleton_blocker_simple_traits, with a flat storage of the complex.
+ * @details The neighbors of a vertex are stored in a sorted vector instead of a std::set, which is faster for the
+ * low degree graphs of meshes, and the blockers are stored in a vector indexed by the vertices and allocated in an arena
+ * instead of a std::multimap of heap allocated simplices.
+ *
+ * The blockers removed with `Skeleton_blocker_complex::remove_blocker` remain owned by the complex and must not be
+ * deleted.
+ */
+struct Skeleton_blocker_flat_traits : public Skeleton_blocker_simple_traits {
+  typedef sorted_vecS Out_edge_list_selector;
+  typedef Vertex_indexed_blocker_map_selector Blocker_map_selector;
+};
+
+/**
+ * @extends SkeletonBlockerGeometricDS
+ * @ingroup skbl
+ * @brief Traits similar to Skeleton_blocker_simple_geometric_traits, with the flat storage of
+ * Skeleton_blocker_flat_traits.
+ */
+template<typename GeometryTrait>
+struct Skeleton_blocker_flat_geometric_traits : public Skeleton_blocker_simple_geometric_traits<GeometryTrait> {
+  typedef sorted_vecS Out_edge_list_selector;
+  typedef Vertex_indexed_blocker_map_selector Blocker_map_selector;
+};
+
+}  // namespace skeleton_blocker
+
+namespace skbl = skeleton_blocker;
+
+}  // namespace Gudhi
+
+#endif  // SKELETON_BLOCKER_SKELETON_BLOCKER_FLAT_TRAITS_H_
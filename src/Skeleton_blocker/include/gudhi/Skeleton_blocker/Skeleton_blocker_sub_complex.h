@@ -112,7 +112,7 @@ class Skeleton_blocker_sub_complex : public ComplexType {
   void add_blocker(const Root_simplex_handle& blocker_root) {
     auto blocker_sub = this->get_address(blocker_root);
     assert(blocker_sub);
-    this->add_blocker(new Simplex(*blocker_sub));
+    this->add_blocker(*blocker_sub);
   }
 
  public:
@@ -148,7 +148,7 @@ class Skeleton_blocker_sub_complex : public ComplexType {
         Root_simplex_handle blocker_root(parent_complex.get_id(*(blocker)));
         Simplex blocker_restr(
                               *(this->get_simplex_address(blocker_root)));
-        this->add_blocker(new Simplex(blocker_restr));
+        this->add_blocker(blocker_restr);
       }
     }
   }
@@ -0,0 +1,251 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef SKELETON_BLOCKER_INTERNAL_BLOCKER_MAP_H_
+#define SKELETON_BLOCKER_INTERNAL_BLOCKER_MAP_H_
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <utility>  // for std::pair
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+namespace skeleton_blocker {
+
+/**
+ * @brief Map from the vertices to the blockers passing through them, as a std::multimap.
+ * The blockers are allocated one by one on the heap.
+ */
+template<typename Vertex_handle, typename Simplex>
+class Multimap_blocker_map : public std::multimap<Vertex_handle, Simplex*> {
+ public:
+  Simplex* allocate(const Simplex& blocker) {
+    return new Simplex(blocker);
+  }
+
+  void deallocate(Simplex* blocker) {
+    delete blocker;
+  }
+};
+
+/**
+ * @brief Map from the vertices to the blockers passing through them, stored in a vector indexed by the vertices.
+ * It offers the part of the std::multimap interface used by Skeleton_blocker_complex, iterating in the same order.
+ * The blockers are allocated in an arena owned by the map, and their memory is reused after deallocation.
+ */
+template<typename Vertex_handle, typename Simplex>
+class Vertex_indexed_blocker_map {
+ public:
+  typedef std::pair<Vertex_handle, Simplex*> value_type;
+
+ private:
+  typedef std::vector<std::vector<value_type>> Rows;
+
+  // Iterates through the rows in the order of the vertices and is then never on the end of a row: the end of the map
+  // is the position (rows.size(), 0). The iterators of the range of a vertex stay in its row instead, the end of the
+  // range is the end of the row.
+  template<typename RowsType, typename Value>
+  class Row_iterator : public boost::iterator_facade<Row_iterator<RowsType, Value>, Value,
+                                                     boost::forward_traversal_tag> {
+   public:
+    Row_iterator() : rows_(nullptr), row_(0), position_(0), within_row_(false) { }
+
+    Row_iterator(RowsType* rows, std::size_t row, std::size_t position, bool within_row = false)
+        : rows_(rows), row_(row), position_(position), within_row_(within_row) {
+      if (!within_row_) skip_empty_rows();
+    }
+
+   private:
+    friend class boost::iterator_core_access;
+    friend class Vertex_indexed_blocker_map;
+
+    void skip_empty_rows() {
+      while (row_ < rows_->size() && position_ >= (*rows_)[row_].size()) {
+        ++row_;
+        position_ = 0;
+      }
+    }
+
+    void increment() {
+      ++position_;
+      if (!within_row_) skip_empty_rows();
+    }
+
+    bool equal(const Row_iterator& other) const {
+      return row_ == other.row_ && position_ == other.position_;
+    }
+
+    Value& dereference() const {
+      return (*rows_)[row_][position_];
+    }
+
+    RowsType* rows_;
+    std::size_t row_;
+    std::size_t position_;
+    bool within_row_;
+  };
+
+ public:
+  typedef Row_iterator<Rows, value_type> iterator;
+  typedef Row_iterator<const Rows, const value_type> const_iterator;
+
+  Vertex_indexed_blocker_map() : size_(0), first_row_(0) { }
+  // The map owns the blockers
+  Vertex_indexed_blocker_map(const Vertex_indexed_blocker_map&) = delete;
+  Vertex_indexed_blocker_map& operator=(const Vertex_indexed_blocker_map&) = delete;
+
+  Simplex* allocate(const Simplex& blocker) {
+    if (free_blockers_.empty()) {
+      arena_.push_back(blocker);
+      return &arena_.back();
+    }
+    Simplex* res = free_blockers_.back();
+    free_blockers_.pop_back();
+    *res = blocker;
+    return res;
+  }
+
+  void deallocate(Simplex* blocker) {
+    *blocker = Simplex();
+    free_blockers_.push_back(blocker);
+  }
+
+  void insert(const value_type& vertex_blocker) {
+    std::size_t row = vertex_blocker.first.vertex;
+    if (row >= rows_.size()) rows_.resize(row + 1);
+    rows_[row].push_back(vertex_blocker);
+    ++size_;
+    if (row < first_row_) first_row_ = row;
+  }
+
+  void erase(iterator position) {
+    auto& row = rows_[position.row_];
+    row.erase(row.begin() + position.position_);
+    --size_;
+  }
+
+  iterator begin() { return iterator(&rows_, first_non_empty_row(), 0); }
+  iterator end() { return iterator(&rows_, rows_.size(), 0); }
+  const_iterator begin() const { return const_iterator(&rows_, first_row_, 0); }
+  const_iterator end() const { return const_iterator(&rows_, rows_.size(), 0); }
+
+  iterator lower_bound(Vertex_handle v) { return iterator(&rows_, row_of(v), 0, true); }
+  iterator upper_bound(Vertex_handle v) { return iterator(&rows_, row_of(v), row_size(row_of(v)), true); }
+  const_iterator lower_bound(Vertex_handle v) const { return const_iterator(&rows_, row_of(v), 0, true); }
+  const_iterator upper_bound(Vertex_handle v) const {
+    return const_iterator(&rows_, row_of(v), row_size(row_of(v)), true);
+  }
+
+  const_iterator find(Vertex_handle v) const {
+    std::size_t row = row_of(v);
+    if (row_size(row) > 0) return const_iterator(&rows_, row, 0);
+    return end();
+  }
+
+  bool empty() const { return size_ == 0; }
+
+  std::size_t size() const { return size_; }
+
+  /** Removes all the pairs, and frees the arena: the blockers must have been deallocated. */
+  void clear() {
+    rows_.clear();
+    size_ = 0;
+    first_row_ = 0;
+    arena_.clear();
+    free_blockers_.clear();
+  }
+
+ private:
+  std::size_t row_of(Vertex_handle v) const {
+    std::size_t row = v.vertex;
+    return (row < rows_.size()) ? row : rows_.size();
+  }
+
+  std::size_t row_size(std::size_t row) const {
+    return (row < rows_.size()) ? rows_[row].size() : 0;
+  }
+
+  // The rows before first_row_ are empty, it is moved forward by begin() so that emptying the map from its beginning
+  // is linear. The const methods do not modify it, they can be called concurrently.
+  std::size_t first_non_empty_row() {
+    while (first_row_ < rows_.size() && rows_[first_row_].empty()) ++first_row_;
+    return first_row_;
+  }
+
+  Rows rows_;
+  std::size_t size_;
+  std::size_t first_row_;
+  std::deque<Simplex> arena_;  // a deque does not move its elements when growing
+  std::vector<Simplex*> free_blockers_;
+};
+
+/** @brief Selects Multimap_blocker_map as the blocker map of a SkeletonBlockerDS. */
+struct Multimap_blocker_map_selector {
+  template<typename Vertex_handle, typename Simplex>
+  struct apply {
+    typedef Multimap_blocker_map<Vertex_handle, Simplex> type;
+  };
+};
+
+/** @brief Selects Vertex_indexed_blocker_map as the blocker map of a SkeletonBlockerDS. */
+struct Vertex_indexed_blocker_map_selector {
+  template<typename Vertex_handle, typename Simplex>
+  struct apply {
+    typedef Vertex_indexed_blocker_map<Vertex_handle, Simplex> type;
+  };
+};
+
+template<typename T>
+struct Skeleton_blocker_void {
+  typedef void type;
+};
+
+/**
+ * @brief The boost out edge list selector of the graph of a SkeletonBlockerDS: SkeletonBlockerDS::Out_edge_list_selector
+ * if defined, boost::setS otherwise.
+ */
+template<typename SkeletonBlockerDS, typename = void>
+struct Out_edge_list_selector_of {
+  typedef boost::setS type;
+};
+
+template<typename SkeletonBlockerDS>
+struct Out_edge_list_selector_of<SkeletonBlockerDS,
+                                 typename Skeleton_blocker_void<typename SkeletonBlockerDS::Out_edge_list_selector>::type> {
+  typedef typename SkeletonBlockerDS::Out_edge_list_selector type;
+};
+
+/**
+ * @brief The blocker map selector of a SkeletonBlockerDS: SkeletonBlockerDS::Blocker_map_selector if defined,
+ * Multimap_blocker_map_selector otherwise.
+ */
+template<typename SkeletonBlockerDS, typename = void>
+struct Blocker_map_selector_of {
+  typedef Multimap_blocker_map_selector type;
+};
+
+template<typename SkeletonBlockerDS>
+struct Blocker_map_selector_of<SkeletonBlockerDS,
+                               typename Skeleton_blocker_void<typename SkeletonBlockerDS::Blocker_map_selector>::type> {
+  typedef typename SkeletonBlockerDS::Blocker_map_selector type;
+};
+
+}  // namespace skeleton_blocker
+
+namespace skbl = skeleton_blocker;
+
+}  // namespace Gudhi
+
+#endif  // SKELETON_BLOCKER_INTERNAL_BLOCKER_MAP_H_
@@ -0,0 +1,63 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef SKELETON_BLOCKER_INTERNAL_SORTED_OUT_EDGE_LIST_H_
+#define SKELETON_BLOCKER_INTERNAL_SORTED_OUT_EDGE_LIST_H_
+
+#include <boost/graph/adjacency_list.hpp>
+
+#include <vector>
+#include <algorithm>  // for std::upper_bound
+
+namespace Gudhi {
+
+namespace skeleton_blocker {
+
+/**
+ * @brief Out edge list of a boost graph stored in a vector sorted by target vertex.
+ * @details The boost graph library sees it as a std::vector, but the edges are inserted at their place so that the
+ * neighbors of a vertex are iterated in increasing order, as with boost::setS. It does not check parallel edges,
+ * Skeleton_blocker_complex does it before adding an edge.
+ */
+template<typename StoredEdge>
+class Sorted_out_edge_list : public std::vector<StoredEdge> {
+ public:
+  // Called by boost::graph_detail::push to add an edge.
+  void push_back(const StoredEdge& edge) {
+    this->insert(std::upper_bound(this->begin(), this->end(), edge), edge);
+  }
+};
+
+/**
+ * @brief Boost graph selector of a Sorted_out_edge_list out edge list.
+ */
+struct sorted_vecS { };
+
+}  // namespace skeleton_blocker
+
+namespace skbl = skeleton_blocker;
+
+}  // namespace Gudhi
+
+namespace boost {
+
+template<typename ValueType>
+struct container_gen<Gudhi::skeleton_blocker::sorted_vecS, ValueType> {
+  typedef Gudhi::skeleton_blocker::Sorted_out_edge_list<ValueType> type;
+};
+
+template<>
+struct parallel_edge_traits<Gudhi::skeleton_blocker::sorted_vecS> {
+  typedef allow_parallel_edge_tag type;
+};
+
+}  // namespace boost
+
+#endif  // SKELETON_BLOCKER_INTERNAL_SORTED_OUT_EDGE_LIST_H_
@@ -19,6 +19,7 @@
 #include <gudhi/Skeleton_blocker/Skeleton_blocker_complex_visitor.h>
 #include <gudhi/Skeleton_blocker/internal/Top_faces.h>
 #include <gudhi/Skeleton_blocker/internal/Trie.h>
+#include <gudhi/Skeleton_blocker/internal/Blocker_map.h>
 #include <gudhi/Debug_utils.h>
 
 #include <boost/graph/adjacency_list.hpp>
@@ -92,7 +93,7 @@ class Skeleton_blocker_complex {
   typedef typename Simplex::Simplex_vertex_const_iterator Simplex_handle_iterator;
 
  protected:
-  typedef typename boost::adjacency_list<boost::setS,  // edges
+  typedef typename boost::adjacency_list<typename Out_edge_list_selector_of<SkeletonBlockerDS>::type,  // edges
   boost::vecS,  // vertices
   boost::undirectedS, Graph_vertex, Graph_edge> Graph;
   // todo/remark : edges are not sorted, it heavily penalizes computation for SuperiorLink
@@ -114,10 +115,11 @@ class Skeleton_blocker_complex {
   typedef typename boost::graph_traits<Graph>::edge_descriptor Edge_handle;
 
  protected:
-  typedef std::multimap<Vertex_handle, Simplex *> BlockerMap;
-  typedef typename std::multimap<Vertex_handle, Simplex *>::value_type BlockerPair;
-  typedef typename std::multimap<Vertex_handle, Simplex *>::iterator BlockerMapIterator;
-  typedef typename std::multimap<Vertex_handle, Simplex *>::const_iterator BlockerMapConstIterator;
+  typedef typename Blocker_map_selector_of<SkeletonBlockerDS>::type::template apply<Vertex_handle, Simplex>::type
+  BlockerMap;
+  typedef typename BlockerMap::value_type BlockerPair;
+  typedef typename BlockerMap::iterator BlockerMapIterator;
+  typedef typename BlockerMap::const_iterator BlockerMapConstIterator;
 
  protected:
   size_t num_vertices_;
@@ -673,7 +675,7 @@ class Skeleton_blocker_complex {
     } else {
       if (visitor)
         visitor->on_add_blocker(blocker);
-      Blocker_handle blocker_pt = new Simplex(blocker);
+      Blocker_handle blocker_pt = blocker_map_.allocate(blocker);
       num_blockers_++;
       auto vertex = blocker_pt->begin();
       while (vertex != blocker_pt->end()) {
@@ -771,7 +773,7 @@ class Skeleton_blocker_complex {
     if (visitor)
       visitor->on_delete_blocker(sigma);
     remove_blocker(sigma);
-    delete sigma;
+    blocker_map_.deallocate(sigma);
   }
 
   /**
@@ -1447,17 +1449,13 @@ class Skeleton_blocker_complex {
   /**
    * @brief Iterator over the blockers adjacent to a vertex
    */
-  typedef Blocker_iterator_around_vertex_internal<
-  typename std::multimap<Vertex_handle, Simplex *>::iterator,
-  Blocker_handle>
+  typedef Blocker_iterator_around_vertex_internal<BlockerMapIterator, Blocker_handle>
   Complex_blocker_around_vertex_iterator;
 
   /**
    * @brief Iterator over (constant) blockers adjacent to a vertex
    */
-  typedef Blocker_iterator_around_vertex_internal<
-  typename std::multimap<Vertex_handle, Simplex *>::const_iterator,
-  const Blocker_handle>
+  typedef Blocker_iterator_around_vertex_internal<BlockerMapConstIterator, const Blocker_handle>
   Const_complex_blocker_around_vertex_iterator;
 
   typedef boost::iterator_range <Complex_blocker_around_vertex_iterator> Complex_blocker_around_vertex_range;
@@ -1487,17 +1485,13 @@ class Skeleton_blocker_complex {
   /**
    * @brief Iterator over the blockers.
    */
-  typedef Blocker_iterator_internal<
-  typename std::multimap<Vertex_handle, Simplex *>::iterator,
-  Blocker_handle>
+  typedef Blocker_iterator_internal<BlockerMapIterator, Blocker_handle>
   Complex_blocker_iterator;
 
   /**
    * @brief Iterator over the (constant) blockers.
    */
-  typedef Blocker_iterator_internal<
-  typename std::multimap<Vertex_handle, Simplex *>::const_iterator,
-  const Blocker_handle>
+  typedef Blocker_iterator_internal<BlockerMapConstIterator, const Blocker_handle>
   Const_complex_blocker_iterator;
 
   typedef boost::iterator_range <Complex_blocker_iterator> Complex_blocker_range;
@@ -237,7 +237,7 @@ ComplexType> {
                   break;
               }
               if (is_new_blocker)
-                this->add_blocker(new Simplex(*sigma_link));
+                this->add_blocker(*sigma_link);
             }
           }
         }
@@ -77,8 +77,10 @@ void Skeleton_blocker_complex<SkeletonBlockerDS>::remove_popable_blockers(Vertex
     blocker_popable_found = false;
     for (auto block : this->blocker_range(v)) {
       if (is_popable_blocker(block)) {
+        // the range is invalidated by the removal of the blocker
         this->delete_blocker(block);
         blocker_popable_found = true;
+        break;
       }
     }
   }
@@ -0,0 +1,138 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "skeleton_blocker_flat_complex"
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <gudhi/Skeleton_blocker.h>
+
+typedef Gudhi::skeleton_blocker::Skeleton_blocker_complex<Gudhi::skeleton_blocker::Skeleton_blocker_simple_traits>
+    Simple_complex;
+typedef Gudhi::skeleton_blocker::Skeleton_blocker_complex<Gudhi::skeleton_blocker::Skeleton_blocker_flat_traits>
+    Flat_complex;
+typedef boost::mpl::list<Simple_complex, Flat_complex> list_of_complex_types;
+
+template<typename Complex>
+void build_complete(int n, Complex& complex) {
+  typedef typename Complex::Vertex_handle Vertex_handle;
+  complex.clear();
+  for (int i = 0; i < n; i++)
+    complex.add_vertex();
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < i; j++)
+      complex.add_edge_without_blockers(Vertex_handle(i), Vertex_handle(j));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(flat_complex_blockers, Complex, list_of_complex_types) {
+  typedef typename Complex::Vertex_handle Vertex_handle;
+  typedef typename Complex::Simplex Simplex;
+  Complex complex;
+  build_complete(5, complex);
+  // boundary of the tetrahedra 0123 and 1234
+  complex.add_blocker(Simplex(Vertex_handle(0), Vertex_handle(1), Vertex_handle(2), Vertex_handle(3)));
+  complex.add_blocker(Simplex(Vertex_handle(1), Vertex_handle(2), Vertex_handle(3), Vertex_handle(4)));
+  BOOST_CHECK(complex.num_blockers() == 2);
+  BOOST_CHECK(complex.contains_blocker(Simplex(Vertex_handle(1), Vertex_handle(2), Vertex_handle(3),
+                                               Vertex_handle(4))));
+  BOOST_CHECK(!complex.contains(Simplex(Vertex_handle(0), Vertex_handle(1), Vertex_handle(2), Vertex_handle(3))));
+  BOOST_CHECK(complex.contains(Simplex(Vertex_handle(0), Vertex_handle(1), Vertex_handle(2))));
+
+  int num_blockers_around_2 = 0;
+  for (auto blocker : complex.const_blocker_range(Vertex_handle(2))) {
+    BOOST_CHECK(blocker->contains(Vertex_handle(2)));
+    ++num_blockers_around_2;
+  }
+  BOOST_CHECK(num_blockers_around_2 == 2);
+  // the last vertex with a blocker and a new vertex without blocker
+  BOOST_CHECK(complex.const_blocker_range(Vertex_handle(4)).begin() !=
+              complex.const_blocker_range(Vertex_handle(4)).end());
+  Vertex_handle isolated = complex.add_vertex();
+  BOOST_CHECK(complex.const_blocker_range(isolated).begin() == complex.const_blocker_range(isolated).end());
+
+  // the memory of the removed blockers is reused by the new ones
+  // the blocker 0123 is the only one passing through 0
+  complex.delete_blocker(*complex.blocker_range(Vertex_handle(0)).begin());
+  complex.add_blocker(Simplex(Vertex_handle(0), Vertex_handle(1), Vertex_handle(4)));
+  BOOST_CHECK(complex.num_blockers() == 2);
+  BOOST_CHECK(!complex.contains(Simplex(Vertex_handle(0), Vertex_handle(1), Vertex_handle(4))));
+  BOOST_CHECK(complex.contains(Simplex(Vertex_handle(0), Vertex_handle(1), Vertex_handle(2), Vertex_handle(3))));
+
+  Complex copy(complex);
+  BOOST_CHECK(copy == complex);
+  complex.remove_blockers();
+  BOOST_CHECK(complex.num_blockers() == 0);
+  BOOST_CHECK(copy.num_blockers() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(flat_complex_contractions_as_simple_complex) {
+  // The same random contractions give the same complex with both backends
+  std::mt19937 gen(5);
+  const int n = 40;
+  std::uniform_int_distribution<int> vertex_dis(0, n - 1);
+  std::bernoulli_distribution edge_dis(0.3);
+
+  Simple_complex simple_complex;
+  Flat_complex flat_complex;
+  for (int i = 0; i < n; i++) {
+    simple_complex.add_vertex();
+    flat_complex.add_vertex();
+  }
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < i; j++)
+      if (edge_dis(gen)) {
+        simple_complex.add_edge_without_blockers(Simple_complex::Vertex_handle(i), Simple_complex::Vertex_handle(j));
+        flat_complex.add_edge_without_blockers(Flat_complex::Vertex_handle(i), Flat_complex::Vertex_handle(j));
+      }
+  for (int k = 0; k < 100; k++) {
+    int a = vertex_dis(gen), b = vertex_dis(gen), c = vertex_dis(gen);
+    if (a == b || b == c || a == c) continue;
+    Simple_complex::Simplex simple_triangle;
+    Flat_complex::Simplex flat_triangle;
+    for (int v : {a, b, c}) {
+      simple_triangle.add_vertex(Simple_complex::Vertex_handle(v));
+      flat_triangle.add_vertex(Flat_complex::Vertex_handle(v));
+    }
+    if (simple_complex.contains_edges(simple_triangle) && !simple_complex.contains_blocker(simple_triangle)) {
+      simple_complex.add_blocker(simple_triangle);
+      flat_complex.add_blocker(flat_triangle);
+    }
+  }
+  BOOST_CHECK(simple_complex.num_blockers() == flat_complex.num_blockers());
+  BOOST_CHECK(simple_complex.num_simplices() == flat_complex.num_simplices());
+
+  int num_contractions = 0;
+  for (int k = 0; k < 400; k++) {
+    int a = vertex_dis(gen), b = vertex_dis(gen);
+    Simple_complex::Vertex_handle simple_a(a), simple_b(b);
+    Flat_complex::Vertex_handle flat_a(a), flat_b(b);
+    if (a == b || !simple_complex.contains_edge(simple_a, simple_b)) continue;
+    BOOST_CHECK(flat_complex.contains_edge(flat_a, flat_b));
+    BOOST_CHECK(simple_complex.link_condition(simple_a, simple_b) == flat_complex.link_condition(flat_a, flat_b));
+    simple_complex.contract_edge(simple_a, simple_b);
+    flat_complex.contract_edge(flat_a, flat_b);
+    ++num_contractions;
+    BOOST_CHECK(simple_complex.num_vertices() == flat_complex.num_vertices());
+    BOOST_CHECK(simple_complex.num_edges() == flat_complex.num_edges());
+    BOOST_CHECK(simple_complex.num_blockers() == flat_complex.num_blockers());
+  }
+  std::clog << num_contractions << " contractions, " << flat_complex.num_vertices() << " vertices and "
+            << flat_complex.num_blockers() << " blockers left" << std::endl;
+  BOOST_CHECK(num_contractions > 0);
+  BOOST_CHECK(simple_complex.num_simplices() == flat_complex.num_simplices());
+  for (auto v : simple_complex.vertex_range())
+    for (auto w : simple_complex.vertex_range(v))
+      BOOST_CHECK(flat_complex.contains_edge(Flat_complex::Vertex_handle(v.vertex),
+                                             Flat_complex::Vertex_handle(w.vertex)));
+}
@@ -31,6 +31,23 @@ namespace spatial_searching {
  * For more details about the data structure or the algorithms, or for more advanced usages, reading 
  * <a target="_blank" href="http://doc.cgal.org/latest/Spatial_searching/index.html">CGAL documentation</a>
  * is highly recommended.
+ *
+ * Queries for a whole range of points can be performed in one call with `Kd_tree_search::k_nearest_neighbors_batch`
+ * and `Kd_tree_search::all_near_neighbors_batch`. They run in parallel when TBB is available and store the results
+ * in contiguous arrays.
+ *
+ * For points that are not given by Cartesian coordinates, or for non-Euclidean metrics, `Vantage_point_tree` provides
+ * exact k-nearest, k-furthest and radius queries that only rely on a distance functor satisfying the triangle
+ * inequality. It can be given to `Gudhi::subsampling::choose_n_farthest_points_metric`, to
+ * `Gudhi::rips_complex::Sparse_rips_complex` and to `Gudhi::cover_complex::Cover_complex::set_graph_from_rips` to
+ * avoid computing all the pairwise distances.
+ *
+ * In high dimension, exact searches degenerate to a linear scan. `Random_projection_forest` trades exactness for
+ * speed: it returns approximate k-nearest neighbors (with exact distances), and its recall is tuned by the number of
+ * trees and the number of candidates examined per query. Its results can be used as the nearest landmark table of
+ * `Gudhi::witness_complex::Witness_complex`, for the tangent space estimation of
+ * `Gudhi::tangential_complex::Tangential_complex` (with `GUDHI_TC_USE_APPROXIMATE_NEIGHBORS_FOR_TANGENT_SPACE_ESTIM`)
+ * and in Python with `KNearestNeighbors(implementation="rpforest")`.
  * 
  * \section spatial_searching_examples Example
  * 
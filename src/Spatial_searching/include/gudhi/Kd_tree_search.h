@@ -25,8 +25,15 @@
 #include <boost/property_map/property_map.hpp>
 #include <boost/iterator/counting_iterator.hpp>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <cstddef>
 #include <vector>
+#include <algorithm>  // for std::copy
+#include <limits>  // for numeric_limits
+#include <iterator>  // for std::back_inserter
 
 // Make compilation fail - required for external projects - https://github.com/GUDHI/gudhi-devel/issues/10
 #if CGAL_VERSION_NR < 1041101000
@@ -272,6 +279,86 @@ class Kd_tree_search {
     m_tree.search(it, Fuzzy_sphere(p, radius, eps, m_tree.traits()));
   }
 
+  /// \brief Search for the k-nearest neighbors of all the points of a range, in parallel if TBB is available.
+  /// @param[in] queries Random access range of query points.
+  /// @param[in] k Number of nearest points to search for each query.
+  /// @param[out] indices Resized to `queries.size() * k`. The k-nearest neighbors of `queries[i]` are stored in
+  /// `indices[i * k]` to `indices[i * k + k - 1]`. If the tree contains less than `k` points, the remaining
+  /// entries are set to `std::size_t(-1)`.
+  /// @param[out] squared_distances Resized to `queries.size() * k`. Squared distances matching `indices`
+  /// (`std::numeric_limits<FT>::max()` for missing neighbors).
+  /// @param[in] sorted Indicates if the neighbors of each query need to be sorted by increasing distance.
+  /// @param[in] eps Approximation factor.
+  template <typename Query_range>
+  void k_nearest_neighbors_batch(Query_range const& queries,
+                                 unsigned int k,
+                                 std::vector<std::size_t>& indices,
+                                 std::vector<FT>& squared_distances,
+                                 bool sorted = true,
+                                 FT eps = FT(0)) const {
+    const std::size_t nb_queries = queries.size();
+    indices.assign(nb_queries * k, std::size_t(-1));
+    squared_distances.assign(nb_queries * k, (std::numeric_limits<FT>::max)());
+    auto search_one = [&](std::size_t query_idx) {
+      std::size_t offset = query_idx * k;
+      for (auto const& nghb : k_nearest_neighbors(queries[query_idx], k, sorted, eps)) {
+        indices[offset] = nghb.first;
+        squared_distances[offset] = nghb.second;
+        ++offset;
+      }
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), nb_queries, search_one);
+#else
+    for (std::size_t query_idx = 0; query_idx < nb_queries; ++query_idx)
+      search_one(query_idx);
+#endif
+  }
+
+  /// \brief Search for all the neighbors in a ball around all the points of a range, in parallel if TBB is
+  /// available. The result is stored in compressed sparse row format.
+  /// @param[in] queries Random access range of query points.
+  /// @param[in] radius The search radius.
+  /// @param[out] offsets Resized to `queries.size() + 1`. The neighbors of `queries[i]` are
+  /// `indices[offsets[i]]` to `indices[offsets[i + 1] - 1]`, in no particular order.
+  /// @param[out] indices Indices of the points that lie inside the sphere of center `queries[i]` and radius
+  /// `radius`, for each query.
+  /// @param[in] eps Approximation factor.
+  template <typename Query_range>
+  void all_near_neighbors_batch(Query_range const& queries,
+                                FT radius,
+                                std::vector<std::size_t>& offsets,
+                                std::vector<std::size_t>& indices,
+                                FT eps = FT(0)) const {
+    const std::size_t nb_queries = queries.size();
+    std::vector<std::vector<std::size_t>> neighbors(nb_queries);
+    auto search_one = [&](std::size_t query_idx) {
+      all_near_neighbors(queries[query_idx], radius, std::back_inserter(neighbors[query_idx]), eps);
+    };
+    auto copy_one = [&](std::size_t query_idx) {
+      std::copy(neighbors[query_idx].begin(), neighbors[query_idx].end(), indices.begin() + offsets[query_idx]);
+      // Free the memory as soon as possible, the result may be large
+      std::vector<std::size_t>().swap(neighbors[query_idx]);
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), nb_queries, search_one);
+#else
+    for (std::size_t query_idx = 0; query_idx < nb_queries; ++query_idx)
+      search_one(query_idx);
+#endif
+    offsets.resize(nb_queries + 1);
+    offsets[0] = 0;
+    for (std::size_t query_idx = 0; query_idx < nb_queries; ++query_idx)
+      offsets[query_idx + 1] = offsets[query_idx] + neighbors[query_idx].size();
+    indices.resize(offsets[nb_queries]);
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), nb_queries, copy_one);
+#else
+    for (std::size_t query_idx = 0; query_idx < nb_queries; ++query_idx)
+      copy_one(query_idx);
+#endif
+  }
+
   int tree_depth() const {
     return m_tree.root()->depth();
   }
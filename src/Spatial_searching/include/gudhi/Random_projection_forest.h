@@ -0,0 +1,284 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef RANDOM_PROJECTION_FOREST_H_
+#define RANDOM_PROJECTION_FOREST_H_
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <boost/range/size.hpp>
+
+#include <cstddef>
+#include <vector>
+#include <queue>
+#include <utility>  // for std::pair
+#include <limits>  // for numeric_limits
+#include <algorithm>  // for sort, unique, partial_sort, nth_element
+#include <iterator>  // for std::begin, std::end
+#include <random>
+#include <stdexcept>  // for std::invalid_argument
+
+namespace Gudhi {
+namespace spatial_searching {
+
+  /**
+  * \class Random_projection_forest Random_projection_forest.h gudhi/Random_projection_forest.h
+  * \brief Forest of random projection trees to perform approximate nearest neighbor search in high dimension.
+  *
+  * \ingroup spatial_searching
+  *
+  * \details
+  * Above a few tens of dimensions, `Kd_tree_search` ends up visiting almost all the points. This data structure
+  * gives up exactness: each tree recursively splits the points by the bisector hyperplane of two random points, and
+  * a query gathers candidates from the leaves of all the trees, visited by increasing distance to the splitting
+  * hyperplanes, until `search_k` candidates are found. The k nearest candidates are then returned with their exact
+  * squared distances.
+  *
+  * The recall/speed trade-off is tuned by the number of trees (at construction) and by the `search_k` argument of
+  * the queries. The forest is not modified by the queries, which can be run concurrently.
+  * The queries provide the same interface as the k-nearest neighbor queries of `Kd_tree_search`, but there is no
+  * incremental search. The resulting tables can be given to `Gudhi::witness_complex::Witness_complex`.
+  *
+  * The points must be ranges of Cartesian coordinates (`std::begin(p)` and `std::end(p)` must be valid). They are
+  * copied in a contiguous array of `double`, so the input range can be destroyed after the construction.
+  */
+class Random_projection_forest {
+ public:
+  /// Number type used for distances.
+  typedef double FT;
+  /// \brief The range returned by a k-nearest neighbor search.
+  /// Its value type is `std::pair<std::size_t, FT>` where `first` is the index
+  /// of a point P and `second` is the squared distance between P and the query point.
+  typedef std::vector<std::pair<std::size_t, FT>> KNS_range;
+
+  /// \brief Constructor
+  /// @param[in] points Range of points, all of the same dimension.
+  /// @param[in] num_trees Number of random projection trees. More trees increase the recall, and the memory usage.
+  /// @param[in] leaf_size Maximal number of points in a leaf.
+  /// @param[in] seed Seed of the random generator, the forest is reproducible for a given seed.
+  /// @exception std::invalid_argument If the points do not have the same dimension.
+  template <typename Point_range>
+  Random_projection_forest(Point_range const& points, unsigned int num_trees = 10, std::size_t leaf_size = 32,
+                           unsigned int seed = 0)
+      : m_num_points(boost::size(points)), m_dim(0), m_leaf_size((std::max)(leaf_size, std::size_t(1))),
+        m_trees(num_trees) {
+    if (m_num_points > 0) m_dim = std::distance(std::begin(*std::begin(points)), std::end(*std::begin(points)));
+    m_coords.reserve(m_num_points * m_dim);
+    for (auto const& p : points) {
+      std::size_t old_size = m_coords.size();
+      m_coords.insert(m_coords.end(), std::begin(p), std::end(p));
+      if (m_coords.size() - old_size != m_dim)
+        throw std::invalid_argument("Random_projection_forest - points must have the same dimension");
+    }
+    auto build_one = [&](std::size_t tree_idx) { build_tree(m_trees[tree_idx], seed + tree_idx); };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), m_trees.size(), build_one);
+#else
+    for (std::size_t tree_idx = 0; tree_idx < m_trees.size(); ++tree_idx) build_one(tree_idx);
+#endif
+  }
+
+  /// \brief Returns the number of points.
+  std::size_t size() const { return m_num_points; }
+
+  /// \brief Returns the dimension of the points.
+  std::size_t dimension() const { return m_dim; }
+
+  /// \brief Search for the (approximate) k-nearest neighbors from a query point.
+  /// @param[in] p The query point, a range of coordinates.
+  /// @param[in] k Number of nearest points to search.
+  /// @param[in] sorted Indicates if the computed sequence of k-nearest neighbors needs to be sorted.
+  /// @param[in] search_k Number of candidates whose distance is computed. The larger, the better the recall.
+  /// 0 (default) means `num_trees * k`. A point found in several trees counts several times, so the search is exact
+  /// when `search_k` is at least `num_trees` times the number of points.
+  /// @return A range containing k neighbors (less if there are less than k points), approximating the k-nearest
+  /// ones.
+  template <typename Query_point>
+  KNS_range k_nearest_neighbors(Query_point const& p, unsigned int k, bool sorted = true,
+                                std::size_t search_k = 0) const {
+    std::vector<FT> q(std::begin(p), std::end(p));
+    if (q.size() != m_dim)
+      throw std::invalid_argument("Random_projection_forest - query point has a wrong dimension");
+    KNS_range result;
+    if (k == 0 || m_num_points == 0) return result;
+    if (search_k == 0) search_k = m_trees.size() * k;
+    std::vector<std::size_t> candidates = collect_candidates(q.data(), search_k, k);
+    result.reserve(candidates.size());
+    for (std::size_t idx : candidates) result.emplace_back(idx, squared_distance(q.data(), point(idx)));
+    auto closer = [](std::pair<std::size_t, FT> const& a, std::pair<std::size_t, FT> const& b) {
+      return a.second < b.second;
+    };
+    if (result.size() > k) {
+      if (sorted)
+        std::partial_sort(result.begin(), result.begin() + k, result.end(), closer);
+      else
+        std::nth_element(result.begin(), result.begin() + k - 1, result.end(), closer);
+      result.resize(k);
+    } else if (sorted) {
+      std::sort(result.begin(), result.end(), closer);
+    }
+    return result;
+  }
+
+  /// \brief Search for the (approximate) k-nearest neighbors of all the points of a range, in parallel if TBB is
+  /// available. Same interface as `Kd_tree_search::k_nearest_neighbors_batch`.
+  /// @param[in] queries Random access range of query points.
+  /// @param[in] k Number of nearest points to search for each query.
+  /// @param[out] indices Resized to `queries.size() * k`. The k-nearest neighbors of `queries[i]` are stored in
+  /// `indices[i * k]` to `indices[i * k + k - 1]`. Missing neighbors are set to `std::size_t(-1)`.
+  /// @param[out] squared_distances Resized to `queries.size() * k`. Squared distances matching `indices`
+  /// (`std::numeric_limits<FT>::max()` for missing neighbors).
+  /// @param[in] sorted Indicates if the neighbors of each query need to be sorted by increasing distance.
+  /// @param[in] search_k Number of candidates whose distance is computed for each query, see
+  /// `k_nearest_neighbors()`.
+  template <typename Query_range>
+  void k_nearest_neighbors_batch(Query_range const& queries,
+                                 unsigned int k,
+                                 std::vector<std::size_t>& indices,
+                                 std::vector<FT>& squared_distances,
+                                 bool sorted = true,
+                                 std::size_t search_k = 0) const {
+    const std::size_t nb_queries = boost::size(queries);
+    indices.assign(nb_queries * k, std::size_t(-1));
+    squared_distances.assign(nb_queries * k, (std::numeric_limits<FT>::max)());
+    auto search_one = [&](std::size_t query_idx) {
+      std::size_t offset = query_idx * k;
+      for (auto const& nghb : k_nearest_neighbors(*(std::begin(queries) + query_idx), k, sorted, search_k)) {
+        indices[offset] = nghb.first;
+        squared_distances[offset] = nghb.second;
+        ++offset;
+      }
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), nb_queries, search_one);
+#else
+    for (std::size_t query_idx = 0; query_idx < nb_queries; ++query_idx)
+      search_one(query_idx);
+#endif
+  }
+
+ private:
+  static const std::size_t no_split = std::size_t(-1);
+
+  // For a leaf, [first, last) is a range of Tree::points. Otherwise, first (resp. last) is the child containing the
+  // points on the negative (resp. positive) side of the hyperplane defined by Tree::normals[normal] and offset.
+  struct Node {
+    std::size_t first;
+    std::size_t last;
+    std::size_t normal;
+    FT offset;
+  };
+
+  struct Tree {
+    std::vector<Node> nodes;  // nodes[0] is the root
+    std::vector<FT> normals;
+    std::vector<std::size_t> points;
+  };
+
+  FT const* point(std::size_t idx) const { return m_coords.data() + idx * m_dim; }
+
+  FT dot(FT const* a, FT const* b) const {
+    FT res = 0;
+    for (std::size_t i = 0; i < m_dim; ++i) res += a[i] * b[i];
+    return res;
+  }
+
+  FT squared_distance(FT const* a, FT const* b) const {
+    FT res = 0;
+    for (std::size_t i = 0; i < m_dim; ++i) {
+      FT diff = a[i] - b[i];
+      res += diff * diff;
+    }
+    return res;
+  }
+
+  void build_tree(Tree& tree, unsigned int seed) const {
+    std::mt19937 gen(seed);
+    tree.points.resize(m_num_points);
+    for (std::size_t i = 0; i < m_num_points; ++i) tree.points[i] = i;
+    if (m_num_points > 0) build_node(tree, 0, m_num_points, gen);
+  }
+
+  // Builds the node for tree.points[begin, end) and returns its index
+  std::size_t build_node(Tree& tree, std::size_t begin, std::size_t end, std::mt19937& gen) const {
+    std::size_t node_idx = tree.nodes.size();
+    tree.nodes.push_back(Node{begin, end, no_split, 0});
+    if (end - begin <= m_leaf_size) return node_idx;
+
+    std::uniform_int_distribution<std::size_t> dis(begin, end - 1);
+    std::vector<FT> normal(m_dim);
+    // A few attempts, in case of duplicate points
+    for (int attempt = 0; attempt < 3; ++attempt) {
+      FT const* a = point(tree.points[dis(gen)]);
+      FT const* b = point(tree.points[dis(gen)]);
+      for (std::size_t i = 0; i < m_dim; ++i) normal[i] = a[i] - b[i];
+      FT offset = 0;
+      for (std::size_t i = 0; i < m_dim; ++i) offset += normal[i] * (a[i] + b[i]) / 2;
+      auto mid = std::partition(tree.points.begin() + begin, tree.points.begin() + end,
+                                [&](std::size_t idx) { return dot(normal.data(), point(idx)) <= offset; });
+      std::size_t mid_idx = mid - tree.points.begin();
+      if (mid_idx == begin || mid_idx == end) continue;
+      std::size_t normal_idx = tree.normals.size();
+      tree.normals.insert(tree.normals.end(), normal.begin(), normal.end());
+      std::size_t negative_child = build_node(tree, begin, mid_idx, gen);
+      std::size_t positive_child = build_node(tree, mid_idx, end, gen);
+      // tree.nodes may have been reallocated
+      tree.nodes[node_idx] = Node{negative_child, positive_child, normal_idx, offset};
+      return node_idx;
+    }
+    // No split found, the node stays a (large) leaf
+    return node_idx;
+  }
+
+  // Returns at least min(min_distinct, m_num_points) distinct candidates
+  std::vector<std::size_t> collect_candidates(FT const* q, std::size_t search_k, std::size_t min_distinct) const {
+    std::vector<std::size_t> candidates;
+    // (margin, (tree, node)): the nodes with the largest margin are the most likely to contain the neighbors
+    typedef std::pair<FT, std::pair<std::size_t, std::size_t>> Queue_entry;
+    std::priority_queue<Queue_entry> to_visit;
+    for (std::size_t tree_idx = 0; tree_idx < m_trees.size(); ++tree_idx)
+      to_visit.emplace((std::numeric_limits<FT>::max)(), std::make_pair(tree_idx, std::size_t(0)));
+    while (true) {
+      while (!to_visit.empty() && candidates.size() < search_k) {
+        FT margin = to_visit.top().first;
+        std::size_t tree_idx = to_visit.top().second.first;
+        Tree const& tree = m_trees[tree_idx];
+        Node const& node = tree.nodes[to_visit.top().second.second];
+        to_visit.pop();
+        if (node.normal == no_split) {
+          candidates.insert(candidates.end(), tree.points.begin() + node.first, tree.points.begin() + node.last);
+        } else {
+          FT side = dot(tree.normals.data() + node.normal, q) - node.offset;
+          to_visit.emplace((std::min)(margin, -side), std::make_pair(tree_idx, node.first));
+          to_visit.emplace((std::min)(margin, side), std::make_pair(tree_idx, node.last));
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+      // Points found in several trees may leave too few distinct candidates
+      if (candidates.size() >= min_distinct || to_visit.empty()) return candidates;
+      search_k = min_distinct;
+    }
+  }
+
+  std::size_t m_num_points;
+  std::size_t m_dim;
+  std::size_t m_leaf_size;
+  // Row-major coordinates of the points
+  std::vector<FT> m_coords;
+  std::vector<Tree> m_trees;
+};
+
+}  // namespace spatial_searching
+}  // namespace Gudhi
+
+#endif  // RANDOM_PROJECTION_FOREST_H_
@@ -0,0 +1,272 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef VANTAGE_POINT_TREE_H_
+#define VANTAGE_POINT_TREE_H_
+
+#include <boost/range/metafunctions.hpp>
+#include <boost/range/size.hpp>
+
+#include <cstddef>
+#include <vector>
+#include <queue>
+#include <utility>  // for std::pair
+#include <limits>  // for numeric_limits
+#include <algorithm>  // for nth_element, sort, max
+#include <random>
+#include <type_traits>  // for std::decay
+
+namespace Gudhi {
+namespace spatial_searching {
+
+  /**
+  * \class Vantage_point_tree Vantage_point_tree.h gudhi/Vantage_point_tree.h
+  * \brief Metric tree data structure to perform exact nearest and furthest neighbor search in any metric space.
+  *
+  * \ingroup spatial_searching
+  *
+  * \details
+  * Contrary to `Kd_tree_search`, this data structure does not rely on coordinates: it only evaluates the
+  * distance functor, which makes it usable for geodesic distances, dynamic time warping, edit distances, etc.
+  * The pruning of the search relies on the triangle inequality, the results are exact only if `Distance` is a
+  * metric (in particular, a squared Euclidean distance is not a metric).
+  *
+  * Like `Kd_tree_search`, the tree does not store the points themselves, but stores indices.
+  * The construction requires \f$O(n \log n)\f$ distance evaluations.
+  *
+  * \tparam Point_range is the type of the range that provides the points.
+  *   It must be a range whose iterator type is a `RandomAccessIterator`.
+  * \tparam Distance is a functor that returns the distance between two points of `Point_range`.
+  */
+template <typename Point_range, typename Distance>
+class Vantage_point_tree {
+ public:
+  /// The point type.
+  typedef typename boost::range_value<Point_range>::type Point;
+  /// Number type used for distances.
+  typedef typename std::decay<decltype(std::declval<Distance&>()(std::declval<Point const&>(),
+                                                                 std::declval<Point const&>()))>::type FT;
+  /// \brief Type of the results of a k-nearest or k-furthest neighbor search.
+  /// `first` is the index of a point P and `second` is the distance between P and the query point.
+  typedef std::pair<std::size_t, FT> Neighbor;
+
+  /// \brief Constructor
+  /// @param[in] points Const reference to the point range. This range
+  /// is not copied, so it should not be destroyed or modified afterwards.
+  /// @param[in] distance Distance functor.
+  Vantage_point_tree(Point_range const& points, Distance distance = Distance())
+      : m_points(points), m_distance(distance) {
+    const std::size_t nb_points = boost::size(points);
+    m_indices.reserve(nb_points);
+    for (std::size_t i = 0; i < nb_points; ++i) m_indices.push_back(i);
+    build();
+  }
+
+  /// \brief Constructor
+  /// @param[in] points Const reference to the point range. This range
+  /// is not copied, so it should not be destroyed or modified afterwards.
+  /// @param[in] only_these_points Specifies the indices of the points that
+  /// should be actually inserted into the tree. The other points are ignored.
+  /// @param[in] distance Distance functor.
+  template <typename Point_indices_range>
+  Vantage_point_tree(Point_range const& points, Point_indices_range const& only_these_points,
+                     Distance distance = Distance())
+      : m_points(points), m_distance(distance),
+        m_indices(std::begin(only_these_points), std::end(only_these_points)) {
+    build();
+  }
+
+  /// \brief Returns the point range the tree was built on.
+  Point_range const& points() const { return m_points; }
+
+  /// \brief Returns the distance functor.
+  Distance const& distance() const { return m_distance; }
+
+  /// \brief Returns the number of points stored in the tree.
+  std::size_t size() const { return m_indices.size(); }
+
+  /// \brief Search for the k-nearest neighbors from a query point.
+  /// @param[in] p The query point.
+  /// @param[in] k Number of nearest points to search.
+  /// @param[in] sorted Indicates if the computed sequence of k-nearest neighbors needs to be sorted.
+  /// @return A vector of `Neighbor` containing the k-nearest neighbors (less if the tree contains less than k
+  /// points).
+  std::vector<Neighbor> k_nearest_neighbors(Point const& p, unsigned int k, bool sorted = true) const {
+    return k_neighbors(p, k, sorted, Closer());
+  }
+
+  /// \brief Search for the k-furthest points from a query point.
+  /// @param[in] p The query point.
+  /// @param[in] k Number of furthest points to search.
+  /// @param[in] sorted Indicates if the computed sequence of k-furthest neighbors needs to be sorted.
+  /// @return A vector of `Neighbor` containing the k-furthest neighbors (less if the tree contains less than k
+  /// points).
+  std::vector<Neighbor> k_furthest_neighbors(Point const& p, unsigned int k, bool sorted = true) const {
+    return k_neighbors(p, k, sorted, Further());
+  }
+
+  /// \brief Search for all the neighbors in a closed ball.
+  /// @param[in] p The query point.
+  /// @param[in] radius The search radius.
+  /// @param[out] it The indices of the points that lie inside the ball of center `p` and radius `radius`.
+  ///                Note: `it` is used this way: `*it++ = each_point_index`.
+  template <typename OutputIterator>
+  void all_near_neighbors(Point const& p, FT radius, OutputIterator it) const {
+    if (m_indices.empty()) return;
+    search_ball(p, radius, 0, m_indices.size(), [&it](std::size_t idx, FT) { *it++ = idx; });
+  }
+
+  /// \brief Search for all the neighbors in a closed ball, and output their distance to the query point.
+  /// @param[in] p The query point.
+  /// @param[in] radius The search radius.
+  /// @param[out] it The `Neighbor`s that lie inside the ball of center `p` and radius `radius`.
+  ///                Note: `it` is used this way: `*it++ = each_neighbor`.
+  template <typename OutputIterator>
+  void all_near_neighbors_with_distances(Point const& p, FT radius, OutputIterator it) const {
+    if (m_indices.empty()) return;
+    search_ball(p, radius, 0, m_indices.size(), [&it](std::size_t idx, FT d) { *it++ = Neighbor(idx, d); });
+  }
+
+ private:
+  // A node is identified by the range [begin, end) of m_indices it covers. For a non-leaf node, the vantage point
+  // is m_indices[begin], the points of [begin + 1, mid) are at distance at most mu of it, and the points of
+  // [mid, end) are at distance between mu and max_dist. The node data is stored in m_nodes[begin].
+  struct Node {
+    FT mu;
+    FT max_dist;
+    std::size_t mid;
+  };
+
+  static const std::size_t leaf_size = 8;
+
+  void build() {
+    m_nodes.resize(m_indices.size());
+    std::vector<std::pair<FT, std::size_t>> buffer;
+    buffer.reserve(m_indices.size());
+    // Fixed seed, so that the tree (and the order of the results) is reproducible
+    std::mt19937 gen(0);
+    build(0, m_indices.size(), buffer, gen);
+  }
+
+  void build(std::size_t begin, std::size_t end, std::vector<std::pair<FT, std::size_t>>& buffer,
+             std::mt19937& gen) {
+    if (end - begin <= leaf_size) return;
+    std::uniform_int_distribution<std::size_t> dis(begin, end - 1);
+    std::swap(m_indices[begin], m_indices[dis(gen)]);
+    Point const& vp = m_points[m_indices[begin]];
+    buffer.clear();
+    for (std::size_t i = begin + 1; i < end; ++i)
+      buffer.emplace_back(m_distance(vp, m_points[m_indices[i]]), m_indices[i]);
+    auto median = buffer.begin() + buffer.size() / 2;
+    std::nth_element(buffer.begin(), median, buffer.end());
+    Node& node = m_nodes[begin];
+    node.mu = median->first;
+    node.max_dist = std::max_element(median, buffer.end())->first;
+    node.mid = begin + 1 + buffer.size() / 2;
+    for (std::size_t i = 0; i < buffer.size(); ++i) m_indices[begin + 1 + i] = buffer[i].second;
+    std::size_t mid = node.mid;
+    build(begin + 1, mid, buffer, gen);
+    build(mid, end, buffer, gen);
+  }
+
+  template <typename Callback>
+  void search_ball(Point const& p, FT radius, std::size_t begin, std::size_t end, Callback const& callback) const {
+    if (end - begin <= leaf_size) {
+      for (std::size_t i = begin; i < end; ++i) {
+        FT d = m_distance(p, m_points[m_indices[i]]);
+        if (d <= radius) callback(m_indices[i], d);
+      }
+      return;
+    }
+    Node const& node = m_nodes[begin];
+    FT d = m_distance(p, m_points[m_indices[begin]]);
+    if (d <= radius) callback(m_indices[begin], d);
+    if (d - radius <= node.mu) search_ball(p, radius, begin + 1, node.mid, callback);
+    if (d + radius >= node.mu && d - radius <= node.max_dist) search_ball(p, radius, node.mid, end, callback);
+  }
+
+  // Order for the k-nearest neighbor search: the worst candidate is the furthest one.
+  struct Closer {
+    bool operator()(Neighbor const& a, Neighbor const& b) const { return a.second < b.second; }
+    static FT worst() { return (std::numeric_limits<FT>::max)(); }
+    // May a point at distance between dmin and dmax from p improve a candidate at distance tau?
+    static bool may_improve(FT dmin, FT, FT tau) { return dmin <= tau; }
+  };
+
+  // Order for the k-furthest neighbor search: the worst candidate is the closest one.
+  struct Further {
+    bool operator()(Neighbor const& a, Neighbor const& b) const { return a.second > b.second; }
+    static FT worst() { return std::numeric_limits<FT>::lowest(); }
+    static bool may_improve(FT, FT dmax, FT tau) { return dmax >= tau; }
+  };
+
+  template <typename Order>
+  using Candidate_queue = std::priority_queue<Neighbor, std::vector<Neighbor>, Order>;
+
+  template <typename Order>
+  std::vector<Neighbor> k_neighbors(Point const& p, unsigned int k, bool sorted, Order order) const {
+    Candidate_queue<Order> candidates(order);
+    if (k > 0 && !m_indices.empty()) search_k(p, k, 0, m_indices.size(), candidates);
+    std::vector<Neighbor> result;
+    result.reserve(candidates.size());
+    for (; !candidates.empty(); candidates.pop()) result.push_back(candidates.top());
+    // The queue pops the worst candidate first
+    if (sorted) std::reverse(result.begin(), result.end());
+    return result;
+  }
+
+  template <typename Order>
+  void consider(std::size_t idx, FT d, unsigned int k, Candidate_queue<Order>& candidates) const {
+    if (candidates.size() < k) {
+      candidates.emplace(idx, d);
+    } else if (Order()(Neighbor(idx, d), candidates.top())) {
+      candidates.pop();
+      candidates.emplace(idx, d);
+    }
+  }
+
+  template <typename Order>
+  void search_k(Point const& p, unsigned int k, std::size_t begin, std::size_t end,
+                Candidate_queue<Order>& candidates) const {
+    if (end - begin <= leaf_size) {
+      for (std::size_t i = begin; i < end; ++i)
+        consider(m_indices[i], m_distance(p, m_points[m_indices[i]]), k, candidates);
+      return;
+    }
+    Node const& node = m_nodes[begin];
+    FT d = m_distance(p, m_points[m_indices[begin]]);
+    consider(m_indices[begin], d, k, candidates);
+    auto tau = [&]() { return candidates.size() < k ? Order::worst() : candidates.top().second; };
+    // Bounds on the distance from p to the points of each subtree, given by the triangle inequality
+    FT inside_min = d - node.mu;
+    FT inside_max = d + node.mu;
+    FT outside_min = (std::max)(node.mu - d, d - node.max_dist);
+    FT outside_max = d + node.max_dist;
+    // Visit first the subtree that most likely contains the best candidates
+    bool inside_first = Order()(Neighbor(0, inside_min + inside_max), Neighbor(0, outside_min + outside_max));
+    if (inside_first) {
+      if (Order::may_improve(inside_min, inside_max, tau())) search_k(p, k, begin + 1, node.mid, candidates);
+      if (Order::may_improve(outside_min, outside_max, tau())) search_k(p, k, node.mid, end, candidates);
+    } else {
+      if (Order::may_improve(outside_min, outside_max, tau())) search_k(p, k, node.mid, end, candidates);
+      if (Order::may_improve(inside_min, inside_max, tau())) search_k(p, k, begin + 1, node.mid, candidates);
+    }
+  }
+
+  Point_range const& m_points;
+  Distance m_distance;
+  std::vector<std::size_t> m_indices;
+  std::vector<Node> m_nodes;
+};
+
+}  // namespace spatial_searching
+}  // namespace Gudhi
+
+#endif  // VANTAGE_POINT_TREE_H_
@@ -18,6 +18,7 @@
 #include <CGAL/Random.h>
 
 #include <vector>
+#include <algorithm>  // for sort
 
 BOOST_AUTO_TEST_CASE(test_Kd_tree_search) {
   typedef CGAL::Epick_d<CGAL::Dimension_tag<4> > K;
@@ -105,4 +106,34 @@ BOOST_AUTO_TEST_CASE(test_Kd_tree_search) {
   K k;
   for (auto const& p_idx : rs_result)
     BOOST_CHECK(k.squared_distance_d_object()(points[p_idx], rs_q) <= 0.5);
+
+  // Test k_nearest_neighbors_batch
+  std::vector<std::size_t> batch_indices;
+  std::vector<FT> batch_sq_distances;
+  points_ds.k_nearest_neighbors_batch(points, 10, batch_indices, batch_sq_distances);
+  BOOST_CHECK(batch_indices.size() == points.size() * 10);
+  BOOST_CHECK(batch_sq_distances.size() == points.size() * 10);
+  for (std::size_t i = 0; i < points.size(); i += 50) {
+    std::size_t j = 0;
+    for (auto const& nghb : points_ds.k_nearest_neighbors(points[i], 10, true)) {
+      BOOST_CHECK(batch_indices[i * 10 + j] == nghb.first);
+      BOOST_CHECK(batch_sq_distances[i * 10 + j] == nghb.second);
+      ++j;
+    }
+  }
+
+  // Test all_near_neighbors_batch
+  std::vector<std::size_t> offsets;
+  std::vector<std::size_t> near_indices;
+  points_ds.all_near_neighbors_batch(points, 0.5, offsets, near_indices);
+  BOOST_CHECK(offsets.size() == points.size() + 1);
+  BOOST_CHECK(offsets.back() == near_indices.size());
+  for (std::size_t i = 0; i < points.size(); i += 50) {
+    std::vector<std::size_t> single_result;
+    points_ds.all_near_neighbors(points[i], 0.5, std::back_inserter(single_result));
+    std::vector<std::size_t> batch_result(near_indices.begin() + offsets[i], near_indices.begin() + offsets[i + 1]);
+    std::sort(single_result.begin(), single_result.end());
+    std::sort(batch_result.begin(), batch_result.end());
+    BOOST_CHECK(single_result == batch_result);
+  }
 }
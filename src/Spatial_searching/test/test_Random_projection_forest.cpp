@@ -0,0 +1,112 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Spatial_searching - test Random_projection_forest
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Random_projection_forest.h>
+
+#include <vector>
+#include <random>
+#include <algorithm>  // for sort
+#include <limits>  // for numeric_limits
+
+typedef std::vector<double> Point;
+typedef std::vector<Point> Points;
+typedef Gudhi::spatial_searching::Random_projection_forest Points_ds;
+
+Points random_points(std::size_t nb_points, std::size_t dim) {
+  std::mt19937 gen(42);
+  std::normal_distribution<double> dis;
+  Points points;
+  for (std::size_t i = 0; i < nb_points; ++i) {
+    Point p;
+    for (std::size_t j = 0; j < dim; ++j) p.push_back(dis(gen));
+    points.push_back(p);
+  }
+  return points;
+}
+
+// Brute force squared distances to the k nearest neighbors
+std::vector<double> brute_force(Points const& points, Point const& q, std::size_t k) {
+  std::vector<double> all;
+  for (auto const& p : points) {
+    double sq = 0;
+    for (std::size_t i = 0; i < q.size(); ++i) sq += (p[i] - q[i]) * (p[i] - q[i]);
+    all.push_back(sq);
+  }
+  std::sort(all.begin(), all.end());
+  all.resize(k);
+  return all;
+}
+
+BOOST_AUTO_TEST_CASE(test_Random_projection_forest_exact) {
+  Points points = random_points(300, 20);
+  Points_ds points_ds(points, 4, 16);
+  BOOST_CHECK(points_ds.size() == points.size());
+  BOOST_CHECK(points_ds.dimension() == 20);
+
+  // With search_k >= num_trees * number of points, the search is exact
+  for (std::size_t q_idx : {0, 17, 299}) {
+    auto knn = points_ds.k_nearest_neighbors(points[q_idx], 10, true, 4 * points.size());
+    auto expected = brute_force(points, points[q_idx], 10);
+    BOOST_CHECK(knn.size() == 10);
+    BOOST_CHECK(knn[0].first == q_idx);
+    for (std::size_t i = 0; i < knn.size(); ++i) BOOST_CHECK(knn[i].second == expected[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_Random_projection_forest_recall) {
+  Points points = random_points(2000, 30);
+  Points queries = random_points(50, 30);
+  Points_ds points_ds(points, 10, 16);
+
+  const unsigned k = 10;
+  std::vector<std::size_t> indices;
+  std::vector<double> squared_distances;
+  points_ds.k_nearest_neighbors_batch(queries, k, indices, squared_distances, true, 400);
+  BOOST_CHECK(indices.size() == queries.size() * k);
+
+  std::size_t found = 0;
+  for (std::size_t q = 0; q < queries.size(); ++q) {
+    auto expected = brute_force(points, queries[q], k);
+    auto knn = points_ds.k_nearest_neighbors(queries[q], k, true, 400);
+    for (std::size_t i = 0; i < k; ++i) {
+      // Batch and single queries agree, and returned distances are exact
+      BOOST_CHECK(indices[q * k + i] == knn[i].first);
+      BOOST_CHECK(squared_distances[q * k + i] == knn[i].second);
+      if (i > 0) BOOST_CHECK(knn[i - 1].second <= knn[i].second);
+      if (std::binary_search(expected.begin(), expected.end(), knn[i].second)) ++found;
+    }
+  }
+  // Average recall
+  BOOST_CHECK(found >= queries.size() * k / 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_Random_projection_forest_duplicates) {
+  // Identical points cannot be split, leaves may exceed leaf_size
+  Points points(100, Point{1., 2., 3.});
+  points.push_back({0., 0., 0.});
+  Points_ds points_ds(points, 2, 8);
+  auto knn = points_ds.k_nearest_neighbors(Point{0., 0., 0.1}, 1);
+  BOOST_CHECK(knn.size() == 1);
+  BOOST_CHECK(knn[0].first == 100);
+
+  // Asking for more neighbors than points
+  Points_ds small_ds(Points{{0., 0.}, {1., 1.}});
+  std::vector<std::size_t> indices;
+  std::vector<double> squared_distances;
+  small_ds.k_nearest_neighbors_batch(Points{{0., 0.}}, 3, indices, squared_distances);
+  BOOST_CHECK(indices[0] == 0);
+  BOOST_CHECK(indices[1] == 1);
+  BOOST_CHECK(indices[2] == std::size_t(-1));
+  BOOST_CHECK(squared_distances[2] == (std::numeric_limits<double>::max)());
+}
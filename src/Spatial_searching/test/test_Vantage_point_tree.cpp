@@ -0,0 +1,98 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Spatial_searching - test Vantage_point_tree
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Vantage_point_tree.h>
+#include <gudhi/distance_functions.h>
+
+#include <vector>
+#include <random>
+#include <algorithm>  // for sort
+
+typedef std::vector<double> Point;
+typedef std::vector<Point> Points;
+
+Points random_points(std::size_t nb_points) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dis(-1., 1.);
+  Points points;
+  for (std::size_t i = 0; i < nb_points; ++i)
+    points.push_back({dis(gen), dis(gen), dis(gen), dis(gen)});
+  return points;
+}
+
+BOOST_AUTO_TEST_CASE(test_Vantage_point_tree) {
+  typedef Gudhi::spatial_searching::Vantage_point_tree<Points, Gudhi::Euclidean_distance> Points_ds;
+  typedef Points_ds::Neighbor Neighbor;
+  Gudhi::Euclidean_distance dist;
+
+  Points points = random_points(500);
+  Points_ds points_ds(points);
+  BOOST_CHECK(points_ds.size() == points.size());
+
+  // Brute force neighbors of a query point, sorted by distance
+  auto brute_force = [&](Point const& q) {
+    std::vector<Neighbor> all;
+    for (std::size_t i = 0; i < points.size(); ++i) all.emplace_back(i, dist(points[i], q));
+    std::sort(all.begin(), all.end(), [](Neighbor const& a, Neighbor const& b) { return a.second < b.second; });
+    return all;
+  };
+
+  for (std::size_t q_idx : {10, 20, 123}) {
+    auto all = brute_force(points[q_idx]);
+
+    // Test k_nearest_neighbors
+    auto knn = points_ds.k_nearest_neighbors(points[q_idx], 10);
+    BOOST_CHECK(knn.size() == 10);
+    BOOST_CHECK(knn[0].first == q_idx);
+    for (std::size_t i = 0; i < knn.size(); ++i) BOOST_CHECK(knn[i].second == all[i].second);
+
+    // Test k_furthest_neighbors
+    auto kfn = points_ds.k_furthest_neighbors(points[q_idx], 10);
+    BOOST_CHECK(kfn.size() == 10);
+    for (std::size_t i = 0; i < kfn.size(); ++i) BOOST_CHECK(kfn[i].second == all[all.size() - 1 - i].second);
+
+    // Test all_near_neighbors
+    std::vector<std::size_t> near;
+    points_ds.all_near_neighbors(points[q_idx], 0.5, std::back_inserter(near));
+    std::vector<std::size_t> expected;
+    for (auto const& nghb : all)
+      if (nghb.second <= 0.5) expected.push_back(nghb.first);
+    std::sort(near.begin(), near.end());
+    std::sort(expected.begin(), expected.end());
+    BOOST_CHECK(near == expected);
+
+    std::vector<Neighbor> near_with_distances;
+    points_ds.all_near_neighbors_with_distances(points[q_idx], 0.5, std::back_inserter(near_with_distances));
+    BOOST_CHECK(near_with_distances.size() == expected.size());
+    for (auto const& nghb : near_with_distances) BOOST_CHECK(nghb.second == dist(points[nghb.first], points[q_idx]));
+  }
+
+  // More neighbors than points
+  BOOST_CHECK(points_ds.k_nearest_neighbors(points[0], 1000).size() == points.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_Vantage_point_tree_subset) {
+  Points points = random_points(100);
+  std::vector<std::size_t> only_these_points = {1, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+  Gudhi::spatial_searching::Vantage_point_tree<Points, Gudhi::Euclidean_distance> points_ds(points,
+                                                                                           only_these_points);
+  BOOST_CHECK(points_ds.size() == only_these_points.size());
+
+  auto knn = points_ds.k_nearest_neighbors(points[0], 100);
+  BOOST_CHECK(knn.size() == only_these_points.size());
+  std::vector<std::size_t> found;
+  for (auto const& nghb : knn) found.push_back(nghb.first);
+  std::sort(found.begin(), found.end());
+  BOOST_CHECK(found == only_these_points);
+}
@@ -33,6 +33,9 @@ namespace subsampling {
  * is greater than or equal to 0.4.
  * 
  * \include Subsampling/example_sparsify_point_set.cpp
+ *
+ * `sparsify_point_set_parallel` computes the same subset in parallel (when TBB is available), or a different one
+ * with the same minimal distance guarantee when the input order does not need to be respected.
  * 
  * \section farthestpointexamples Example: choose_n_farthest_points
  *
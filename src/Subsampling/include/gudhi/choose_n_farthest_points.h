@@ -18,6 +18,8 @@
 #include <iterator>
 #include <vector>
 #include <random>
+#include <queue>
+#include <utility>  // for std::pair
 #include <limits>  // for numeric_limits<>
 
 namespace Gudhi {
@@ -114,6 +116,84 @@ void choose_n_farthest_points(Kernel const &k,
   }
 }
 
+/**
+ *  \ingroup subsampling
+ *  \brief Same as `choose_n_farthest_points`, but the distances are only computed through a metric tree, which
+ *  avoids computing the distances from each new landmark to all the points.
+ *  \tparam Metric_tree must provide the same interface as `Gudhi::spatial_searching::Vantage_point_tree`
+ *  (`points()` and `all_near_neighbors_with_distances()`), and must have been built on all the points of
+ *  its range.
+ *  \tparam IndexOutputIterator Output iterator whose value type is `std::size_t`.
+ *  \tparam DistanceOutputIterator Output iterator for distances.
+ *  \details Contrary to `choose_n_farthest_points`, it outputs the indices of the chosen points in
+ *  `tree.points()`, and the distances are the ones of the tree (not squared). Only the points closer to
+ *  the new landmark than the current farthest point are visited at each step.
+ * @param[in] tree A metric tree built on the input points.
+ * @param[in] final_size The size of the subsample to compute.
+ * @param[in] starting_point The seed in the farthest point algorithm.
+ * @param[out] output_it The output iterator for the indices of the chosen points.
+ * @param[out] dist_it The optional output iterator for distances.
+ */
+template < typename Metric_tree,
+typename IndexOutputIterator,
+typename DistanceOutputIterator = Null_output_iterator>
+void choose_n_farthest_points_metric(Metric_tree const &tree,
+                                     std::size_t final_size,
+                                     std::size_t starting_point,
+                                     IndexOutputIterator output_it,
+                                     DistanceOutputIterator dist_it = {}) {
+  typedef typename Metric_tree::FT FT;
+  auto const& input_pts = tree.points();
+  std::size_t nb_points = boost::size(input_pts);
+  if (final_size > nb_points)
+    final_size = nb_points;
+
+  // Tests to the limit
+  if (final_size < 1)
+    return;
+
+  if (starting_point == random_starting_point) {
+    // Choose randomly the first landmark
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<std::size_t> dis(0, nb_points - 1);
+    starting_point = dis(gen);
+  }
+
+  const FT infty = std::numeric_limits<FT>::infinity();
+  std::vector<FT> dist_to_L(nb_points, infty);
+  // Max-heap of (distance to L, point index). An entry is outdated if the distance of the point to L decreased
+  // after it was pushed.
+  std::priority_queue<std::pair<FT, std::size_t>> farthest;
+  std::vector<std::pair<std::size_t, FT>> neighbors;
+
+  std::size_t curr_max_w = starting_point;
+  FT curr_max_dist = infty;
+  for (std::size_t current_number_of_landmarks = 0; current_number_of_landmarks != final_size;
+       current_number_of_landmarks++) {
+    // curr_max_w at this point is the next landmark
+    *output_it++ = curr_max_w;
+    *dist_it++ = dist_to_L[curr_max_w];
+    // Only the points whose distance to L is at most curr_max_dist can get closer to L
+    neighbors.clear();
+    tree.all_near_neighbors_with_distances(*(std::begin(input_pts) + curr_max_w), curr_max_dist,
+                                           std::back_inserter(neighbors));
+    for (auto const& nghb : neighbors) {
+      if (nghb.second < dist_to_L[nghb.first]) {
+        dist_to_L[nghb.first] = nghb.second;
+        farthest.emplace(nghb.second, nghb.first);
+      }
+    }
+    // choose the next curr_max_w
+    while (!farthest.empty() && farthest.top().first != dist_to_L[farthest.top().second])
+      farthest.pop();
+    if (farthest.empty())
+      break;
+    curr_max_dist = farthest.top().first;
+    curr_max_w = farthest.top().second;
+  }
+}
+
 }  // namespace subsampling
 
 }  // namespace Gudhi
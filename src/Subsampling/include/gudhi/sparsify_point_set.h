@@ -16,8 +16,17 @@
 #include <gudhi/Clock.h>
 #endif
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <cstddef>
+#include <cstdint>
+#include <cmath>  // for std::sqrt
 #include <vector>
+#include <numeric>  // for iota
+#include <random>
+#include <algorithm>  // for shuffle, remove_if
 
 namespace Gudhi {
 
@@ -95,6 +104,135 @@ sparsify_point_set(
 #endif
 }
 
+/**
+ *  \ingroup subsampling
+ *  \brief Parallel version of `sparsify_point_set`. Outputs a subset of the input points so that the
+ *         squared distance between any two points is greater than or equal to `min_squared_dist`.
+ *
+ * \details The output is a maximal independent set of the graph linking the points closer than
+ * `min_squared_dist`. It is computed in rounds: a point is kept as soon as all its neighbors of lower priority
+ * are dropped, and dropped as soon as one of them is kept. The neighborhoods and each round are computed in
+ * parallel when `GUDHI_USE_TBB` is defined.
+ *
+ * If `preserve_order` is true, the priority of a point is its index, and the output is exactly the one of
+ * `sparsify_point_set`. Otherwise, priorities are randomly shuffled, which bounds the expected number of rounds
+ * by O(log(n)) even when the input points are sorted along a curve (as in a LIDAR scan), but the kept points
+ * differ from the ones of `sparsify_point_set`. In both cases, points are output in the input order.
+ *
+ * \tparam Kernel must be a model of the <a target="_blank"
+ *   href="http://doc.cgal.org/latest/Spatial_searching/classSearchTraits.html">SearchTraits</a>
+ *   concept, such as the <a target="_blank"
+ *   href="http://doc.cgal.org/latest/Kernel_d/classCGAL_1_1Epick__d.html">CGAL::Epick_d</a> class, which
+ *   can be static if you know the ambiant dimension at compile-time, or dynamic if you don't.
+ *   It must also provide `squared_distance_d_object()`.
+ * \tparam Point_range Range whose value type is Kernel::Point_d.  It must provide random-access
+ *         via `operator[]` and the points should be stored contiguously in memory.
+ * \tparam OutputIterator Output iterator whose value type is Kernel::Point_d.
+ *
+ * @param[in] k A kernel object.
+ * @param[in] input_pts Const reference to the input points.
+ * @param[in] min_squared_dist Minimum squared distance separating the output points.
+ * @param[out] output_it The output iterator.
+ * @param[in] preserve_order If true, the output is the same as the one of `sparsify_point_set`.
+ */
+template <typename Kernel, typename Point_range, typename OutputIterator>
+void
+sparsify_point_set_parallel(
+                   const Kernel &k, Point_range const& input_pts,
+                   typename Kernel::FT min_squared_dist,
+                   OutputIterator output_it,
+                   bool preserve_order = true) {
+  typedef typename Gudhi::spatial_searching::Kd_tree_search<
+      Kernel, Point_range> Points_ds;
+  typedef typename Kernel::FT FT;
+
+#ifdef GUDHI_SUBSAMPLING_PROFILING
+  Gudhi::Clock t;
+#endif
+
+  const std::size_t nb_points = input_pts.size();
+  Points_ds points_ds(input_pts);
+  auto sqdist = k.squared_distance_d_object();
+
+  // priority[i] is the rank of point i in the greedy order
+  std::vector<std::size_t> priority(nb_points);
+  std::iota(priority.begin(), priority.end(), 0);
+  if (!preserve_order) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::shuffle(priority.begin(), priority.end(), gen);
+  }
+
+  // For each point, only the too close points with a lower priority are stored, as the others can not
+  // influence its status.
+  std::vector<std::vector<std::size_t>> lower_neighbors(nb_points);
+  const FT radius = std::sqrt(min_squared_dist);
+  auto compute_lower_neighbors = [&](std::size_t pt_idx) {
+    std::vector<std::ptrdiff_t> near_points;
+    points_ds.all_near_neighbors(input_pts[pt_idx], radius, std::back_inserter(near_points));
+    for (std::ptrdiff_t neighbor_idx : near_points) {
+      // The search ball is closed, sparsify_point_set only drops points strictly closer than min_squared_dist
+      if (priority[neighbor_idx] < priority[pt_idx] &&
+          sqdist(input_pts[pt_idx], input_pts[neighbor_idx]) < min_squared_dist)
+        lower_neighbors[pt_idx].push_back(neighbor_idx);
+    }
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), nb_points, compute_lower_neighbors);
+#else
+  for (std::size_t pt_idx = 0; pt_idx < nb_points; ++pt_idx)
+    compute_lower_neighbors(pt_idx);
+#endif
+
+  enum : std::uint8_t { undecided, kept, dropped };
+  // The status of a round is only computed from the one of the previous round, so that threads never read a
+  // value being written.
+  std::vector<std::uint8_t> status(nb_points, undecided);
+  std::vector<std::uint8_t> next_status(status);
+  std::vector<std::size_t> undecided_points(nb_points);
+  std::iota(undecided_points.begin(), undecided_points.end(), 0);
+
+  auto decide = [&](std::size_t i) {
+    std::size_t pt_idx = undecided_points[i];
+    bool all_dropped = true;
+    for (std::size_t neighbor_idx : lower_neighbors[pt_idx]) {
+      if (status[neighbor_idx] == kept) {
+        next_status[pt_idx] = dropped;
+        return;
+      }
+      if (status[neighbor_idx] == undecided)
+        all_dropped = false;
+    }
+    if (all_dropped)
+      next_status[pt_idx] = kept;
+  };
+  // Each round decides at least the undecided point of lowest priority
+  while (!undecided_points.empty()) {
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), undecided_points.size(), decide);
+#else
+    for (std::size_t i = 0; i < undecided_points.size(); ++i)
+      decide(i);
+#endif
+    for (std::size_t pt_idx : undecided_points)
+      status[pt_idx] = next_status[pt_idx];
+    auto new_end = std::remove_if(undecided_points.begin(), undecided_points.end(),
+                                  [&](std::size_t pt_idx) { return status[pt_idx] != undecided; });
+    undecided_points.erase(new_end, undecided_points.end());
+  }
+
+  for (std::size_t pt_idx = 0; pt_idx < nb_points; ++pt_idx) {
+    if (status[pt_idx] == kept)
+      *output_it++ = input_pts[pt_idx];
+  }
+
+#ifdef GUDHI_SUBSAMPLING_PROFILING
+  t.end();
+  std::cerr << "Point set sparsified in parallel in " << t.num_seconds()
+      << " seconds." << std::endl;
+#endif
+}
+
 }  // namespace subsampling
 }  // namespace Gudhi
 
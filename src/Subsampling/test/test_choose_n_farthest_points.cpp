@@ -18,10 +18,13 @@
 #include <boost/mpl/list.hpp>
 
 #include <gudhi/choose_n_farthest_points.h>
+#include <gudhi/Vantage_point_tree.h>
 #include <vector>
 #include <iterator>
+#include <cmath>  // for std::sqrt
 
 #include <CGAL/Epick_d.h>
+#include <CGAL/Random.h>
 
 typedef CGAL::Epick_d<CGAL::Dynamic_dimension_tag> K;
 typedef typename K::FT FT;
@@ -100,3 +103,36 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_choose_farthest_point_limits, Kernel, list_of
   BOOST_CHECK(distances[1] == 1);
   landmarks.clear(); distances.clear();
 }
+
+BOOST_AUTO_TEST_CASE(test_choose_farthest_point_metric) {
+  typedef CGAL::Epick_d<CGAL::Dimension_tag<4>> Kernel;
+  typedef typename Kernel::Point_d Point_d;
+  struct Distance {
+    double operator()(Point_d const& p, Point_d const& q) const {
+      return std::sqrt(Kernel().squared_distance_d_object()(p, q));
+    }
+  };
+  CGAL::Random rd;
+  std::vector<Point_d> points;
+  for (int i = 0; i < 500; ++i)
+    points.push_back(Point_d(rd.get_double(-1., 1), rd.get_double(-1., 1), rd.get_double(-1., 1), rd.get_double(-1., 1)));
+
+  std::vector<Point_d> landmarks;
+  std::vector<double> distances;
+  Gudhi::subsampling::choose_n_farthest_points(Kernel(), points, 100, 0, std::back_inserter(landmarks),
+                                               std::back_inserter(distances));
+
+  Gudhi::spatial_searching::Vantage_point_tree<std::vector<Point_d>, Distance> tree(points);
+  std::vector<std::size_t> landmark_indices;
+  std::vector<double> metric_distances;
+  Gudhi::subsampling::choose_n_farthest_points_metric(tree, 100, 0, std::back_inserter(landmark_indices),
+                                                      std::back_inserter(metric_distances));
+
+  BOOST_CHECK(landmark_indices.size() == 100);
+  BOOST_CHECK(metric_distances[0] == std::numeric_limits<double>::infinity());
+  for (std::size_t i = 0; i < landmark_indices.size(); ++i) {
+    BOOST_CHECK(points[landmark_indices[i]] == landmarks[i]);
+    if (i > 0)
+      BOOST_CHECK(std::abs(metric_distances[i] - std::sqrt(distances[i])) < 1e-12);
+  }
+}
@@ -41,3 +41,33 @@ BOOST_AUTO_TEST_CASE(test_sparsify_point_set)
 
   BOOST_CHECK(points.size() > results.size());
 }
+
+BOOST_AUTO_TEST_CASE(test_sparsify_point_set_parallel)
+{
+  typedef CGAL::Epick_d<CGAL::Dimension_tag<4> >   K;
+  typedef typename K::Point_d                      Point_d;
+
+  CGAL::Random rd;
+
+  std::vector<Point_d> points;
+  for (int i = 0 ; i < 500 ; ++i)
+    points.push_back(Point_d(rd.get_double(-1.,1),rd.get_double(-1.,1),rd.get_double(-1.,1),rd.get_double(-1.,1)));
+
+  K k;
+  std::vector<Point_d> sequential_results;
+  Gudhi::subsampling::sparsify_point_set(k, points, 0.5, std::back_inserter(sequential_results));
+
+  std::vector<Point_d> results;
+  Gudhi::subsampling::sparsify_point_set_parallel(k, points, 0.5, std::back_inserter(results));
+  std::clog << "After parallel sparsification: " << results.size() << " points.\n";
+  BOOST_CHECK(results == sequential_results);
+
+  std::vector<Point_d> shuffled_results;
+  Gudhi::subsampling::sparsify_point_set_parallel(k, points, 0.5, std::back_inserter(shuffled_results), false);
+  std::clog << "After parallel sparsification with random priorities: " << shuffled_results.size() << " points.\n";
+  BOOST_CHECK(points.size() > shuffled_results.size());
+  auto sqdist = k.squared_distance_d_object();
+  for (std::size_t i = 0; i < shuffled_results.size(); ++i)
+    for (std::size_t j = i + 1; j < shuffled_results.size(); ++j)
+      BOOST_CHECK(sqdist(shuffled_results[i], shuffled_results[j]) >= 0.5);
+}
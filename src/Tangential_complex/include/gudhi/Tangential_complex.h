@@ -16,6 +16,9 @@
 #include <gudhi/Tangential_complex/Simplicial_complex.h>
 #include <gudhi/Tangential_complex/utilities.h>
 #include <gudhi/Kd_tree_search.h>
+#ifdef GUDHI_TC_USE_APPROXIMATE_NEIGHBORS_FOR_TANGENT_SPACE_ESTIM
+#include <gudhi/Random_projection_forest.h>
+#endif
 #include <gudhi/console_color.h>
 #include <gudhi/Clock.h>
 #include <gudhi/Simplex_tree.h>
@@ -253,6 +256,9 @@ class Tangential_complex {
 #endif
         ,
         m_points_ds(m_points),
+#ifdef GUDHI_TC_USE_APPROXIMATE_NEIGHBORS_FOR_TANGENT_SPACE_ESTIM
+        m_approx_points_ds(points_coordinates()),
+#endif
         m_last_max_perturb(0.),
         m_are_tangent_spaces_computed(m_points.size(), false),
         m_tangent_spaces(m_points.size(), Tangent_space_basis())
@@ -1183,6 +1189,22 @@ class Tangential_complex {
     }
   }
 
+#ifdef GUDHI_TC_USE_APPROXIMATE_NEIGHBORS_FOR_TANGENT_SPACE_ESTIM
+  std::vector<double> point_coordinates(const Point &p) const {
+    typename K::Compute_coordinate_d coord = m_k.compute_coordinate_d_object();
+    std::vector<double> coords(m_ambient_dim);
+    for (int i = 0; i < m_ambient_dim; ++i) coords[i] = CGAL::to_double(coord(p, i));
+    return coords;
+  }
+
+  std::vector<std::vector<double>> points_coordinates() const {
+    std::vector<std::vector<double>> coords;
+    coords.reserve(m_points.size());
+    for (const Point &p : m_points) coords.push_back(point_coordinates(p));
+    return coords;
+  }
+#endif
+
   // Estimates tangent subspaces using PCA
 
   Tangent_space_basis compute_tangent_space(const Point &p, const std::size_t i, bool normalize_basis = true,
@@ -1198,6 +1220,9 @@ class Tangential_complex {
 #ifdef GUDHI_TC_USE_ANOTHER_POINT_SET_FOR_TANGENT_SPACE_ESTIM
     KNS_range kns_range = m_points_ds_for_tse.k_nearest_neighbors(p, num_pts_for_pca, false);
     const Points &points_for_pca = m_points_for_tse;
+#elif defined(GUDHI_TC_USE_APPROXIMATE_NEIGHBORS_FOR_TANGENT_SPACE_ESTIM)
+    auto kns_range = m_approx_points_ds.k_nearest_neighbors(point_coordinates(p), num_pts_for_pca, false);
+    const Points &points_for_pca = m_points;
 #else
     KNS_range kns_range = m_points_ds.k_nearest_neighbors(p, num_pts_for_pca, false);
     const Points &points_for_pca = m_points;
@@ -1277,6 +1302,9 @@ class Tangential_complex {
 #ifdef GUDHI_TC_USE_ANOTHER_POINT_SET_FOR_TANGENT_SPACE_ESTIM
       KNS_range kns_range = m_points_ds_for_tse.k_nearest_neighbors(p, num_pts_for_pca, false);
       const Points &points_for_pca = m_points_for_tse;
+#elif defined(GUDHI_TC_USE_APPROXIMATE_NEIGHBORS_FOR_TANGENT_SPACE_ESTIM)
+      auto kns_range = m_approx_points_ds.k_nearest_neighbors(point_coordinates(p), num_pts_for_pca, false);
+      const Points &points_for_pca = m_points;
 #else
       KNS_range kns_range = m_points_ds.k_nearest_neighbors(p, num_pts_for_pca, false);
       const Points &points_for_pca = m_points;
@@ -2012,6 +2040,10 @@ class Tangential_complex {
 #endif
 
   Points_ds m_points_ds;
+#ifdef GUDHI_TC_USE_APPROXIMATE_NEIGHBORS_FOR_TANGENT_SPACE_ESTIM
+  // Only used to find the neighbors for the PCA, the stars need exact neighbors
+  Gudhi::spatial_searching::Random_projection_forest m_approx_points_ds;
+#endif
   double m_last_max_perturb;
   std::vector<bool> m_are_tangent_spaces_computed;
   TS_container m_tangent_spaces;
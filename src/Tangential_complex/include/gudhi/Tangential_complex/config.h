@@ -22,6 +22,8 @@
 // ========================= Strategy ==========================================
 #define GUDHI_TC_PERTURB_POSITION
 // #define GUDHI_TC_PERTURB_WEIGHT
+// Approximate neighbors (random projection forest) for the tangent space estimation, useful in high dimension
+// #define GUDHI_TC_USE_APPROXIMATE_NEIGHBORS_FOR_TANGENT_SPACE_ESTIM
 
 // ========================= Parameters ========================================
 
@@ -0,0 +1,72 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+
+#include <gudhi/Lazy_toplex_map.h>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+using Simplex = Gudhi::Lazy_toplex_map::Simplex;
+
+std::vector<Simplex> r_vector_simplices(std::size_t n, std::size_t max_d, std::size_t m) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> vertex_dis(1, n);
+  std::uniform_int_distribution<std::size_t> dim_dis(1, max_d);
+  std::vector<Simplex> v;
+  for (std::size_t i = 0; i < m; i++) {
+    Simplex s;
+    std::size_t d = dim_dis(gen);
+    while (s.size() < d) s.insert(vertex_dis(gen));
+    v.push_back(s);
+  }
+  return v;
+}
+
+int main() {
+  const std::size_t n = 100000;
+  const std::size_t m = 1000000;
+#ifndef GUDHI_USE_TBB
+  std::clog << "Warning: GUDHI_USE_TBB is not defined, the concurrent insertion is done sequentially" << std::endl;
+#endif
+  for (std::size_t d = 5; d <= 20; d += 5) {
+    std::vector<Simplex> simplices = r_vector_simplices(n, d, m);
+
+    auto start = std::chrono::system_clock::now();
+    Gudhi::Lazy_toplex_map serial_tm;
+    for (const Simplex& s : simplices) serial_tm.insert_simplex(s);
+    auto end = std::chrono::system_clock::now();
+    auto serial = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    start = std::chrono::system_clock::now();
+    Gudhi::Lazy_toplex_map concurrent_tm;
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), simplices.size(),
+                      [&](std::size_t i) { concurrent_tm.concurrent_insert_simplex(simplices[i]); });
+#else
+    for (const Simplex& s : simplices) concurrent_tm.concurrent_insert_simplex(s);
+#endif
+    auto staged = std::chrono::system_clock::now();
+    concurrent_tm.merge_concurrent_insertions();
+    end = std::chrono::system_clock::now();
+    auto staging = std::chrono::duration_cast<std::chrono::milliseconds>(staged - start).count();
+    auto concurrent = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::clog << "d=" << d << " - " << m << " insertions - serial: " << serial << " ms (size "
+              << serial_tm.num_maximal_simplices() << ") - concurrent: " << concurrent << " ms, including "
+              << staging << " ms of staging (size " << concurrent_tm.num_maximal_simplices() << ")" << std::endl;
+  }
+  return 0;
+}
@@ -15,6 +15,7 @@
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/Toplex_map.h>
 #include <gudhi/Lazy_toplex_map.h>
+#include <gudhi/Flat_toplex_map.h>
 
 using namespace Gudhi;
 
@@ -114,6 +115,8 @@ int main() {
     std::clog << "d=" << d << " \t  Insertions \t   Membership \t Contractions \t        Size" << std::endl;
     std::clog << "T Map \t \t";
     chrono<Toplex_map>(n, d);
+    std::clog << "Flat \t \t";
+    chrono<Flat_toplex_map>(n, d);
     std::clog << "Lazy \t \t";
     chrono<Lazy_toplex_map>(n, d);
     if (d <= 15) {
@@ -41,6 +41,17 @@ namespace Gudhi {
  * The performances are a lot better than the `Simplex_tree` as soon you use maximal simplices and not simplices
  * (cf. \cite DBLP:journals/corr/BoissonnatS16 ).
  *
+ * `Flat_toplex_map` provides the same operations with a flat storage: the toplices are stored sorted and contiguously
+ * in a single array, identified by integers and found from their vertices with an open addressing hash table. It avoids
+ * one memory allocation per toplex, and membership and maximality queries do not allocate memory.
+ *
+ * \section toplexmapstrongcollapse Strong collapse
+ *
+ * `toplex_map::strong_collapse()` removes the dominated vertices of a `Toplex_map` or of a `Flat_toplex_map`, i.e. the
+ * vertices whose maximal cofaces all contain a same other vertex, until there are none. This preserves the homotopy
+ * type of the complex, and `toplex_map::insert_maximal_simplices()` then builds a (much smaller) `Simplex_tree` for
+ * persistence computation.
+ *
  */
 /** @} */  // end defgroup toplex_map
 
@@ -0,0 +1,460 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef FLAT_TOPLEX_MAP_H
+#define FLAT_TOPLEX_MAP_H
+
+#include <gudhi/Debug_utils.h>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <algorithm>  // for std::sort, std::binary_search, std::find
+#include <iterator>  // for std::distance
+#include <limits>
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+/**
+ * \brief Toplex map data structure for representing unfiltered simplicial complexes, with a flat storage.
+ *
+ * \details Like `Toplex_map`, a Flat_toplex_map is an unordered map from vertices to maximal simplices (aka.
+ * toplices), but the toplices are not stored as `std::shared_ptr<std::set<Vertex>>`:
+ * - the vertices of all the toplices are stored sorted and contiguously in an arena, where each toplex is identified
+ * by a 32-bit Simplex_id;
+ * - the toplices are found from their vertices with an open addressing hash table of Simplex_id, whose hash function
+ * is the sum of a hash of the vertices. It can thus be computed for the facets of a simplex without building them;
+ * - each vertex is associated to the vector of the Simplex_id of the toplices that contain it.
+ *
+ * The queries `membership()`, `maximality()` and the insertion of a simplex that is already in the complex do not
+ * allocate memory.
+ *
+ * The vertex ranges given to the methods must not contain the same vertex twice.
+ *
+ * \ingroup toplex_map */
+class Flat_toplex_map {
+ public:
+  /** Vertex is the type of vertices. */
+  using Vertex = std::size_t;
+
+  /** Simplex is the type of simplices: a sorted vector of vertices. */
+  using Simplex = std::vector<Vertex>;
+
+  /** The type of the identifiers of maximal simplices. */
+  using Simplex_id = std::uint32_t;
+
+  /** The type of the range of the sorted vertices of a maximal simplex, see `simplex()`. */
+  using Simplex_vertex_range = boost::iterator_range<const Vertex*>;
+
+  /** \brief Adds the given simplex to the complex.
+   * Nothing happens if the simplex is already in the complex (i.e. it is a face of one of the toplices), or if it is
+   * empty. */
+  template <typename Input_vertex_range>
+  void insert_simplex(const Input_vertex_range& vertex_range);
+
+  /** \brief Removes the given simplex and its cofaces from the complex.
+   * The faces of the removed toplices which do not contain the simplex are kept inside. Removing the empty simplex
+   * removes everything. */
+  template <typename Input_vertex_range>
+  void remove_simplex(const Input_vertex_range& vertex_range);
+
+  /** Does a simplex belong to the complex ? */
+  template <typename Input_vertex_range>
+  bool membership(const Input_vertex_range& vertex_range) const;
+
+  /** Does a simplex is a toplex ? */
+  template <typename Input_vertex_range>
+  bool maximality(const Input_vertex_range& vertex_range) const;
+
+  /** Gives the identifiers of the maximal cofaces of a simplex.
+   * Gives all the toplices if given the empty simplex.
+   * Gives not more than max_number maximal cofaces if max_number is strictly positive. */
+  template <typename Input_vertex_range>
+  std::vector<Simplex_id> maximal_cofaces(const Input_vertex_range& vertex_range,
+                                          const std::size_t max_number = 0) const;
+
+  /** Gives the identifiers of the maximal simplices.
+   * Gives not more than max_number maximal cofaces if max_number is strictly positive. */
+  std::vector<Simplex_id> maximal_simplices(const std::size_t max_number = 0) const {
+    return maximal_cofaces(Simplex(), max_number);
+  }
+
+  /** \brief Gives the sorted vertices of a maximal simplex.
+   * The range is invalidated by any modification of the complex. */
+  Simplex_vertex_range simplex(const Simplex_id id) const {
+    const Vertex* first = arena.data() + records[id].offset;
+    return Simplex_vertex_range(first, first + records[id].size);
+  }
+
+  /** Contracts one edge in the complex.
+   * The edge has to verify the link condition if you want to preserve topology.
+   * Returns the remaining vertex. */
+  Vertex contraction(const Vertex x, const Vertex y);
+
+  /** Remove the vertex and all its cofaces from the complex. */
+  void remove_vertex(const Vertex x);
+
+  /** \brief Number of maximal simplices. */
+  std::size_t num_maximal_simplices() const { return num_toplices; }
+
+  /** \brief Number of vertices. */
+  std::size_t num_vertices() const { return t0.size(); }
+
+  std::set<Vertex> unitary_collapse(const Vertex k, const Vertex d);
+
+  /** Adds the given simplex to the complex.
+   * The simplex must not be in the complex already, and it must not contain one of the current toplices. */
+  template <typename Input_vertex_range>
+  void insert_independent_simplex(const Input_vertex_range& vertex_range);
+
+ private:
+  struct Simplex_record {
+    std::size_t offset;  // position of the first vertex in the arena.
+    std::size_t size;
+    std::uint64_t hash;
+    bool alive;
+  };
+
+  static constexpr Simplex_id empty_slot = std::numeric_limits<Simplex_id>::max();
+  static constexpr Simplex_id erased_slot = empty_slot - 1;
+  static constexpr Simplex_id null_id = empty_slot;
+
+  // Hash of a vertex, the hash of a simplex being the sum of the hashes of its vertices (splitmix64 finalizer).
+  static std::uint64_t vertex_hash(Vertex v) {
+    std::uint64_t z = static_cast<std::uint64_t>(v) + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  template <typename Input_vertex_range>
+  static std::uint64_t simplex_hash(const Input_vertex_range& vertex_range) {
+    std::uint64_t h = 0;
+    for (const Vertex& v : vertex_range) h += vertex_hash(v);
+    return h;
+  }
+
+  bool contains(const Simplex_id id, const Vertex v) const {
+    const Vertex* first = arena.data() + records[id].offset;
+    return std::binary_search(first, first + records[id].size, v);
+  }
+
+  // Is the given simplex, deprived of the vertex skip if skip_vertex, a face of the toplex id ?
+  template <typename Input_vertex_range>
+  bool is_face(const Input_vertex_range& vertex_range, const Simplex_id id, bool skip_vertex = false,
+               Vertex skip = 0) const {
+    for (const Vertex& v : vertex_range)
+      if (!(skip_vertex && v == skip) && !contains(id, v)) return false;
+    return true;
+  }
+
+  // Is the toplex id a face of the given simplex ?
+  template <typename Input_vertex_range>
+  bool is_coface(const Input_vertex_range& vertex_range, const Simplex_id id) const {
+    for (const Vertex& v : simplex(id))
+      if (std::find(vertex_range.begin(), vertex_range.end(), v) == vertex_range.end()) return false;
+    return true;
+  }
+
+  // Finds the toplex of the given hash for which equal(id) is true.
+  template <typename Equal>
+  Simplex_id find_toplex(const std::uint64_t hash, const Equal& equal) const {
+    if (table.empty()) return null_id;
+    const std::size_t mask = table.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+      const Simplex_id id = table[i];
+      if (id == empty_slot) return null_id;
+      if (id != erased_slot && records[id].hash == hash && equal(id)) return id;
+    }
+  }
+
+  // Finds the toplex equal to the given simplex of the given size and hash, deprived of skip if skip_vertex.
+  template <typename Input_vertex_range>
+  Simplex_id find_toplex(const Input_vertex_range& vertex_range, const std::size_t size, const std::uint64_t hash,
+                         bool skip_vertex = false, Vertex skip = 0) const {
+    return find_toplex(hash, [&](Simplex_id id) {
+      return records[id].size == size && is_face(vertex_range, id, skip_vertex, skip);
+    });
+  }
+
+  // Gives the toplices containing the vertex of the simplex which is in the least toplices, nullptr if one of the
+  // vertices is in no toplex.
+  template <typename Input_vertex_range>
+  const std::vector<Simplex_id>* best_index(const Input_vertex_range& vertex_range) const {
+    const std::vector<Simplex_id>* best = nullptr;
+    for (const Vertex& v : vertex_range) {
+      auto it = t0.find(v);
+      if (it == t0.end()) return nullptr;
+      if (best == nullptr || it->second.size() < best->size()) best = &it->second;
+    }
+    return best;
+  }
+
+  void insert_in_table(const Simplex_id id);
+  void rehash(const std::size_t new_size);
+  void compact_arena();
+
+  /** \internal Removes a toplex without adding facets after. */
+  void erase_maximal(const Simplex_id id);
+
+  /** \internal The vertices of the toplices, sorted for each toplex. */
+  std::vector<Vertex> arena;
+  std::vector<Simplex_record> records;
+  std::vector<Simplex_id> free_ids;
+  std::size_t erased_vertices = 0;  // number of vertices of the arena which are not in a toplex anymore.
+
+  /** \internal Open addressing hash table with linear probing, whose size is a power of 2. */
+  std::vector<Simplex_id> table;
+  std::size_t used_slots = 0;  // number of slots which are not empty, including the erased ones.
+
+  /** \internal The map from vertices to toplices */
+  std::unordered_map<Vertex, std::vector<Simplex_id>> t0;
+  std::size_t num_toplices = 0;
+};
+
+template <typename Input_vertex_range>
+void Flat_toplex_map::insert_simplex(const Input_vertex_range& vertex_range) {
+  if (vertex_range.begin() == vertex_range.end()) return;
+  if (membership(vertex_range)) return;
+  const std::size_t size = std::distance(vertex_range.begin(), vertex_range.end());
+  const std::uint64_t hash = simplex_hash(vertex_range);
+  // If all the facets are toplices, they are the only toplices included in the simplex.
+  std::vector<Simplex_id> facet_ids;
+  if (size > 1) {
+    for (const Vertex& v : vertex_range) {
+      Simplex_id id = find_toplex(vertex_range, size - 1, hash - vertex_hash(v), true, v);
+      if (id == null_id) break;
+      facet_ids.push_back(id);
+    }
+  }
+  if (facet_ids.size() == size) {
+    for (const Simplex_id id : facet_ids) erase_maximal(id);
+  } else {
+    for (const Vertex& v : vertex_range) {
+      auto it = t0.find(v);
+      if (it == t0.end()) continue;
+      // Copy needed because the vector is modified
+      for (const Simplex_id id : std::vector<Simplex_id>(it->second))
+        if (is_coface(vertex_range, id)) erase_maximal(id);
+    }
+  }
+  insert_independent_simplex(vertex_range);
+}
+
+template <typename Input_vertex_range>
+void Flat_toplex_map::remove_simplex(const Input_vertex_range& vertex_range) {
+  if (vertex_range.begin() == vertex_range.end()) {
+    // Removal of the empty simplex means cleaning everything
+    *this = Flat_toplex_map();
+    return;
+  }
+  const std::vector<Simplex_id>* cofaces = best_index(vertex_range);
+  if (cofaces == nullptr) return;
+  // Copy needed because the vector is modified
+  for (const Simplex_id id : std::vector<Simplex_id>(*cofaces)) {
+    if (!is_face(vertex_range, id)) continue;
+    Simplex sigma(simplex(id).begin(), simplex(id).end());
+    erase_maximal(id);
+    // The faces of sigma which do not contain the simplex are the faces of the sigma \ {v}, for v in the simplex.
+    for (const Vertex& v : vertex_range) {
+      Simplex facet;
+      facet.reserve(sigma.size() - 1);
+      for (const Vertex& w : sigma)
+        if (w != v) facet.push_back(w);
+      insert_simplex(facet);
+    }
+  }
+}
+
+template <typename Input_vertex_range>
+bool Flat_toplex_map::membership(const Input_vertex_range& vertex_range) const {
+  if (vertex_range.begin() == vertex_range.end()) return num_toplices > 0;
+  const std::vector<Simplex_id>* cofaces = best_index(vertex_range);
+  if (cofaces == nullptr) return false;
+  if (maximality(vertex_range)) return true;
+  for (const Simplex_id id : *cofaces)
+    if (is_face(vertex_range, id)) return true;
+  return false;
+}
+
+template <typename Input_vertex_range>
+bool Flat_toplex_map::maximality(const Input_vertex_range& vertex_range) const {
+  return find_toplex(vertex_range, std::distance(vertex_range.begin(), vertex_range.end()),
+                     simplex_hash(vertex_range)) != null_id;
+}
+
+template <typename Input_vertex_range>
+std::vector<Flat_toplex_map::Simplex_id> Flat_toplex_map::maximal_cofaces(const Input_vertex_range& vertex_range,
+                                                                          const std::size_t max_number) const {
+  std::vector<Simplex_id> cofaces;
+  if (vertex_range.begin() == vertex_range.end()) {
+    for (Simplex_id id = 0; id < records.size(); id++)
+      if (records[id].alive) {
+        cofaces.push_back(id);
+        if (cofaces.size() == max_number) return cofaces;
+      }
+    return cofaces;
+  }
+  Simplex_id id = find_toplex(vertex_range, std::distance(vertex_range.begin(), vertex_range.end()),
+                              simplex_hash(vertex_range));
+  if (id != null_id) {
+    cofaces.push_back(id);
+    return cofaces;
+  }
+  const std::vector<Simplex_id>* candidates = best_index(vertex_range);
+  if (candidates != nullptr)
+    for (const Simplex_id id : *candidates)
+      if (is_face(vertex_range, id)) {
+        cofaces.push_back(id);
+        if (cofaces.size() == max_number) return cofaces;
+      }
+  return cofaces;
+}
+
+inline Flat_toplex_map::Vertex Flat_toplex_map::contraction(const Vertex x, const Vertex y) {
+  auto x_it = t0.find(x);
+  auto y_it = t0.find(y);
+  if (x_it == t0.end()) return y;
+  if (y_it == t0.end()) return x;
+  Vertex k, d;
+  if (x_it->second.size() > y_it->second.size())
+    k = x, d = y;
+  else
+    k = y, d = x;
+  // Copy needed because the vector is modified
+  for (const Simplex_id id : std::vector<Simplex_id>(t0.at(d))) {
+    Simplex sigma(simplex(id).begin(), simplex(id).end());
+    erase_maximal(id);
+    sigma.erase(std::find(sigma.begin(), sigma.end(), d));
+    auto position = std::lower_bound(sigma.begin(), sigma.end(), k);
+    if (position == sigma.end() || *position != k) sigma.insert(position, k);
+    insert_simplex(sigma);
+  }
+  return k;
+}
+
+inline std::set<Flat_toplex_map::Vertex> Flat_toplex_map::unitary_collapse(const Vertex k, const Vertex d) {
+  std::set<Vertex> r;
+  // Copy needed because the vector is modified
+  for (const Simplex_id id : std::vector<Simplex_id>(t0.at(d))) {
+    Simplex sigma(simplex(id).begin(), simplex(id).end());
+    erase_maximal(id);
+    sigma.erase(std::find(sigma.begin(), sigma.end(), d));
+    r.insert(sigma.begin(), sigma.end());
+    auto position = std::lower_bound(sigma.begin(), sigma.end(), k);
+    if (position == sigma.end() || *position != k) sigma.insert(position, k);
+    insert_simplex(sigma);
+  }
+  return r;
+}
+
+inline void Flat_toplex_map::remove_vertex(const Vertex x) {
+  auto it = t0.find(x);
+  if (it == t0.end()) return;
+  // Copy needed because the vector is modified
+  for (const Simplex_id id : std::vector<Simplex_id>(it->second)) {
+    Simplex sigma(simplex(id).begin(), simplex(id).end());
+    erase_maximal(id);
+    sigma.erase(std::find(sigma.begin(), sigma.end(), x));
+    insert_simplex(sigma);
+  }
+}
+
+template <typename Input_vertex_range>
+void Flat_toplex_map::insert_independent_simplex(const Input_vertex_range& vertex_range) {
+  Simplex_id id;
+  if (free_ids.empty()) {
+    GUDHI_CHECK(records.size() < erased_slot, "Flat_toplex_map::insert_independent_simplex - too many toplices");
+    id = records.size();
+    records.emplace_back();
+  } else {
+    id = free_ids.back();
+    free_ids.pop_back();
+  }
+  Simplex_record& record = records[id];
+  record.offset = arena.size();
+  arena.insert(arena.end(), vertex_range.begin(), vertex_range.end());
+  std::sort(arena.begin() + record.offset, arena.end());
+  record.size = arena.size() - record.offset;
+  record.hash = simplex_hash(vertex_range);
+  // Marked alive only once placed, otherwise a rehash would already put it in the table.
+  insert_in_table(id);
+  record.alive = true;
+  for (const Vertex& v : vertex_range) t0[v].push_back(id);
+  num_toplices++;
+}
+
+inline void Flat_toplex_map::erase_maximal(const Simplex_id id) {
+  for (const Vertex& v : simplex(id)) {
+    auto it = t0.find(v);
+    std::vector<Simplex_id>& ids = it->second;
+    *std::find(ids.begin(), ids.end(), id) = ids.back();
+    ids.pop_back();
+    if (ids.empty()) t0.erase(it);
+  }
+  const std::size_t mask = table.size() - 1;
+  std::size_t i = records[id].hash & mask;
+  while (table[i] != id) i = (i + 1) & mask;
+  table[i] = erased_slot;
+  records[id].alive = false;
+  free_ids.push_back(id);
+  erased_vertices += records[id].size;
+  num_toplices--;
+  // The arena is compacted when more than half of it is not used anymore.
+  if (erased_vertices > 256 && 2 * erased_vertices > arena.size()) compact_arena();
+}
+
+inline void Flat_toplex_map::insert_in_table(const Simplex_id id) {
+  // The load factor, erased slots included, is kept below 1/2.
+  if (2 * (used_slots + 1) > table.size()) {
+    std::size_t new_size = 16;
+    while (new_size < 4 * (num_toplices + 1)) new_size *= 2;
+    rehash(new_size);
+  }
+  const std::size_t mask = table.size() - 1;
+  std::size_t i = records[id].hash & mask;
+  while (table[i] != empty_slot && table[i] != erased_slot) i = (i + 1) & mask;
+  if (table[i] == empty_slot) used_slots++;
+  table[i] = id;
+}
+
+inline void Flat_toplex_map::rehash(const std::size_t new_size) {
+  table.assign(new_size, Simplex_id(empty_slot));
+  used_slots = 0;
+  const std::size_t mask = new_size - 1;
+  for (Simplex_id id = 0; id < records.size(); id++) {
+    if (!records[id].alive) continue;
+    std::size_t i = records[id].hash & mask;
+    while (table[i] != empty_slot) i = (i + 1) & mask;
+    table[i] = id;
+    used_slots++;
+  }
+}
+
+inline void Flat_toplex_map::compact_arena() {
+  std::vector<Vertex> new_arena;
+  new_arena.reserve(arena.size() - erased_vertices);
+  for (Simplex_record& record : records) {
+    if (!record.alive) continue;
+    std::size_t offset = new_arena.size();
+    new_arena.insert(new_arena.end(), arena.begin() + record.offset, arena.begin() + record.offset + record.size);
+    record.offset = offset;
+  }
+  arena.swap(new_arena);
+  erased_vertices = 0;
+}
+
+}  // namespace Gudhi
+
+#endif /* FLAT_TOPLEX_MAP_H */
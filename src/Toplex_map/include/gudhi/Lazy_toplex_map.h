@@ -14,6 +14,18 @@
 #include <gudhi/Toplex_map.h>
 #include <boost/heap/fibonacci_heap.hpp>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#endif
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::sort
+#include <functional>  // for std::hash
+
 namespace Gudhi {
 
 /**
@@ -47,6 +59,27 @@ class Lazy_toplex_map {
   template <typename Input_vertex_range>
   bool insert_simplex(const Input_vertex_range &vertex_range);
 
+  /** \brief Stages the given simplex for insertion, like `insert_simplex()`.
+   * Can be called concurrently from several threads, but not concurrently with the other methods. The staged
+   * simplices are inserted in the complex by `merge_concurrent_insertions()`. */
+  template <typename Input_vertex_range>
+  void concurrent_insert_simplex(const Input_vertex_range &vertex_range) {
+    stage_simplex(vertex_range, false);
+  }
+
+  /** \brief Stages the given simplex for insertion, like `insert_independent_simplex()`.
+   * Can be called concurrently from several threads, but not concurrently with the other methods. The staged
+   * simplices are inserted in the complex by `merge_concurrent_insertions()`. */
+  template <typename Input_vertex_range>
+  void concurrent_insert_independent_simplex(const Input_vertex_range &vertex_range) {
+    stage_simplex(vertex_range, true);
+  }
+
+  /** \brief Inserts the simplices staged by `concurrent_insert_simplex()` and
+   * `concurrent_insert_independent_simplex()`, and cleans the complex if it became too large.
+   * The insertion is done in parallel, vertex by vertex, if `GUDHI_USE_TBB` is defined. */
+  void merge_concurrent_insertions();
+
   /** \brief Removes the given simplex and its cofaces from the complex.
    * Its faces are kept inside. */
   template <typename Input_vertex_range>
@@ -78,6 +111,25 @@ class Lazy_toplex_map {
   Vertex best_index(const Input_vertex_range &vertex_range);
   void clean(const Vertex v);
 
+  template <typename Input_vertex_range>
+  void stage_simplex(const Input_vertex_range &vertex_range, bool independent);
+
+  // Simplices staged for insertion. Each thread stages in the stripe given by its id, to reduce the contention between
+  // the inserting threads. The stripes are only buffers: merge_concurrent_insertions groups the simplices by vertex.
+  struct Insertion_shard {
+    std::mutex mutex;
+    std::vector<std::pair<Simplex, bool>> simplices;  // the simplex and whether it is independent
+
+    Insertion_shard() {}
+    Insertion_shard(const Insertion_shard &other) : simplices(other.simplices) {}
+    Insertion_shard &operator=(const Insertion_shard &other) {
+      simplices = other.simplices;
+      return *this;
+    }
+  };
+  static const std::size_t NUM_INSERTION_SHARDS = 64;
+  std::vector<Insertion_shard> insertion_shards = std::vector<Insertion_shard>(NUM_INSERTION_SHARDS);
+
   std::unordered_map<Vertex, std::size_t> gamma0_lbounds;
 
   std::unordered_map<Vertex, Simplex_ptr_set> t0;
@@ -91,6 +143,7 @@ class Lazy_toplex_map {
 
   std::size_t size_lbound = 0;
   std::size_t size = 0;
+  bool cleaning = false;
 
   const double ALPHA = 4;  // time
   const double BETTA = 8;  // memory
@@ -124,10 +177,87 @@ bool Lazy_toplex_map::insert_simplex(const Input_vertex_range &vertex_range) {
     cleaning_priority.update(cp_handles.at(v), std::make_pair(t0.at(v).size() - get_gamma0_lbound(v), v));
   }
   if (inserted) size++;
-  if (size > (size_lbound + 1) * BETTA) clean(cleaning_priority.top().second);
+  // The reinsertions done by clean do not clean again, to avoid a recursion as deep as the number of vertices.
+  if (!cleaning && size > (size_lbound + 1) * BETTA) clean(cleaning_priority.top().second);
   return inserted;
 }
 
+template <typename Input_vertex_range>
+void Lazy_toplex_map::stage_simplex(const Input_vertex_range &vertex_range, bool independent) {
+  Simplex sigma(vertex_range.begin(), vertex_range.end());
+  Insertion_shard &shard =
+      insertion_shards[std::hash<std::thread::id>()(std::this_thread::get_id()) % NUM_INSERTION_SHARDS];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.simplices.emplace_back(std::move(sigma), independent);
+}
+
+inline void Lazy_toplex_map::merge_concurrent_insertions() {
+  std::vector<Simplex_ptr> staged;
+  for (Insertion_shard &shard : insertion_shards) {
+    for (auto &simplex_independent : shard.simplices) {
+      if (simplex_independent.second) {
+        for (const Vertex &v : simplex_independent.first) gamma0_lbounds[v]++;
+        size_lbound++;
+      }
+      staged.push_back(std::make_shared<Simplex>(std::move(simplex_independent.first)));
+    }
+    shard.simplices.clear();
+  }
+  if (staged.empty()) return;
+
+  // Group the simplices by vertex, so that each set of t0 is only modified by one thread
+  std::vector<std::pair<Vertex, std::size_t>> vertex_simplex;
+  empty_toplex = true;
+  for (std::size_t i = 0; i < staged.size(); i++) {
+    if (!staged[i]->empty()) empty_toplex = false;
+    for (const Vertex &v : *staged[i]) vertex_simplex.emplace_back(v, i);
+  }
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_sort(vertex_simplex.begin(), vertex_simplex.end());
+#else
+  std::sort(vertex_simplex.begin(), vertex_simplex.end());
+#endif
+  std::vector<std::size_t> group_begins;
+  for (std::size_t i = 0; i < vertex_simplex.size(); i++) {
+    if (i > 0 && vertex_simplex[i].first == vertex_simplex[i - 1].first) continue;
+    group_begins.push_back(i);
+    const Vertex v = vertex_simplex[i].first;
+    if (!t0.count(v)) {
+      t0.emplace(v, Simplex_ptr_set());
+      auto v_handle = cleaning_priority.push(std::make_pair(0, v));
+      cp_handles.emplace(v, v_handle);
+    }
+  }
+  group_begins.push_back(vertex_simplex.size());
+
+  // A simplex is new if it was not in the set of its first vertex yet
+  std::vector<char> inserted(staged.size(), 0);
+  auto insert_group = [&](std::size_t g) {
+    Simplex_ptr_set &simplices = t0.at(vertex_simplex[group_begins[g]].first);
+    for (std::size_t i = group_begins[g]; i < group_begins[g + 1]; i++) {
+      const std::size_t s = vertex_simplex[i].second;
+      bool new_simplex = simplices.emplace(staged[s]).second;
+      if (vertex_simplex[i].first == *staged[s]->begin()) inserted[s] = new_simplex;
+    }
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), group_begins.size() - 1, insert_group);
+#else
+  for (std::size_t g = 0; g + 1 < group_begins.size(); g++) insert_group(g);
+#endif
+
+  for (std::size_t g = 0; g + 1 < group_begins.size(); g++) {
+    const Vertex v = vertex_simplex[group_begins[g]].first;
+    cleaning_priority.update(cp_handles.at(v), std::make_pair(t0.at(v).size() - get_gamma0_lbound(v), v));
+  }
+  for (char new_simplex : inserted) size += new_simplex;
+
+  // Final clean pass
+  while (size > (size_lbound + 1) * BETTA && !cleaning_priority.empty() && cleaning_priority.top().first > 0 &&
+         t0.count(cleaning_priority.top().second))
+    clean(cleaning_priority.top().second);
+}
+
 template <typename Input_vertex_range>
 void Lazy_toplex_map::remove_simplex(const Input_vertex_range &vertex_range) {
   if (vertex_range.begin() == vertex_range.end()) {
@@ -251,7 +381,9 @@ void Lazy_toplex_map::clean(const Vertex v) {
   auto clean_cofaces = toplices.maximal_cofaces(sv);
   size_lbound = size_lbound - get_gamma0_lbound(v) + clean_cofaces.size();
   gamma0_lbounds[v] = clean_cofaces.size();
+  cleaning = true;
   for (const Simplex_ptr &sptr : clean_cofaces) insert_simplex(*sptr);
+  cleaning = false;
 }
 
 }  // namespace Gudhi
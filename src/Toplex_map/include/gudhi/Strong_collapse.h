@@ -0,0 +1,177 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef STRONG_COLLAPSE_H_
+#define STRONG_COLLAPSE_H_
+
+#include <gudhi/Toplex_map.h>
+#include <gudhi/Flat_toplex_map.h>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+#include <unordered_set>
+#include <algorithm>  // for std::set_intersection, std::sort, std::unique
+#include <iterator>  // for std::back_inserter
+#include <cstddef>  // for std::size_t
+
+namespace Gudhi {
+
+namespace toplex_map {
+
+/** \private Calls f on the sorted vertex range of each maximal coface of the vertex v. */
+template <typename Function>
+void for_each_maximal_coface(const Toplex_map& complex, Toplex_map::Vertex v, Function&& f) {
+  for (const Toplex_map::Simplex_ptr& sptr : complex.maximal_cofaces(Toplex_map::Simplex{v})) f(*sptr);
+}
+
+/** \private */
+template <typename Function>
+void for_each_maximal_coface(const Flat_toplex_map& complex, Flat_toplex_map::Vertex v, Function&& f) {
+  for (Flat_toplex_map::Simplex_id id : complex.maximal_cofaces(Flat_toplex_map::Simplex{v})) f(complex.simplex(id));
+}
+
+/** \private Calls f on the sorted vertex range of each maximal simplex. */
+template <typename Function>
+void for_each_maximal_simplex(const Toplex_map& complex, Function&& f) {
+  for (const Toplex_map::Simplex_ptr& sptr : complex.maximal_simplices()) f(*sptr);
+}
+
+/** \private */
+template <typename Function>
+void for_each_maximal_simplex(const Flat_toplex_map& complex, Function&& f) {
+  for (Flat_toplex_map::Simplex_id id : complex.maximal_simplices()) f(complex.simplex(id));
+}
+
+/** \private
+ * A vertex v is dominated by another vertex v' if all the maximal simplices that contain v also contain v', i.e. if
+ * the link of v is a cone of apex v'. It is the case iff the intersection of the maximal cofaces of v contains another
+ * vertex than v.
+ */
+template <typename Toplex_map_type>
+bool is_dominated(const Toplex_map_type& complex, typename Toplex_map_type::Vertex v) {
+  using Vertex = typename Toplex_map_type::Vertex;
+  std::vector<Vertex> intersection;
+  std::vector<Vertex> buffer;
+  bool first = true;
+  bool empty = false;
+  for_each_maximal_coface(complex, v, [&](const auto& simplex) {
+    if (empty) return;
+    if (first) {
+      intersection.assign(simplex.begin(), simplex.end());
+      first = false;
+    } else {
+      buffer.clear();
+      std::set_intersection(intersection.begin(), intersection.end(), simplex.begin(), simplex.end(),
+                            std::back_inserter(buffer));
+      intersection.swap(buffer);
+    }
+    // v is always in the intersection
+    empty = (intersection.size() <= 1);
+  });
+  return !first && !empty;
+}
+
+/** \brief Strong collapse of a simplicial complex given by its maximal simplices.
+ *
+ * \details Removes the dominated vertices of the complex, one at a time, until there are none. A vertex is dominated
+ * if all the maximal simplices that contain it also contain another vertex, and its removal is a strong collapse
+ * that preserves the homotopy type of the complex (cf. \cite boissonnat_et_al:LIPIcs:2015:5098).
+ *
+ * The domination of the candidate vertices is checked in parallel when `GUDHI_USE_TBB` is defined, the collapses
+ * themselves are done sequentially. Only the neighbors of the removed vertices are candidates in the next round.
+ *
+ * @param[in,out] complex A `Toplex_map` or a `Flat_toplex_map`.
+ * @return The number of removed vertices.
+ */
+template <typename Toplex_map_type>
+std::size_t strong_collapse(Toplex_map_type& complex) {
+  using Vertex = typename Toplex_map_type::Vertex;
+  std::vector<Vertex> candidates;
+  for_each_maximal_simplex(complex, [&](const auto& simplex) {
+    candidates.insert(candidates.end(), simplex.begin(), simplex.end());
+  });
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  std::size_t num_removed = 0;
+  std::vector<char> dominated;
+  while (!candidates.empty()) {
+    dominated.assign(candidates.size(), 0);
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), candidates.size(),
+                      [&](std::size_t i) { dominated[i] = is_dominated(complex, candidates[i]); });
+#else
+    for (std::size_t i = 0; i < candidates.size(); i++) dominated[i] = is_dominated(complex, candidates[i]);
+#endif
+    // The vertices whose maximal cofaces changed during this round, their domination has to be checked again.
+    std::unordered_set<Vertex> modified;
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+      const Vertex v = candidates[i];
+      if (!dominated[i]) continue;
+      if (modified.count(v) && !is_dominated(complex, v)) continue;
+      for_each_maximal_coface(complex, v, [&](const auto& simplex) { modified.insert(simplex.begin(), simplex.end()); });
+      complex.remove_vertex(v);
+      num_removed++;
+    }
+    candidates.clear();
+    for (const Vertex v : modified)
+      if (complex.membership(std::vector<Vertex>{v})) candidates.push_back(v);
+    std::sort(candidates.begin(), candidates.end());
+  }
+  return num_removed;
+}
+
+/** \brief Inserts the simplices of a complex given by its maximal simplices in a simplicial complex, typically a
+ * `Simplex_tree`, for instance to compute the persistence of a collapsed complex.
+ *
+ * @param[in] complex A `Toplex_map` or a `Flat_toplex_map`.
+ * @param[out] simplicial_complex The simplicial complex, it must provide `insert_simplex_and_subfaces` and
+ * `Vertex_handle` like `Simplex_tree`.
+ * @param[in] max_dimension Only the simplices of dimension lower or equal to max_dimension are inserted if it is
+ * non-negative.
+ */
+template <typename Toplex_map_type, typename SimplicialComplex>
+void insert_maximal_simplices(const Toplex_map_type& complex, SimplicialComplex& simplicial_complex,
+                              int max_dimension = -1) {
+  using Vertex_handle = typename SimplicialComplex::Vertex_handle;
+  std::vector<Vertex_handle> vertices;
+  std::vector<Vertex_handle> face;
+  std::vector<std::size_t> positions;
+  for_each_maximal_simplex(complex, [&](const auto& simplex) {
+    vertices.assign(simplex.begin(), simplex.end());
+    const std::size_t face_size = max_dimension + 1;
+    if (max_dimension < 0 || vertices.size() <= face_size) {
+      simplicial_complex.insert_simplex_and_subfaces(vertices);
+      return;
+    }
+    // All the faces of dimension max_dimension, in lexicographic order of their positions in the simplex.
+    positions.resize(face_size);
+    for (std::size_t i = 0; i < face_size; i++) positions[i] = i;
+    while (true) {
+      face.clear();
+      for (std::size_t p : positions) face.push_back(vertices[p]);
+      simplicial_complex.insert_simplex_and_subfaces(face);
+      std::size_t i = face_size;
+      while (i > 0 && positions[i - 1] == vertices.size() - face_size + i - 1) i--;
+      if (i == 0) break;
+      positions[i - 1]++;
+      for (std::size_t j = i; j < face_size; j++) positions[j] = positions[j - 1] + 1;
+    }
+  });
+}
+
+}  // namespace toplex_map
+
+}  // namespace Gudhi
+
+#endif  // STRONG_COLLAPSE_H_
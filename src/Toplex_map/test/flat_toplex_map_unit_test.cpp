@@ -0,0 +1,220 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <gudhi/Flat_toplex_map.h>
+#include <gudhi/Toplex_map.h>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "flat toplex map"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(flat_toplex_map) {
+  using Vertex = Gudhi::Flat_toplex_map::Vertex;
+
+  Gudhi::Flat_toplex_map tm;
+  std::clog << "insert_simplex {1, 2, 3, 4}" << std::endl;
+  std::vector<Vertex> sigma1 = {1, 2, 3, 4};
+  tm.insert_simplex(sigma1);
+  std::clog << "insert_simplex {5, 2, 3, 6}" << std::endl;
+  std::vector<Vertex> sigma2 = {5, 2, 3, 6};
+  tm.insert_simplex(sigma2);
+  std::clog << "insert_simplex {5}" << std::endl;
+  std::vector<Vertex> sigma3 = {5};
+  tm.insert_simplex(sigma3);
+  std::clog << "insert_simplex {4, 5, 3}" << std::endl;
+  std::vector<Vertex> sigma6 = {4, 5, 3};
+  tm.insert_simplex(sigma6);
+  std::clog << "insert_simplex {4, 5, 9}" << std::endl;
+  std::vector<Vertex> sigma7 = {4, 5, 9};
+  tm.insert_simplex(sigma7);
+
+  std::clog << "num_maximal_simplices" << tm.num_maximal_simplices() << std::endl;
+  BOOST_CHECK(tm.num_maximal_simplices() == 4);
+  BOOST_CHECK(tm.num_vertices() == 7);
+  // Browse maximal simplices
+  std::clog << "Maximal simplices are :" << std::endl;
+  for (auto id : tm.maximal_simplices()) {
+    for (auto v : tm.simplex(id)) {
+      std::clog << v << ", ";
+    }
+    std::clog << std::endl;
+    BOOST_CHECK(tm.maximality(tm.simplex(id)));
+  }
+
+  BOOST_CHECK(tm.maximality(sigma1));
+  BOOST_CHECK(tm.maximality(sigma2));
+  BOOST_CHECK(!tm.maximality(sigma3));
+  BOOST_CHECK(tm.maximality(sigma6));
+  BOOST_CHECK(tm.maximality(sigma7));
+
+  std::vector<Vertex> sigma4 = {5, 2, 3};
+  std::vector<Vertex> sigma5 = {5, 2, 7};
+  BOOST_CHECK(tm.membership(sigma4));
+  BOOST_CHECK(!tm.membership(sigma5));
+  BOOST_CHECK(tm.maximal_cofaces(sigma4).size() == 1);
+  BOOST_CHECK(tm.maximal_cofaces(std::vector<Vertex>{5}).size() == 3);
+  std::clog << "insert_simplex {5, 2, 7}" << std::endl;
+  tm.insert_simplex(sigma5);
+
+  std::clog << "num_maximal_simplices" << tm.num_maximal_simplices() << std::endl;
+  BOOST_CHECK(tm.num_maximal_simplices() == 5);
+  BOOST_CHECK(tm.membership(sigma5));
+
+  std::clog << "contraction(4,5)" << std::endl;
+  auto r = tm.contraction(4, 5);
+  std::clog << "r=" << r << std::endl;
+  BOOST_CHECK(r == 5);
+
+  std::clog << "num_maximal_simplices" << tm.num_maximal_simplices() << std::endl;
+  BOOST_CHECK(tm.num_maximal_simplices() == 4);
+  // Browse maximal simplices
+  std::clog << "Maximal simplices are :" << std::endl;
+  for (auto id : tm.maximal_simplices()) {
+    for (auto v : tm.simplex(id)) {
+      std::clog << v << ", ";
+    }
+    std::clog << std::endl;
+    BOOST_CHECK(tm.maximality(tm.simplex(id)));
+  }
+
+  std::vector<Vertex> sigma8 = {1, 2, 3};
+  std::vector<Vertex> sigma9 = {2, 7};
+
+  sigma8.emplace_back(r);
+  sigma9.emplace_back(r);
+  BOOST_CHECK(!tm.membership(sigma6));
+  BOOST_CHECK(tm.membership(sigma8));
+  BOOST_CHECK(tm.membership(sigma9));
+
+  std::clog << "remove_simplex({2, 7, r = 5})" << std::endl;
+  tm.remove_simplex(sigma9);
+  BOOST_CHECK(!tm.membership(sigma9));
+
+  std::clog << "num_maximal_simplices" << tm.num_maximal_simplices() << std::endl;
+  BOOST_CHECK(tm.num_maximal_simplices() == 5);
+  // {2, 7, 5} is removed, but verify its edges are still there
+  std::vector<Vertex> edge = {2, 7};
+  BOOST_CHECK(tm.membership(edge));
+  edge = {2, 5};
+  BOOST_CHECK(tm.membership(edge));
+  edge = {7, 5};
+  BOOST_CHECK(tm.membership(edge));
+
+  std::clog << "remove_vertex(7)" << std::endl;
+  tm.remove_vertex(7);
+  edge = {2, 7};
+  BOOST_CHECK(!tm.membership(edge));
+  BOOST_CHECK(tm.num_vertices() == 6);
+
+  std::clog << "remove_simplex({})" << std::endl;
+  tm.remove_simplex(std::vector<Vertex>());
+  BOOST_CHECK(tm.num_maximal_simplices() == 0);
+  BOOST_CHECK(tm.num_vertices() == 0);
+  BOOST_CHECK(!tm.membership(std::vector<Vertex>()));
+}
+
+BOOST_AUTO_TEST_CASE(flat_toplex_map_random_compared_to_toplex_map) {
+  using Simplex = Gudhi::Toplex_map::Simplex;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<std::size_t> vertex_dis(1, 60);
+  std::uniform_int_distribution<std::size_t> dim_dis(1, 6);
+  auto random_simplex = [&]() {
+    Simplex s;
+    std::size_t d = dim_dis(gen);
+    while (s.size() < d) s.insert(vertex_dis(gen));
+    return s;
+  };
+
+  Gudhi::Toplex_map tm;
+  Gudhi::Flat_toplex_map ftm;
+  // Enough insertions to rehash the table several times.
+  for (int i = 0; i < 2000; i++) {
+    Simplex s = random_simplex();
+    tm.insert_simplex(s);
+    ftm.insert_simplex(s);
+    if (i % 200 == 199) {
+      std::size_t x = vertex_dis(gen), y = vertex_dis(gen);
+      if (x != y) BOOST_CHECK(tm.contraction(x, y) == ftm.contraction(x, y));
+    }
+  }
+  // A big simplex removes all the toplices it contains, and the arena is compacted
+  Simplex big;
+  for (std::size_t v = 1; v <= 50; v++) big.insert(v);
+  tm.insert_simplex(big);
+  ftm.insert_simplex(big);
+  BOOST_CHECK(tm.num_maximal_simplices() == ftm.num_maximal_simplices());
+  BOOST_CHECK(tm.num_vertices() == ftm.num_vertices());
+  for (auto id : ftm.maximal_simplices()) BOOST_CHECK(tm.maximality(ftm.simplex(id)));
+  for (int i = 0; i < 5000; i++) {
+    Simplex s = random_simplex();
+    BOOST_CHECK(tm.membership(s) == ftm.membership(s));
+    BOOST_CHECK(tm.maximality(s) == ftm.maximality(s));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(flat_toplex_map_remove_vertex_after_rehash) {
+  using Vertex = Gudhi::Flat_toplex_map::Vertex;
+
+  // The first insertion rehashes the empty table
+  Gudhi::Flat_toplex_map tm;
+  std::vector<Vertex> sigma = {7};
+  tm.insert_simplex(sigma);
+  tm.remove_vertex(7);
+  BOOST_CHECK(tm.num_maximal_simplices() == 0);
+  BOOST_CHECK(!tm.maximality(sigma));
+  BOOST_CHECK(!tm.membership(sigma));
+}
+
+BOOST_AUTO_TEST_CASE(flat_toplex_map_random_insert_remove_compared_to_toplex_map) {
+  using Simplex = Gudhi::Toplex_map::Simplex;
+
+  std::mt19937 gen(17);
+  std::uniform_int_distribution<std::size_t> vertex_dis(1, 40);
+  std::uniform_int_distribution<std::size_t> dim_dis(1, 5);
+  std::uniform_int_distribution<int> op_dis(0, 9);
+  auto random_simplex = [&]() {
+    Simplex s;
+    std::size_t d = dim_dis(gen);
+    while (s.size() < d) s.insert(vertex_dis(gen));
+    return s;
+  };
+
+  Gudhi::Toplex_map tm;
+  Gudhi::Flat_toplex_map ftm;
+  // Long enough to grow, empty and rehash the table several times.
+  for (int i = 0; i < 20000; i++) {
+    int op = op_dis(gen);
+    if (op < 7) {
+      Simplex s = random_simplex();
+      tm.insert_simplex(s);
+      ftm.insert_simplex(s);
+    } else {
+      // Toplex_map::remove_vertex requires the vertex to be in the complex
+      std::size_t x = vertex_dis(gen);
+      if (tm.membership(Simplex{x})) {
+        tm.remove_vertex(x);
+        ftm.remove_vertex(x);
+      }
+    }
+    BOOST_REQUIRE(tm.num_maximal_simplices() == ftm.num_maximal_simplices());
+    if (i % 100 == 0) {
+      for (auto id : ftm.maximal_simplices()) BOOST_CHECK(tm.maximality(ftm.simplex(id)));
+      for (int j = 0; j < 50; j++) {
+        Simplex s = random_simplex();
+        BOOST_CHECK(tm.membership(s) == ftm.membership(s));
+        BOOST_CHECK(tm.maximality(s) == ftm.maximality(s));
+      }
+    }
+  }
+}
@@ -10,8 +10,13 @@
 
 #include <iostream>
 #include <vector>
+#include <random>
 #include <gudhi/Lazy_toplex_map.h>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "lazy toplex map"
 #include <boost/test/unit_test.hpp>
@@ -156,3 +161,44 @@ BOOST_AUTO_TEST_CASE(toplex_map_empty_toplex) {
   std::clog << "Check the edge 2,7 is not a member." << std::endl;
   BOOST_CHECK(!tm.membership(edge));
 }
+
+BOOST_AUTO_TEST_CASE(toplex_map_concurrent_insertion) {
+  using Vertex = Gudhi::Lazy_toplex_map::Vertex;
+  using Simplex = Gudhi::Lazy_toplex_map::Simplex;
+
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<Vertex> vertex_dis(1, 50);
+  std::uniform_int_distribution<std::size_t> dim_dis(1, 5);
+  auto random_simplex = [&]() {
+    Simplex s;
+    std::size_t d = dim_dis(gen);
+    while (s.size() < d) s.insert(vertex_dis(gen));
+    return s;
+  };
+  std::vector<Simplex> simplices;
+  for (int i = 0; i < 2000; i++) simplices.push_back(random_simplex());
+
+  Gudhi::Lazy_toplex_map serial_tm;
+  for (const Simplex& s : simplices) serial_tm.insert_simplex(s);
+
+  Gudhi::Lazy_toplex_map tm;
+  // A first batch, then a second one on top of a non-empty complex
+  for (std::size_t batch = 0; batch < 2; batch++) {
+    std::size_t first = batch * simplices.size() / 2;
+    std::size_t last = (batch + 1) * simplices.size() / 2;
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(first, last, [&](std::size_t i) { tm.concurrent_insert_simplex(simplices[i]); });
+#else
+    for (std::size_t i = first; i < last; i++) tm.concurrent_insert_simplex(simplices[i]);
+#endif
+    tm.merge_concurrent_insertions();
+  }
+  std::clog << "num_maximal_simplices = " << tm.num_maximal_simplices() << " - serial = "
+            << serial_tm.num_maximal_simplices() << std::endl;
+  BOOST_CHECK(tm.num_vertices() == serial_tm.num_vertices());
+  for (const Simplex& s : simplices) BOOST_CHECK(tm.membership(s));
+  for (int i = 0; i < 2000; i++) {
+    Simplex s = random_simplex();
+    BOOST_CHECK(tm.membership(s) == serial_tm.membership(s));
+  }
+}
@@ -0,0 +1,115 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>  // for std::find
+#include <gudhi/Strong_collapse.h>
+#include <gudhi/Toplex_map.h>
+#include <gudhi/Flat_toplex_map.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "strong collapse"
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+using Toplex_map_types = boost::mpl::list<Gudhi::Toplex_map, Gudhi::Flat_toplex_map>;
+using Simplex_tree = Gudhi::Simplex_tree<>;
+
+std::vector<int> betti_numbers(const Simplex_tree& st_in, int max_dimension) {
+  Simplex_tree st(st_in);
+  st.initialize_filtration();
+  Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree, Gudhi::persistent_cohomology::Field_Zp> pcoh(st);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  std::vector<int> bns;
+  for (int dim = 0; dim <= max_dimension; dim++) bns.push_back(pcoh.betti_number(dim));
+  return bns;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(strong_collapse_cone, Toplex_map_type, Toplex_map_types) {
+  using Vertex = typename Toplex_map_type::Vertex;
+  Toplex_map_type tm;
+  // Cone of apex 0 over the boundary of the triangle {1, 2, 3}
+  tm.insert_simplex(std::vector<Vertex>{0, 1, 2});
+  tm.insert_simplex(std::vector<Vertex>{0, 2, 3});
+  tm.insert_simplex(std::vector<Vertex>{0, 1, 3});
+  std::size_t num_removed = Gudhi::toplex_map::strong_collapse(tm);
+  std::clog << "strong_collapse removed " << num_removed << " vertices" << std::endl;
+  BOOST_CHECK(num_removed == 3);
+  BOOST_CHECK(tm.num_vertices() == 1);
+  BOOST_CHECK(tm.num_maximal_simplices() == 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(strong_collapse_minimal_complex, Toplex_map_type, Toplex_map_types) {
+  using Vertex = typename Toplex_map_type::Vertex;
+  Toplex_map_type tm;
+  // Boundary of a triangle and an isolated vertex, no vertex is dominated
+  tm.insert_simplex(std::vector<Vertex>{0, 1});
+  tm.insert_simplex(std::vector<Vertex>{1, 2});
+  tm.insert_simplex(std::vector<Vertex>{0, 2});
+  tm.insert_simplex(std::vector<Vertex>{5});
+  BOOST_CHECK(Gudhi::toplex_map::strong_collapse(tm) == 0);
+  BOOST_CHECK(tm.num_vertices() == 4);
+  BOOST_CHECK(tm.num_maximal_simplices() == 4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(strong_collapse_preserves_homology, Toplex_map_type, Toplex_map_types) {
+  using Vertex = typename Toplex_map_type::Vertex;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<Vertex> vertex_dis(0, 40);
+  std::uniform_int_distribution<std::size_t> dim_dis(1, 4);
+  Toplex_map_type tm;
+  for (int i = 0; i < 80; i++) {
+    std::vector<Vertex> simplex;
+    std::size_t size = dim_dis(gen);
+    while (simplex.size() < size) {
+      Vertex v = vertex_dis(gen);
+      if (std::find(simplex.begin(), simplex.end(), v) == simplex.end()) simplex.push_back(v);
+    }
+    tm.insert_simplex(simplex);
+  }
+  Simplex_tree st;
+  Gudhi::toplex_map::insert_maximal_simplices(tm, st);
+  std::size_t num_vertices = tm.num_vertices();
+
+  std::size_t num_removed = Gudhi::toplex_map::strong_collapse(tm);
+  std::clog << "strong_collapse removed " << num_removed << " vertices out of " << num_vertices << std::endl;
+  BOOST_CHECK(num_removed > 0);
+  BOOST_CHECK(tm.num_vertices() + num_removed == num_vertices);
+  Simplex_tree collapsed_st;
+  Gudhi::toplex_map::insert_maximal_simplices(tm, collapsed_st);
+  BOOST_CHECK(collapsed_st.num_simplices() < st.num_simplices());
+  BOOST_CHECK(betti_numbers(st, 3) == betti_numbers(collapsed_st, 3));
+
+  // Nothing is dominated anymore
+  BOOST_CHECK(Gudhi::toplex_map::strong_collapse(tm) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(insert_maximal_simplices_max_dimension) {
+  using Vertex = Gudhi::Flat_toplex_map::Vertex;
+  Gudhi::Flat_toplex_map tm;
+  tm.insert_simplex(std::vector<Vertex>{0, 1, 2, 3});
+  tm.insert_simplex(std::vector<Vertex>{3, 4});
+
+  Simplex_tree st;
+  Gudhi::toplex_map::insert_maximal_simplices(tm, st);
+  BOOST_CHECK(st.num_simplices() == 15 + 2);
+  BOOST_CHECK(st.dimension() == 3);
+
+  Simplex_tree skeleton;
+  Gudhi::toplex_map::insert_maximal_simplices(tm, skeleton, 1);
+  // 5 vertices and 7 edges
+  BOOST_CHECK(skeleton.num_simplices() == 12);
+  BOOST_CHECK(skeleton.dimension() == 1);
+}
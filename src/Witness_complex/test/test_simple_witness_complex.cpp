@@ -6,10 +6,13 @@
 #include <gudhi/Simplex_tree.h>
 
 #include <gudhi/Witness_complex.h>
+#include <gudhi/Random_projection_forest.h>
 
 #include <iostream>
 #include <vector>
 #include <utility>
+#include <random>
+#include <algorithm>  // for sort
 
 
 BOOST_AUTO_TEST_CASE(simple_witness_complex) {
@@ -51,3 +54,43 @@ BOOST_AUTO_TEST_CASE(simple_witness_complex) {
   BOOST_CHECK(stree2.num_simplices() == 25);
 
 }
+
+BOOST_AUTO_TEST_CASE(witness_complex_from_random_projection_forest) {
+  using Point = std::vector<double>;
+  using Points_ds = Gudhi::spatial_searching::Random_projection_forest;
+  using Nearest_landmark_table = std::vector<Points_ds::KNS_range>;
+  using Witness_complex = Gudhi::witness_complex::Witness_complex<Nearest_landmark_table>;
+  using Simplex_tree = Gudhi::Simplex_tree<>;
+
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dis(-1., 1.);
+  std::vector<Point> landmarks, witnesses;
+  for (int i = 0; i < 12; ++i) landmarks.push_back({dis(gen), dis(gen), dis(gen)});
+  for (int i = 0; i < 60; ++i) witnesses.push_back({dis(gen), dis(gen), dis(gen)});
+
+  // Brute force nearest landmark table
+  Nearest_landmark_table brute_force_nlt;
+  for (auto const& w : witnesses) {
+    Points_ds::KNS_range range;
+    for (std::size_t l = 0; l < landmarks.size(); ++l) {
+      double sq = 0;
+      for (std::size_t i = 0; i < w.size(); ++i) sq += (w[i] - landmarks[l][i]) * (w[i] - landmarks[l][i]);
+      range.emplace_back(l, sq);
+    }
+    std::sort(range.begin(), range.end(), [](std::pair<std::size_t, double> const& a,
+                                             std::pair<std::size_t, double> const& b) { return a.second < b.second; });
+    brute_force_nlt.push_back(range);
+  }
+
+  // Same table from the forest, exact thanks to a large search_k
+  Points_ds landmarks_ds(landmarks, 3, 4);
+  Nearest_landmark_table forest_nlt;
+  for (auto const& w : witnesses)
+    forest_nlt.push_back(landmarks_ds.k_nearest_neighbors(w, landmarks.size(), true, 3 * landmarks.size()));
+
+  Simplex_tree brute_force_stree, forest_stree;
+  Witness_complex(brute_force_nlt).create_complex(brute_force_stree, 0.5);
+  Witness_complex(forest_nlt).create_complex(forest_stree, 0.5);
+  BOOST_CHECK(forest_stree.num_simplices() > landmarks.size());
+  BOOST_CHECK(brute_force_stree == forest_stree);
+}
@@ -69,6 +69,47 @@ namespace Gudhi {
  `Gudhi::read_persistence_intervals_in_dimension()`.
  
 
+ \section FileFormatsPersArchive Persistence Diagram Archive
+
+ Such a binary file, whose extension is usually `.pda`, contains many persistence diagrams. It can be mapped in memory
+ and its intervals used without parsing nor copying, which matters when thousands of diagrams are loaded.
+ All the numbers are stored in the byte order of the machine that wrote the file, and every field is aligned on 8 bytes.
+ The file is made of:
+ - a header of 48 bytes: the 8 characters `GUDHIPDA`, the 32-bit integer `0x01020304` (to detect a different byte
+ order), the 32-bit format version (1), and the 64-bit unsigned numbers of diagrams `nd`, of blocks `nb`, of intervals
+ `ni`, and the offset of the index in the file;
+ - the `ni` intervals, as pairs of 64-bit floating point numbers (birth, death). The intervals of a diagram are
+ contiguous, and grouped in blocks of the same dimension, by increasing dimension (-1 stands for an unknown dimension);
+ - the index: the `nd + 1` 64-bit offsets of the first block of every diagram (the last one is `nb`), the `nb` 64-bit
+ dimensions of the blocks, and the `nb + 1` 64-bit offsets of the first interval of every block (the last one is `ni`).
+
+ Such files can be written with `Gudhi::Persistence_diagram_archive_writer` or
+ `Gudhi::write_persistence_diagram_archive()`, and read with `Gudhi::Persistence_diagram_archive`. The representations
+ of the \ref Persistence_representations module also accept them, through
+ `Gudhi::Persistence_representations::read_persistence_intervals_in_one_dimension_from_file()` for a single diagram, and
+ `Gudhi::Persistence_representations::read_persistence_intervals_in_one_dimension_from_archive()` for many diagrams.
+
+
+ \section FileFormatsHasseBoundaryMatrix Hasse Boundary Matrix
+
+ Such a binary file, whose extension is usually `.hbm`, contains the boundary matrix of a filtered complex in
+ compressed sparse row form, the simplices being sorted by filtration order. It can be mapped in memory and used to
+ compute persistence without parsing, which matters to hand off large complexes between programs.
+ All the numbers are stored in the byte order of the machine that wrote the file.
+ The file is made of:
+ - a header of 40 bytes: the 8 characters `GUDHIHBM`, the 32-bit integer `0x01020304` (to detect a different byte
+ order), the 32-bit format version (1), the 64-bit unsigned numbers of simplices `n` and of boundary entries `m`, and
+ the 64-bit dimension of the complex (-1 if it is empty);
+ - the `n + 1` 64-bit offsets of the first boundary entry of every simplex (the last one is `m`);
+ - the `n` filtration values, as 64-bit floating point numbers;
+ - the `m` boundary entries, as 32-bit positions of the faces in the filtration, which are lower than the position of
+ the simplex;
+ - the `n` dimensions of the simplices, as 32-bit integers.
+
+ Such files can be written from any filtered complex, for instance a `Gudhi::Simplex_tree` or a `Gudhi::Hasse_complex`,
+ with `Gudhi::write_hasse_boundary_matrix()`, and read with `Gudhi::Mapped_hasse_complex`.
+
+
  \section FileFormatsIsoCuboid Iso-cuboid
 
  Such a file describes an iso-oriented cuboid with diagonal opposite vertices (min_x, min_y, min_z,...) and (max_x, max_y, max_z, ...). The format is:<br>
@@ -0,0 +1,280 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef PERSISTENCE_DIAGRAM_ARCHIVE_H_
+#define PERSISTENCE_DIAGRAM_ARCHIVE_H_
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>  // for std::lower_bound
+#include <cstdint>  // for std::uint64_t
+#include <cstring>  // for std::memcpy, std::memcmp
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>  // for std::invalid_argument
+#include <string>
+#include <utility>  // for std::pair
+#include <vector>
+
+namespace Gudhi {
+
+// Keep this file tag for Doxygen to parse the code, otherwise, functions are not documented.
+// It is required for global functions and variables.
+
+/** @file
+ * @brief This file includes the reader and the writer of binary archives of persistence diagrams, see
+ * \ref FileFormatsPersArchive.
+ */
+
+namespace persistence_diagram_archive_detail {
+
+constexpr char magic[8] = {'G', 'U', 'D', 'H', 'I', 'P', 'D', 'A'};
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+constexpr std::uint32_t version = 1;
+
+// The header, at the beginning of the file. All the fields have a size multiple of 8 bytes, so that the intervals,
+// which follow it, are aligned.
+struct Header {
+  char magic[8];
+  std::uint32_t byte_order_mark;
+  std::uint32_t version;
+  std::uint64_t number_of_diagrams;
+  std::uint64_t number_of_blocks;
+  std::uint64_t number_of_intervals;
+  std::uint64_t index_offset;
+};
+
+inline void throw_invalid_archive(std::string const& filename, std::string const& reason) {
+  std::string error_str("Persistence_diagram_archive - ");
+  error_str.append(filename).append(": ").append(reason);
+  std::cerr << error_str << std::endl;
+  throw std::invalid_argument(error_str);
+}
+
+}  // namespace persistence_diagram_archive_detail
+
+/**
+ * @brief Checks whether a file is a binary archive of persistence diagrams (see \ref FileFormatsPersArchive), by
+ * reading its first bytes.
+ */
+inline bool is_persistence_diagram_archive(std::string const& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  char magic[sizeof(persistence_diagram_archive_detail::magic)];
+  if (!in.read(magic, sizeof(magic))) return false;
+  return std::memcmp(magic, persistence_diagram_archive_detail::magic, sizeof(magic)) == 0;
+}
+
+/**
+ * @brief Writes persistence diagrams, one after the other, to a binary archive (see \ref FileFormatsPersArchive).
+ *
+ * @details Only the index of the archive, whose size is proportional to the number of diagrams and dimensions, is kept
+ * in memory. It is written, with the header, by close() or by the destructor.
+ */
+class Persistence_diagram_archive_writer {
+ public:
+  /** @brief Creates the archive. Throws std::invalid_argument if the file cannot be opened. */
+  explicit Persistence_diagram_archive_writer(std::string const& filename)
+      : filename_(filename), out_(filename, std::ios::binary | std::ios::trunc), diagram_blocks_(1, 0),
+        block_intervals_(1, 0) {
+    if (!out_.is_open()) persistence_diagram_archive_detail::throw_invalid_archive(filename, "Unable to open file");
+    // The header is written again by close(), with the right sizes.
+    write_header(0);
+  }
+
+  /** @brief Closes the archive if close() was not called. Errors are only reported on std::cerr. */
+  ~Persistence_diagram_archive_writer() {
+    try {
+      if (out_.is_open()) close();
+    } catch (std::invalid_argument const&) {
+    }
+  }
+
+  /** @brief Adds a diagram given as a map from the dimensions to the persistence intervals, as returned by
+   * Gudhi::read_persistence_intervals_grouped_by_dimension(). Dimension -1 stands for an unknown dimension. */
+  void add_diagram(std::map<int, std::vector<std::pair<double, double>>> const& intervals_by_dimension) {
+    for (auto const& dimension_and_intervals : intervals_by_dimension)
+      add_block(dimension_and_intervals.first, dimension_and_intervals.second);
+    diagram_blocks_.push_back(block_dimensions_.size());
+  }
+
+  /** @brief Adds a diagram given as a range of (birth, death) pairs, all in dimension `dimension` (-1 if unknown). */
+  template <typename Interval_range>
+  void add_diagram(Interval_range const& intervals, int dimension = -1) {
+    add_block(dimension, intervals);
+    diagram_blocks_.push_back(block_dimensions_.size());
+  }
+
+  /** @brief Writes the index and the header, and closes the file. No diagram can be added afterwards. */
+  void close() {
+    std::uint64_t index_offset = sizeof(persistence_diagram_archive_detail::Header) +
+                                 2 * sizeof(double) * block_intervals_.back();
+    write(diagram_blocks_.data(), diagram_blocks_.size());
+    write(block_dimensions_.data(), block_dimensions_.size());
+    write(block_intervals_.data(), block_intervals_.size());
+    out_.seekp(0);
+    write_header(index_offset);
+    out_.close();
+    if (out_.fail()) persistence_diagram_archive_detail::throw_invalid_archive(filename_, "Unable to write file");
+  }
+
+ private:
+  template <typename Interval_range>
+  void add_block(int dimension, Interval_range const& intervals) {
+    std::uint64_t number_of_intervals = 0;
+    for (auto const& interval : intervals) {
+      double birth_and_death[2] = {interval.first, interval.second};
+      write(birth_and_death, 2);
+      ++number_of_intervals;
+    }
+    // Empty blocks are not stored. The blocks of a diagram are sorted by dimension, as the keys of a map.
+    if (number_of_intervals == 0) return;
+    block_dimensions_.push_back(dimension);
+    block_intervals_.push_back(block_intervals_.back() + number_of_intervals);
+  }
+
+  void write_header(std::uint64_t index_offset) {
+    persistence_diagram_archive_detail::Header header;
+    std::memcpy(header.magic, persistence_diagram_archive_detail::magic, sizeof(header.magic));
+    header.byte_order_mark = persistence_diagram_archive_detail::byte_order_mark;
+    header.version = persistence_diagram_archive_detail::version;
+    header.number_of_diagrams = diagram_blocks_.size() - 1;
+    header.number_of_blocks = block_dimensions_.size();
+    header.number_of_intervals = block_intervals_.back();
+    header.index_offset = index_offset;
+    write(&header, 1);
+  }
+
+  template <typename T>
+  void write(T const* data, std::size_t size) {
+    out_.write(reinterpret_cast<char const*>(data), sizeof(T) * size);
+  }
+
+  std::string filename_;
+  std::ofstream out_;
+  // For every diagram, the index of its first block, followed by the number of blocks.
+  std::vector<std::uint64_t> diagram_blocks_;
+  // For every block, i.e. the intervals of one dimension of one diagram, its dimension.
+  std::vector<std::int64_t> block_dimensions_;
+  // For every block, the index of its first interval, followed by the number of intervals.
+  std::vector<std::uint64_t> block_intervals_;
+};
+
+/**
+ * @brief Writes persistence diagrams, given as ranges of (birth, death) pairs all in dimension `dimension` (-1 if
+ * unknown), to a binary archive (see \ref FileFormatsPersArchive).
+ */
+template <typename Diagram_range>
+void write_persistence_diagram_archive(std::string const& filename, Diagram_range const& diagrams,
+                                       int dimension = -1) {
+  Persistence_diagram_archive_writer writer(filename);
+  for (auto const& diagram : diagrams) writer.add_diagram(diagram, dimension);
+  writer.close();
+}
+
+/**
+ * @brief Read-only access to a binary archive of persistence diagrams (see \ref FileFormatsPersArchive).
+ *
+ * @details The file is mapped in memory, and the persistence intervals are returned as ranges pointing into the
+ * mapping, without any copy. These ranges are valid as long as the Persistence_diagram_archive exists.
+ */
+class Persistence_diagram_archive {
+ public:
+  /** @brief A persistence interval (birth, death). */
+  typedef std::pair<double, double> Interval;
+  /** @brief A range of persistence intervals, pointing into the mapped file. */
+  typedef boost::iterator_range<Interval const*> Interval_range;
+
+  /** @brief Maps the archive in memory. Throws std::invalid_argument if the file is not a valid archive. */
+  explicit Persistence_diagram_archive(std::string const& filename) {
+    using namespace persistence_diagram_archive_detail;
+    static_assert(sizeof(Interval) == 2 * sizeof(double), "Intervals must be stored as two doubles");
+    if (!is_persistence_diagram_archive(filename)) throw_invalid_archive(filename, "Not a persistence diagram archive");
+    try {
+      boost::interprocess::file_mapping mapping(filename.c_str(), boost::interprocess::read_only);
+      region_ = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+    } catch (boost::interprocess::interprocess_exception const& e) {
+      throw_invalid_archive(filename, e.what());
+    }
+    char const* data = static_cast<char const*>(region_.get_address());
+    const std::size_t size = region_.get_size();
+
+    Header header;
+    if (size < sizeof(Header)) throw_invalid_archive(filename, "Truncated header");
+    std::memcpy(&header, data, sizeof(Header));
+    if (header.byte_order_mark != byte_order_mark) throw_invalid_archive(filename, "Wrong byte order");
+    if (header.version != version) throw_invalid_archive(filename, "Unsupported version");
+    // Check the sizes before computing the end of the index, to avoid overflows.
+    if (header.number_of_intervals > size / (2 * sizeof(double)) || header.number_of_blocks > size / 8 ||
+        header.number_of_diagrams > size / 8 ||
+        header.index_offset != sizeof(Header) + 2 * sizeof(double) * header.number_of_intervals ||
+        header.index_offset + 8 * (header.number_of_diagrams + 2 * header.number_of_blocks + 2) > size)
+      throw_invalid_archive(filename, "Truncated file");
+
+    number_of_diagrams_ = header.number_of_diagrams;
+    intervals_ = reinterpret_cast<Interval const*>(data + sizeof(Header));
+    diagram_blocks_ = reinterpret_cast<std::uint64_t const*>(data + header.index_offset);
+    block_dimensions_ = reinterpret_cast<std::int64_t const*>(diagram_blocks_ + number_of_diagrams_ + 1);
+    block_intervals_ = reinterpret_cast<std::uint64_t const*>(block_dimensions_ + header.number_of_blocks);
+
+    // The offsets must be increasing and end with the sizes, so that the ranges are always in the file.
+    for (std::size_t i = 0; i < number_of_diagrams_; ++i)
+      if (diagram_blocks_[i] > diagram_blocks_[i + 1]) throw_invalid_archive(filename, "Corrupted index");
+    if (diagram_blocks_[0] != 0 || diagram_blocks_[number_of_diagrams_] != header.number_of_blocks)
+      throw_invalid_archive(filename, "Corrupted index");
+    for (std::size_t i = 0; i < header.number_of_blocks; ++i)
+      if (block_intervals_[i] > block_intervals_[i + 1]) throw_invalid_archive(filename, "Corrupted index");
+    if (block_intervals_[0] != 0 || block_intervals_[header.number_of_blocks] != header.number_of_intervals)
+      throw_invalid_archive(filename, "Corrupted index");
+  }
+
+  /** @brief Returns the number of diagrams in the archive. */
+  std::size_t size() const { return number_of_diagrams_; }
+
+  /** @brief Returns the dimensions of the intervals of the i-th diagram, in increasing order. */
+  std::vector<int> dimensions(std::size_t i) const {
+    return std::vector<int>(block_dimensions_ + diagram_blocks_[i], block_dimensions_ + diagram_blocks_[i + 1]);
+  }
+
+  /** @brief Returns the intervals of the i-th diagram in dimension `dimension`, or all its intervals, sorted by
+   * dimension, if `dimension` is -1. As for Gudhi::read_persistence_intervals_in_dimension(), the intervals of unknown
+   * dimension are returned only in the latter case. */
+  Interval_range intervals(std::size_t i, int dimension = -1) const {
+    std::int64_t const* first = block_dimensions_ + diagram_blocks_[i];
+    std::int64_t const* last = block_dimensions_ + diagram_blocks_[i + 1];
+    if (dimension == -1) return block_range(first - block_dimensions_, last - block_dimensions_);
+    std::int64_t const* block = std::lower_bound(first, last, dimension);
+    if (block == last || *block != dimension) return Interval_range(intervals_, intervals_);
+    return block_range(block - block_dimensions_, block + 1 - block_dimensions_);
+  }
+
+  /** @brief Returns the intervals of all the diagrams, one diagram after the other. The ranges returned by intervals()
+   * are subranges of this one. */
+  Interval_range all_intervals() const { return block_range(0, diagram_blocks_[number_of_diagrams_]); }
+
+ private:
+  // The intervals of the blocks first, ..., last - 1.
+  Interval_range block_range(std::size_t first, std::size_t last) const {
+    return Interval_range(intervals_ + block_intervals_[first], intervals_ + block_intervals_[last]);
+  }
+
+  boost::interprocess::mapped_region region_;
+  std::size_t number_of_diagrams_;
+  Interval const* intervals_;
+  std::uint64_t const* diagram_blocks_;
+  std::int64_t const* block_dimensions_;
+  std::uint64_t const* block_intervals_;
+};
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENCE_DIAGRAM_ARCHIVE_H_
@@ -0,0 +1,94 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/Persistence_diagram_archive.h>
+#include <gudhi/reader_utils.h>
+
+#include <fstream>
+#include <iterator>  // for istreambuf_iterator
+#include <limits>  // for inf
+#include <map>
+#include <stdexcept>  // for std::invalid_argument
+#include <utility>  // for pair
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "persistence_diagram_archive"
+#include <boost/test/unit_test.hpp>
+
+using Persistence_intervals_by_dimension = std::map<int, std::vector<std::pair<double, double>>>;
+using Persistence_intervals = std::vector<std::pair<double, double>>;
+
+Persistence_intervals to_vector(Gudhi::Persistence_diagram_archive::Interval_range const& intervals) {
+  return Persistence_intervals(intervals.begin(), intervals.end());
+}
+
+BOOST_AUTO_TEST_CASE( persistence_diagram_archive_round_trip )
+{
+  Persistence_intervals_by_dimension with_dimension =
+      Gudhi::read_persistence_intervals_grouped_by_dimension("persistence_intervals_with_dimension.pers");
+  Persistence_intervals without_dimension = {{1., 2.}, {0., std::numeric_limits<double>::infinity()}};
+  {
+    Gudhi::Persistence_diagram_archive_writer writer("persistence_intervals.pda");
+    writer.add_diagram(with_dimension);
+    writer.add_diagram(Persistence_intervals());
+    writer.add_diagram(without_dimension);
+    writer.add_diagram(without_dimension, 1);
+    // The destructor writes the index.
+  }
+
+  Gudhi::Persistence_diagram_archive archive("persistence_intervals.pda");
+  BOOST_CHECK(archive.size() == 4);
+
+  std::vector<int> dimensions;
+  for (auto const& dimension_and_intervals : with_dimension) {
+    dimensions.push_back(dimension_and_intervals.first);
+    BOOST_CHECK(to_vector(archive.intervals(0, dimension_and_intervals.first)) == dimension_and_intervals.second);
+  }
+  BOOST_CHECK(archive.dimensions(0) == dimensions);
+  BOOST_CHECK(to_vector(archive.intervals(0)).size() == 4);
+  BOOST_CHECK(archive.intervals(0, 7).empty());
+
+  BOOST_CHECK(archive.dimensions(1).empty());
+  BOOST_CHECK(archive.intervals(1).empty());
+
+  BOOST_CHECK(archive.dimensions(2) == std::vector<int>{-1});
+  BOOST_CHECK(to_vector(archive.intervals(2)) == without_dimension);
+  BOOST_CHECK(archive.intervals(2, 1).empty());
+
+  BOOST_CHECK(archive.dimensions(3) == std::vector<int>{1});
+  BOOST_CHECK(to_vector(archive.intervals(3, 1)) == without_dimension);
+
+  BOOST_CHECK(archive.all_intervals().size() == 8);
+  BOOST_CHECK(archive.intervals(2).begin() == archive.all_intervals().begin() + 4);
+}
+
+BOOST_AUTO_TEST_CASE( persistence_diagram_archive_invalid_files )
+{
+  BOOST_CHECK(!Gudhi::is_persistence_diagram_archive("persistence_intervals_with_dimension.pers"));
+  BOOST_CHECK_THROW(Gudhi::Persistence_diagram_archive("persistence_intervals_with_dimension.pers"),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(Gudhi::Persistence_diagram_archive("does_not_exist.pda"), std::invalid_argument);
+
+  Persistence_intervals intervals = {{1., 2.}, {3., 4.}};
+  Gudhi::write_persistence_diagram_archive("truncated.pda", std::vector<Persistence_intervals>{intervals, intervals});
+  std::vector<char> content;
+  {
+    std::ifstream in("truncated.pda", std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  BOOST_CHECK(Gudhi::Persistence_diagram_archive("truncated.pda").size() == 2);
+  {
+    std::ofstream out("truncated.pda", std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size() - 8);
+  }
+  BOOST_CHECK(Gudhi::is_persistence_diagram_archive("truncated.pda"));
+  BOOST_CHECK_THROW(Gudhi::Persistence_diagram_archive("truncated.pda"), std::invalid_argument);
+}
@@ -12,6 +12,12 @@
 
 #include <pybind11_diagram_utils.h>
 
+#include <pybind11/stl.h>
+
+#include <vector>
+#include <utility>  // for std::declval
+#include <algorithm>  // for std::copy
+
 // For compatibility with older versions, we want to support e=None.
 // In C++17, the recommended way is std::optional<double>.
 double bottleneck(Dgm d1, Dgm d2, py::object epsilon)
@@ -27,6 +33,40 @@ double bottleneck(Dgm d1, Dgm d2, py::object epsilon)
   return Gudhi::persistence_diagram::bottleneck_distance(diag1, diag2, e);
 }
 
+typedef decltype(numpy_to_range_of_pairs(std::declval<Dgm>())) Dgm_range;
+
+static std::vector<Dgm_range> numpy_to_ranges_of_pairs(std::vector<Dgm> const& dgms) {
+  std::vector<Dgm_range> ranges;
+  for (auto const& dgm : dgms) ranges.push_back(numpy_to_range_of_pairs(dgm));
+  return ranges;
+}
+
+// diagrams_2=None means the symmetric matrix of diagrams_1
+py::array_t<double> bottleneck_matrix(std::vector<Dgm> const& diagrams_1, py::object diagrams_2, py::object epsilon)
+{
+  double e = (std::numeric_limits<double>::min)();
+  if (!epsilon.is_none()) e = epsilon.cast<double>();
+  // The input arrays (kept alive by the vectors) must outlive the ranges.
+  std::vector<Dgm> dgms_2;
+  if (!diagrams_2.is_none()) dgms_2 = diagrams_2.cast<std::vector<Dgm>>();
+  auto diags1 = numpy_to_ranges_of_pairs(diagrams_1);
+  auto diags2 = numpy_to_ranges_of_pairs(dgms_2);
+  std::size_t n1 = diags1.size();
+  std::size_t n2 = diagrams_2.is_none() ? n1 : diags2.size();
+
+  std::vector<double> matrix;
+  {
+    py::gil_scoped_release release;
+    if (diagrams_2.is_none())
+      matrix = Gudhi::persistence_diagram::bottleneck_distance_matrix(diags1, e);
+    else
+      matrix = Gudhi::persistence_diagram::bottleneck_distance_matrix(diags1, diags2, e);
+  }
+  py::array_t<double> result({n1, n2});
+  std::copy(matrix.begin(), matrix.end(), result.mutable_data());
+  return result;
+}
+
 PYBIND11_MODULE(bottleneck, m) {
       m.attr("__license__") = "GPL v3";
       m.def("bottleneck_distance", &bottleneck,
@@ -52,4 +92,23 @@ PYBIND11_MODULE(bottleneck, m) {
     :rtype: float
     :returns: the bottleneck distance.
     )pbdoc");
+      m.def("bottleneck_distance_matrix", &bottleneck_matrix,
+          py::arg("diagrams_1"), py::arg("diagrams_2") = py::none(),
+          py::arg("e") = py::none(),
+          R"pbdoc(
+    Compute the Bottleneck distances between all the pairs of a list of
+    diagrams, or between each diagram of a list and each diagram of another
+    list. The computation runs in parallel when GUDHI is built with TBB, and
+    each diagram is preprocessed only once.
+
+    :param diagrams_1: The first list of diagrams.
+    :type diagrams_1: list of numpy arrays of shape (m,2)
+    :param diagrams_2: The second list of diagrams. If None, the distances
+        between the diagrams of `diagrams_1` are computed.
+    :type diagrams_2: list of numpy arrays of shape (n,2)
+    :param e: Same as in :func:`bottleneck_distance`.
+    :type e: float
+    :rtype: numpy array of shape (len(diagrams_1), len(diagrams_2))
+    :returns: the matrix of bottleneck distances.
+    )pbdoc");
 }
@@ -1,4 +1,4 @@
-from .wasserstein import wasserstein_distance
+from .wasserstein import wasserstein_distance, wasserstein_distance_matrix
 from .bottleneck import bottleneck_distance
 
 
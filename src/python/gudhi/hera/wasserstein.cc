@@ -12,6 +12,17 @@
 
 #include <pybind11_diagram_utils.h>
 
+#include <pybind11/stl.h>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::copy
+#include <cstddef>  // for std::size_t
+
 double wasserstein_distance(
     Dgm d1, Dgm d2,
     double wasserstein_power, double internal_p,
@@ -33,6 +44,63 @@ double wasserstein_distance(
   return hera::wasserstein_dist(diag1, diag2, params);
 }
 
+typedef std::vector<std::pair<double, double>> Diagram;
+
+// Each diagram is copied once, instead of once per pair.
+static std::vector<Diagram> numpy_to_diagrams(std::vector<Dgm> const& dgms) {
+  std::vector<Diagram> diagrams;
+  for (auto const& dgm : dgms) {
+    auto range = numpy_to_range_of_pairs(dgm);
+    diagrams.emplace_back(range.begin(), range.end());
+  }
+  return diagrams;
+}
+
+// diagrams_2=None means the symmetric matrix of diagrams_1
+py::array_t<double> wasserstein_distance_matrix(
+    std::vector<Dgm> const& diagrams_1, py::object diagrams_2,
+    double wasserstein_power, double internal_p,
+    double delta)
+{
+  bool symmetric = diagrams_2.is_none();
+  std::vector<Diagram> diags1 = numpy_to_diagrams(diagrams_1);
+  std::vector<Diagram> diags2;
+  if (!symmetric) diags2 = numpy_to_diagrams(diagrams_2.cast<std::vector<Dgm>>());
+  std::vector<Diagram> const& others = symmetric ? diags1 : diags2;
+  const std::size_t n1 = diags1.size();
+  const std::size_t n2 = others.size();
+  py::array_t<double> result({n1, n2});
+  double* matrix = result.mutable_data();
+
+  py::gil_scoped_release release;
+
+  hera::AuctionParams<double> params;
+  params.wasserstein_power = wasserstein_power;
+  // hera encodes infinity as -1...
+  if(std::isinf(internal_p)) internal_p = hera::get_infinity<double>();
+  params.internal_p = internal_p;
+  params.delta = delta;
+  auto compute_row = [&](std::size_t i) {
+    // hera writes some statistics in the parameters
+    hera::AuctionParams<double> row_params = params;
+    for (std::size_t j = 0; j < n2; ++j) {
+      if (symmetric && j < i) continue;
+      if (symmetric && j == i) {
+        matrix[i * n2 + j] = 0;
+        continue;
+      }
+      matrix[i * n2 + j] = hera::wasserstein_dist(diags1[i], others[j], row_params);
+      if (symmetric) matrix[j * n2 + i] = matrix[i * n2 + j];
+    }
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), n1, compute_row);
+#else
+  for (std::size_t i = 0; i < n1; ++i) compute_row(i);
+#endif
+  return result;
+}
+
 PYBIND11_MODULE(wasserstein, m) {
       m.def("wasserstein_distance", &wasserstein_distance,
           py::arg("X"), py::arg("Y"),
@@ -53,4 +121,25 @@ PYBIND11_MODULE(wasserstein, m) {
         Returns:
             float: Approximate Wasserstein distance W_q(X,Y)
     )pbdoc");
+      m.def("wasserstein_distance_matrix", &wasserstein_distance_matrix,
+          py::arg("X"), py::arg("Y") = py::none(),
+          py::arg("order") = 1,
+          py::arg("internal_p") = std::numeric_limits<double>::infinity(),
+          py::arg("delta") = .01,
+          R"pbdoc(
+        Compute the Wasserstein distances between all the pairs of a list of
+        diagrams, or between each diagram of a list and each diagram of another
+        list. The computation runs in parallel when GUDHI is built with TBB.
+        Points at infinity are supported.
+
+        Parameters:
+            X (list of n x 2 numpy arrays): First list of diagrams
+            Y (list of n x 2 numpy arrays): Second list of diagrams. If None, the distances between the diagrams of X are computed
+            order (float): Wasserstein exponent W_q
+            internal_p (float): Internal Minkowski norm L^p in R^2
+            delta (float): Relative error 1+delta
+
+        Returns:
+            numpy array of shape (len(X), len(Y)): Approximate Wasserstein distances
+    )pbdoc");
 }
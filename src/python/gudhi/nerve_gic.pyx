@@ -53,6 +53,7 @@ cdef extern from "Nerve_gic_interface.h" namespace "Gudhi":
         void set_graph_from_OFF()
         void set_graph_from_euclidean_rips(double threshold)
         void set_mask(int nodemask)
+        void set_on_demand_distances(bool on_demand)
         void set_resolution_with_interval_length(double resolution)
         void set_resolution_with_interval_number(int resolution)
         void set_subsampling(double constant, double power)
@@ -346,6 +347,21 @@ cdef class CoverComplex:
         """
         self.thisptr.set_mask(nodemask)
 
+    def set_on_demand_distances(self, on_demand=True):
+        """Specifies whether the distances should be computed only when
+        needed, instead of being stored in a dense matrix of all pairwise
+        distances. In this mode, the Rips graphs are computed with radius
+        queries in a metric tree, and the Voronoi covers only use the
+        distances along the edges of the graph. This mode has no effect if
+        the distance matrix was given with
+        :func:`set_distances_from_range`.
+
+        :param on_demand: true = compute distances on demand, false = compute
+            all pairwise distances.
+        :type on_demand: boolean
+        """
+        self.thisptr.set_on_demand_distances(on_demand)
+
     def set_resolution_with_interval_length(self, resolution):
         """Sets a length of intervals from a value stored in memory.
 
@@ -0,0 +1,96 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/Random_projection_forest.h>
+
+#include <boost/range/iterator_range.hpp>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> Points;
+typedef boost::iterator_range<double const*> Row;
+
+// Rows of a 2d numpy array, as ranges of coordinates
+std::vector<Row> numpy_to_rows(py::buffer_info const& buf) {
+  if (buf.ndim != 2) throw std::runtime_error("Points must be a 2d array");
+  double const* data = static_cast<double const*>(buf.ptr);
+  std::vector<Row> rows;
+  rows.reserve(buf.shape[0]);
+  for (py::ssize_t i = 0; i < buf.shape[0]; ++i) rows.emplace_back(data + i * buf.shape[1], data + (i + 1) * buf.shape[1]);
+  return rows;
+}
+
+class Random_projection_forest_interface {
+ public:
+  Random_projection_forest_interface(Points points, unsigned n_trees, std::size_t leaf_size, unsigned seed) {
+    auto rows = numpy_to_rows(points.request());
+    py::gil_scoped_release release;
+    forest_.reset(new Gudhi::spatial_searching::Random_projection_forest(rows, n_trees, leaf_size, seed));
+  }
+
+  py::tuple query(Points queries, unsigned k, std::size_t search_k, bool sort_results) {
+    auto rows = numpy_to_rows(queries.request());
+    std::vector<std::size_t> indices;
+    std::vector<double> squared_distances;
+    {
+      py::gil_scoped_release release;
+      // The forest is shared by the Python threads, so search_k is given to the query rather than stored in it
+      forest_->k_nearest_neighbors_batch(rows, k, indices, squared_distances, sort_results, search_k);
+    }
+    py::array_t<py::ssize_t> py_indices({rows.size(), static_cast<std::size_t>(k)});
+    py::array_t<double> py_distances({rows.size(), static_cast<std::size_t>(k)});
+    auto ind = py_indices.mutable_data();
+    auto dist = py_distances.mutable_data();
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+      // Missing neighbors (k larger than the number of points) are reported as -1
+      ind[i] = static_cast<py::ssize_t>(indices[i]);
+      dist[i] = squared_distances[i];
+    }
+    return py::make_tuple(py_indices, py_distances);
+  }
+
+ private:
+  std::unique_ptr<const Gudhi::spatial_searching::Random_projection_forest> forest_;
+};
+
+PYBIND11_MODULE(_rp_forest, m) {
+  py::class_<Random_projection_forest_interface>(m, "RandomProjectionForest")
+      .def(py::init<Points, unsigned, std::size_t, unsigned>(), py::arg("points"), py::arg("n_trees") = 10,
+           py::arg("leaf_size") = 32, py::arg("seed") = 0,
+           R"pbdoc(
+        Forest of random projection trees for approximate nearest neighbor search. The points are copied.
+
+        Parameters:
+            points (n x d numpy array): reference points
+            n_trees (int): number of trees, more trees give a better recall
+            leaf_size (int): maximal number of points in a leaf
+            seed (int): seed of the random generator
+    )pbdoc")
+      .def("query", &Random_projection_forest_interface::query, py::arg("queries"), py::arg("k"),
+           py::arg("search_k") = 0, py::arg("sort_results") = true,
+           R"pbdoc(
+        Approximate k nearest neighbors of each query point.
+
+        Parameters:
+            queries (m x d numpy array): query points
+            k (int): number of neighbors
+            search_k (int): number of candidates examined per query, 0 means n_trees * k
+            sort_results (bool): sort the neighbors of each query by increasing distance
+
+        Returns:
+            tuple: (m x k array of indices, m x k array of squared distances)
+    )pbdoc");
+}
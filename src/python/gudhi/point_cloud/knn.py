@@ -37,6 +37,7 @@ class KNearestNeighbors:
                 * 'ckdtree' for scipy's cKDTree. Only "minkowski" and its aliases are supported.
                 * 'sklearn' for scikit-learn's NearestNeighbors. Note that this provides in particular an option algorithm="brute".
                 * 'hnsw' for hnswlib.Index. It can be very fast but does not provide guarantees. Only supports "euclidean" for now.
+                * 'rpforest' for GUDHI's forest of random projection trees. Approximate, useful in high dimension. Only supports "euclidean". The recall is controlled by `n_trees` (default 10) and `search_k` (number of candidates examined per query, default `n_trees * k`).
                 * None will try to select a sensible one (scipy if possible, scikit-learn otherwise).
             metric (str): see `sklearn.neighbors.NearestNeighbors`.
             eps (float): relative error when computing nearest neighbors with the cKDTree.
@@ -71,7 +72,7 @@ class KNearestNeighbors:
             self.params["p"] = kwargs.get("p", 2)
         if self.params.get("implementation") in {"keops", "ckdtree"}:
             assert self.metric == "minkowski"
-        if self.params.get("implementation") == "hnsw":
+        if self.params.get("implementation") in {"hnsw", "rpforest"}:
             assert self.metric == "minkowski" and self.params["p"] == 2
         if not self.params.get("implementation"):
             if self.metric == "minkowski":
@@ -127,6 +128,13 @@ class KNearestNeighbors:
                 self.params["num_threads"] = n
             self.graph.add_items(X, num_threads=n)
 
+        if self.params["implementation"] == "rpforest":
+            from ._rp_forest import RandomProjectionForest
+
+            self.rpforest = RandomProjectionForest(
+                X, **{k: v for k, v in self.params.items() if k in {"n_trees", "leaf_size", "seed"}}
+            )
+
         return self
 
     def transform(self, X):
@@ -268,6 +276,19 @@ class KNearestNeighbors:
                 return numpy.sqrt(distances)
             return None
 
+        if self.params["implementation"] == "rpforest":
+            neighbors, distances = self.rpforest.query(
+                X, k, search_k=self.params.get("search_k", 0), sort_results=self.params.get("sort_results", True)
+            )
+            if self.return_index:
+                if self.return_distance:
+                    return neighbors, numpy.sqrt(distances)
+                else:
+                    return neighbors
+            if self.return_distance:
+                return numpy.sqrt(distances)
+            return None
+
         if self.params["implementation"] == "keops":
             import torch
             from pykeops.torch import LazyTensor
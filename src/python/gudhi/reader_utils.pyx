@@ -14,7 +14,7 @@ from libcpp.map cimport map
 from libcpp.pair cimport pair
 
 from os import path
-from numpy import array as np_array
+from numpy import array as np_array, asarray as np_asarray, empty as np_empty, memmap as np_memmap
 
 __author__ = "Vincent Rouvreau"
 __copyright__ = "Copyright (C) 2017 Inria"
@@ -24,6 +24,8 @@ cdef extern from "Reader_utils_interface.h" namespace "Gudhi":
     vector[vector[double]] read_matrix_from_csv_file(string off_file, char separator)
     map[int, vector[pair[double, double]]] read_pers_intervals_grouped_by_dimension(string filename)
     vector[pair[double, double]] read_pers_intervals_in_dimension(string filename, int only_this_dim)
+    void write_pers_diagram_archive(string filename, vector[map[int, vector[pair[double, double]]]] diagrams) except +
+    pair[size_t, vector[pair[size_t, size_t]]] read_pers_diagram_archive_index(string filename, int only_this_dim) except +
 
 def read_lower_triangular_matrix_from_csv_file(csv_file='', separator=';'):
     """Read lower triangular matrix from a CSV style file.
@@ -84,3 +86,56 @@ def read_persistence_intervals_in_dimension(persistence_file='', only_this_dim=-
                 'utf-8'), only_this_dim))
     print("file " + persistence_file + " not set or not found.")
     return []
+
+def write_persistence_diagram_archive(archive_file, diagrams):
+    """Writes persistence diagrams to a binary archive, that can be read much
+    faster than text files with :func:`read_persistence_diagram_archive`.
+
+    :param archive_file: The name of the archive file, usually with the
+        extension `.pda`.
+    :type archive_file: string
+    :param diagrams: The persistence diagrams. Each of them is either a
+        `dict(dim, list(tuple(birth, death)))`, as returned by
+        :func:`read_persistence_intervals_grouped_by_dimension`, or a list or
+        numpy array of shape (n,2) of intervals of unknown dimension.
+    :type diagrams: list
+
+    :raises ValueError: If the file cannot be written.
+    """
+    cdef vector[map[int, vector[pair[double, double]]]] cpp_diagrams
+    cdef map[int, vector[pair[double, double]]] cpp_diagram
+    for diagram in diagrams:
+        if isinstance(diagram, dict):
+            cpp_diagram = {dim : [(birth, death) for birth, death in intervals]
+                           for dim, intervals in diagram.items()}
+        else:
+            cpp_diagram = {-1 : [(birth, death) for birth, death in diagram]}
+        cpp_diagrams.push_back(cpp_diagram)
+    write_pers_diagram_archive(archive_file.encode('utf-8'), cpp_diagrams)
+
+def read_persistence_diagram_archive(archive_file, only_this_dim=-1):
+    """Reads a binary archive of persistence diagrams, written by
+    :func:`write_persistence_diagram_archive`. The file is mapped in memory
+    and the intervals are not copied.
+
+    :param archive_file: The name of the archive file.
+    :type archive_file: string
+    :param only_this_dim: The specific dimension. Default value is -1.
+        If `only_this_dim` = -1, all the intervals of each diagram are
+        returned, sorted by dimension. If `only_this_dim` is >= 0, only the
+        intervals of this dimension are returned.
+    :type only_this_dim: int.
+
+    :returns: The persistence intervals of each diagram, as read-only views
+        on the mapped file.
+    :rtype: list of numpy arrays of shape (n,2)
+
+    :raises ValueError: If the file is not a valid archive.
+    """
+    number_of_intervals, index = read_pers_diagram_archive_index(archive_file.encode('utf-8'), only_this_dim)
+    if number_of_intervals == 0:
+        # An empty array cannot be mapped.
+        return [np_empty((0, 2)) for _ in index]
+    # The intervals follow a header of 48 bytes.
+    intervals = np_memmap(archive_file, dtype='float64', mode='r', offset=48, shape=(number_of_intervals, 2))
+    return [np_asarray(intervals[first:last]) for first, last in index]
@@ -0,0 +1,77 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/Sliced_Wasserstein.h>
+
+#include <pybind11_diagram_utils.h>
+
+#include <pybind11/stl.h>
+
+#include <vector>
+#include <utility>  // for std::declval
+#include <algorithm>  // for std::copy
+#include <stdexcept>  // for std::invalid_argument
+
+namespace py = pybind11;
+
+typedef decltype(numpy_to_range_of_pairs(std::declval<Dgm>())) Dgm_range;
+
+static std::vector<Dgm_range> numpy_to_ranges_of_pairs(std::vector<Dgm> const& dgms) {
+  std::vector<Dgm_range> ranges;
+  for (auto const& dgm : dgms) ranges.push_back(numpy_to_range_of_pairs(dgm));
+  return ranges;
+}
+
+// Y=None means the symmetric matrix of X
+py::array_t<double> sliced_wasserstein_distance_matrix(std::vector<Dgm> const& X, py::object Y, int num_directions)
+{
+  if (num_directions <= 0) throw std::invalid_argument("num_directions must be positive");
+  // The input arrays (kept alive by the vectors) must outlive the ranges.
+  std::vector<Dgm> dgms_y;
+  if (!Y.is_none()) dgms_y = Y.cast<std::vector<Dgm>>();
+  auto diags_x = numpy_to_ranges_of_pairs(X);
+  auto diags_y = numpy_to_ranges_of_pairs(dgms_y);
+  std::size_t n1 = diags_x.size();
+  std::size_t n2 = Y.is_none() ? n1 : diags_y.size();
+
+  std::vector<double> matrix;
+  {
+    py::gil_scoped_release release;
+    if (Y.is_none())
+      matrix = Gudhi::Persistence_representations::sliced_wasserstein_distance_matrix(diags_x, num_directions);
+    else
+      matrix = Gudhi::Persistence_representations::sliced_wasserstein_distance_matrix(diags_x, diags_y,
+                                                                                       num_directions);
+  }
+  py::array_t<double> result({n1, n2});
+  std::copy(matrix.begin(), matrix.end(), result.mutable_data());
+  return result;
+}
+
+PYBIND11_MODULE(_sliced_wasserstein, m) {
+      m.def("sliced_wasserstein_distance_matrix", &sliced_wasserstein_distance_matrix,
+          py::arg("X"), py::arg("Y") = py::none(),
+          py::arg("num_directions") = 10,
+          R"pbdoc(
+        Compute the sliced Wasserstein distances between all the pairs of a
+        list of diagrams, or between each diagram of a list and each diagram of
+        another list. The diagrams are projected once onto num_directions lines
+        evenly sampled from [-pi/2,pi/2], and the distances are computed in
+        parallel when GUDHI is built with TBB.
+
+        Parameters:
+            X (list of n x 2 numpy arrays): First list of diagrams, with finite points
+            Y (list of n x 2 numpy arrays): Second list of diagrams. If None, the distances between the diagrams of X are computed
+            num_directions (int): Number of lines, must be positive
+
+        Returns:
+            numpy array of shape (len(X), len(Y)): Approximate sliced Wasserstein distances
+    )pbdoc");
+}
@@ -0,0 +1,328 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <pybind11_diagram_utils.h>
+
+#include <pybind11/stl.h>
+
+#include <boost/math/constants/constants.hpp>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+#include <utility>  // for std::pair
+#include <algorithm>  // for std::fill
+#include <functional>  // for std::greater
+#include <queue>
+#include <cmath>
+#include <stdexcept>  // for std::invalid_argument
+
+namespace py = pybind11;
+
+typedef std::vector<std::pair<double, double>> Diagram;
+
+// The diagrams are copied, so that they can be read without the GIL.
+static std::vector<Diagram> numpy_to_diagrams(std::vector<Dgm> const& X) {
+  std::vector<Diagram> diagrams;
+  diagrams.reserve(X.size());
+  for (auto const& dgm : X) {
+    auto range = numpy_to_range_of_pairs(dgm);
+    diagrams.emplace_back(range.begin(), range.end());
+  }
+  return diagrams;
+}
+
+// One weight per point of each diagram.
+static std::vector<std::vector<double>> numpy_to_weights(std::vector<py::array_t<double>> const& W,
+                                                         std::vector<Diagram> const& diagrams) {
+  if (W.size() != diagrams.size()) throw std::invalid_argument("There must be one array of weights per diagram");
+  std::vector<std::vector<double>> weights;
+  weights.reserve(W.size());
+  for (std::size_t i = 0; i < W.size(); ++i) {
+    auto w = W[i].unchecked<1>();
+    if (static_cast<std::size_t>(w.shape(0)) != diagrams[i].size())
+      throw std::invalid_argument("There must be one weight per point");
+    weights.emplace_back(w.data(0), w.data(0) + w.shape(0));
+  }
+  return weights;
+}
+
+// Returns the array of shape (n_diagrams, n_features), initialized with zeros, whose i-th row is filled by f(i, row).
+// The rows are computed without the GIL, in parallel when TBB is available.
+template <typename F>
+static py::array_t<double> vectorize(std::size_t n_diagrams, std::size_t n_features, F f) {
+  py::array_t<double> result({n_diagrams, n_features});
+  double* data = result.mutable_data();
+  {
+    py::gil_scoped_release release;
+    std::fill(data, data + n_diagrams * n_features, 0.);
+    auto compute_row = [&](std::size_t i) { f(i, data + i * n_features); };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), n_diagrams, compute_row);
+#else
+    for (std::size_t i = 0; i < n_diagrams; ++i) compute_row(i);
+#endif
+  }
+  return result;
+}
+
+// np.clip(np.ceil((x - x_min) / step).astype(int), 0, resolution), the index of the first sample not before x.
+// As with numpy, infinite coordinates give 0, so that the points at infinity are ignored.
+static std::size_t sample_index(double x, double x_min, double step, std::size_t resolution) {
+  double index = std::ceil((x - x_min) / step);
+  if (!std::isfinite(index) || index <= 0) return 0;
+  if (index >= resolution) return resolution;
+  return static_cast<std::size_t>(index);
+}
+
+// Calls f(k, value) for the samples k where the tent function of the point is positive, value being the tent function
+// at the k-th sample.
+template <typename F>
+static void for_each_sample_of_tent(std::pair<double, double> const& point, double x_min, double step,
+                                    std::size_t resolution, F f) {
+  std::size_t min_idx = sample_index(point.first, x_min, step, resolution);
+  std::size_t mid_idx = sample_index(0.5 * (point.second + point.first), x_min, step, resolution);
+  std::size_t max_idx = sample_index(point.second, x_min, step, resolution);
+  if (min_idx >= resolution || max_idx == 0) return;
+  double value = x_min + min_idx * step - point.first;
+  for (std::size_t k = min_idx; k < mid_idx; ++k) {
+    f(k, value);
+    value += step;
+  }
+  value = point.second - x_min - mid_idx * step;
+  for (std::size_t k = mid_idx; k < max_idx; ++k) {
+    f(k, value);
+    value -= step;
+  }
+}
+
+py::array_t<double> landscapes(std::vector<Dgm> const& X, int num_landscapes, int resolution, double x_min,
+                               double step) {
+  if (num_landscapes < 0 || resolution <= 0) throw std::invalid_argument("Wrong number of landscapes or samples");
+  auto diagrams = numpy_to_diagrams(X);
+  const std::size_t n_landscapes = num_landscapes, n_samples = resolution;
+  return vectorize(diagrams.size(), n_landscapes * n_samples, [&](std::size_t i, double* row) {
+    // For every sample, the n_landscapes largest values, sorted decreasingly.
+    std::vector<double> values(n_samples * n_landscapes);
+    std::vector<std::size_t> counts(n_samples, 0);
+    for (auto const& point : diagrams[i]) {
+      for_each_sample_of_tent(point, x_min, step, n_samples, [&](std::size_t k, double value) {
+        double* largest = values.data() + k * n_landscapes;
+        std::size_t j = counts[k];
+        if (j == n_landscapes) {
+          if (j == 0 || value <= largest[j - 1]) return;
+          --j;
+        } else {
+          ++counts[k];
+        }
+        for (; j > 0 && largest[j - 1] < value; --j) largest[j] = largest[j - 1];
+        largest[j] = value;
+      });
+    }
+    for (std::size_t k = 0; k < n_samples; ++k)
+      for (std::size_t l = 0; l < counts[k]; ++l) row[l * n_samples + k] = std::sqrt(2.) * values[k * n_landscapes + l];
+  });
+}
+
+py::array_t<double> silhouettes(std::vector<Dgm> const& X, std::vector<py::array_t<double>> const& W, int resolution,
+                                double x_min, double step) {
+  if (resolution <= 0) throw std::invalid_argument("The number of samples must be positive");
+  auto diagrams = numpy_to_diagrams(X);
+  auto weights = numpy_to_weights(W, diagrams);
+  return vectorize(diagrams.size(), resolution, [&](std::size_t i, double* row) {
+    double total_weight = 0;
+    for (double w : weights[i]) total_weight += w;
+    for (std::size_t j = 0; j < diagrams[i].size(); ++j) {
+      double weight = weights[i][j] / total_weight;
+      for_each_sample_of_tent(diagrams[i][j], x_min, step, resolution,
+                              [&](std::size_t k, double value) { row[k] += weight * value; });
+    }
+    for (int k = 0; k < resolution; ++k) row[k] *= std::sqrt(2.);
+  });
+}
+
+py::array_t<double> betti_curves(std::vector<Dgm> const& X, int resolution, double x_min, double step) {
+  if (resolution <= 0) throw std::invalid_argument("The number of samples must be positive");
+  auto diagrams = numpy_to_diagrams(X);
+  return vectorize(diagrams.size(), resolution, [&](std::size_t i, double* row) {
+    for (auto const& point : diagrams[i]) {
+      std::size_t min_idx = sample_index(point.first, x_min, step, resolution);
+      std::size_t max_idx = sample_index(point.second, x_min, step, resolution);
+      for (std::size_t k = min_idx; k < max_idx; ++k) row[k] += 1;
+    }
+  });
+}
+
+// -q log(q) for the persistences q of the points, divided by the largest absolute value of the persistences.
+static std::vector<double> entropy_terms(Diagram const& diagram) {
+  double scale = 0;
+  for (auto const& point : diagram) scale = std::max(scale, std::abs(point.second - point.first));
+  if (scale == 0) scale = 1;
+  std::vector<double> terms;
+  terms.reserve(diagram.size());
+  for (auto const& point : diagram) {
+    double q = (point.second - point.first) / scale;
+    terms.push_back(-q * std::log(q));
+  }
+  return terms;
+}
+
+py::array_t<double> entropies(std::vector<Dgm> const& X) {
+  auto diagrams = numpy_to_diagrams(X);
+  return vectorize(diagrams.size(), 1, [&](std::size_t i, double* row) {
+    for (double term : entropy_terms(diagrams[i])) row[0] += term;
+  });
+}
+
+py::array_t<double> entropy_summaries(std::vector<Dgm> const& X, int resolution, double x_min, double step,
+                                      bool normalized) {
+  if (resolution <= 0) throw std::invalid_argument("The number of samples must be positive");
+  auto diagrams = numpy_to_diagrams(X);
+  return vectorize(diagrams.size(), resolution, [&](std::size_t i, double* row) {
+    std::vector<double> terms = entropy_terms(diagrams[i]);
+    for (std::size_t j = 0; j < diagrams[i].size(); ++j) {
+      std::size_t min_idx = sample_index(diagrams[i][j].first, x_min, step, resolution);
+      std::size_t max_idx = sample_index(diagrams[i][j].second, x_min, step, resolution);
+      for (std::size_t k = min_idx; k < max_idx; ++k) row[k] += terms[j];
+    }
+    if (normalized) {
+      double norm = 0;
+      for (int k = 0; k < resolution; ++k) norm += std::abs(row[k]);
+      for (int k = 0; k < resolution; ++k) row[k] /= norm;
+    }
+  });
+}
+
+py::array_t<double> persistence_images(std::vector<Dgm> const& X, std::vector<py::array_t<double>> const& W,
+                                       double bandwidth, std::vector<double> const& x_values,
+                                       std::vector<double> const& y_values) {
+  auto diagrams = numpy_to_diagrams(X);
+  auto weights = numpy_to_weights(W, diagrams);
+  const std::size_t n_x = x_values.size(), n_y = y_values.size();
+  const double two_variances = 2 * bandwidth * bandwidth;
+  const double normalization = bandwidth * bandwidth * 2 * boost::math::constants::pi<double>();
+  return vectorize(diagrams.size(), n_x * n_y, [&](std::size_t i, double* row) {
+    // The Gaussian is separable: the image of a point is the outer product of a row and a column.
+    std::vector<double> gaussian_x(n_x), gaussian_y(n_y);
+    for (std::size_t j = 0; j < diagrams[i].size(); ++j) {
+      // in the (birth, persistence) coordinates
+      double x = diagrams[i][j].first, y = diagrams[i][j].second - diagrams[i][j].first;
+      for (std::size_t k = 0; k < n_x; ++k)
+        gaussian_x[k] = std::exp(-(x - x_values[k]) * (x - x_values[k]) / two_variances);
+      for (std::size_t k = 0; k < n_y; ++k)
+        gaussian_y[k] =
+            weights[i][j] * std::exp(-(y - y_values[k]) * (y - y_values[k]) / two_variances) / normalization;
+      for (std::size_t l = 0; l < n_y; ++l)
+        for (std::size_t k = 0; k < n_x; ++k) row[l * n_x + k] += gaussian_y[l] * gaussian_x[k];
+    }
+  });
+}
+
+py::array_t<double> topological_vectors(std::vector<Dgm> const& X, int threshold) {
+  if (threshold < 0) throw std::invalid_argument("The threshold must be non-negative");
+  auto diagrams = numpy_to_diagrams(X);
+  const std::size_t size = threshold;
+  return vectorize(diagrams.size(), size, [&](std::size_t i, double* row) {
+    // The values are the upper triangle (diagonal included) of the matrix min(d(p_j, p_k), (y_k - x_k) / 2), where d
+    // is the Chebyshev distance, and zeros for the lower triangle. Only the largest ones are kept, the smallest of them
+    // on top of the heap.
+    Diagram const& diagram = diagrams[i];
+    const std::size_t n = diagram.size();
+    if (size == 0) return;
+    std::priority_queue<double, std::vector<double>, std::greater<double>> heap;
+    auto can_insert = [&](double value) { return heap.size() < size || value > heap.top(); };
+    auto insert = [&](double value) {
+      if (heap.size() == size) heap.pop();
+      heap.push(value);
+    };
+    for (std::size_t j = 0; j < n * (n - 1) / 2 && can_insert(0); ++j) insert(0);
+    for (std::size_t k = 0; k < n; ++k) {
+      double persistence = 0.5 * (diagram[k].second - diagram[k].first);
+      if (can_insert(std::min(0., persistence))) insert(std::min(0., persistence));
+      for (std::size_t j = 0; j < k; ++j) {
+        // the value is at most the persistence
+        if (!can_insert(persistence)) break;
+        double distance = std::max(std::abs(diagram[j].first - diagram[k].first),
+                                   std::abs(diagram[j].second - diagram[k].second));
+        double value = std::min(distance, persistence);
+        if (can_insert(value)) insert(value);
+      }
+    }
+    for (std::size_t j = heap.size(); j > 0; --j) {
+      row[j - 1] = heap.top();
+      heap.pop();
+    }
+  });
+}
+
+PYBIND11_MODULE(_vector_methods, m) {
+      m.def("landscapes", &landscapes, py::arg("X"), py::arg("num_landscapes"), py::arg("resolution"),
+          py::arg("x_min"), py::arg("step"),
+          R"pbdoc(
+        Compute the persistence landscapes of a list of diagrams, sampled at
+        x_min + k * step for k in range(resolution).
+
+        Returns:
+            numpy array of shape (len(X), num_landscapes * resolution): The samples of the landscapes, times sqrt(2)
+    )pbdoc");
+      m.def("silhouettes", &silhouettes, py::arg("X"), py::arg("weights"), py::arg("resolution"), py::arg("x_min"),
+          py::arg("step"),
+          R"pbdoc(
+        Compute the silhouettes of a list of diagrams, given the weights of
+        their points, sampled at x_min + k * step for k in range(resolution).
+
+        Returns:
+            numpy array of shape (len(X), resolution): The samples of the silhouettes, multiplied by sqrt(2)
+    )pbdoc");
+      m.def("betti_curves", &betti_curves, py::arg("X"), py::arg("resolution"), py::arg("x_min"), py::arg("step"),
+          R"pbdoc(
+        Compute the Betti curves of a list of diagrams, sampled at
+        x_min + k * step for k in range(resolution).
+
+        Returns:
+            numpy array of shape (len(X), resolution): The samples of the Betti curves
+    )pbdoc");
+      m.def("entropies", &entropies, py::arg("X"),
+          R"pbdoc(
+        Compute the persistence entropy of a list of diagrams, the
+        persistences being divided by their maximum.
+
+        Returns:
+            numpy array of shape (len(X), 1): The entropies
+    )pbdoc");
+      m.def("entropy_summaries", &entropy_summaries, py::arg("X"), py::arg("resolution"), py::arg("x_min"),
+          py::arg("step"), py::arg("normalized"),
+          R"pbdoc(
+        Compute the entropy summary functions of a list of diagrams, sampled
+        at x_min + k * step for k in range(resolution).
+
+        Returns:
+            numpy array of shape (len(X), resolution): The samples of the entropy summary functions
+    )pbdoc");
+      m.def("persistence_images", &persistence_images, py::arg("X"), py::arg("weights"), py::arg("bandwidth"),
+          py::arg("x_values"), py::arg("y_values"),
+          R"pbdoc(
+        Compute the persistence images of a list of diagrams, given the
+        weights of their points, on the grid of the birth values x_values and
+        the persistence values y_values.
+
+        Returns:
+            numpy array of shape (len(X), len(y_values) * len(x_values)): The flattened images
+    )pbdoc");
+      m.def("topological_vectors", &topological_vectors, py::arg("X"), py::arg("threshold"),
+          R"pbdoc(
+        Compute the topological vectors of a list of diagrams.
+
+        Returns:
+            numpy array of shape (len(X), threshold): The largest values of the topological vectors, padded with zeros
+    )pbdoc");
+}
@@ -11,8 +11,9 @@ import numpy as np
 from sklearn.base import BaseEstimator, TransformerMixin
 from sklearn.metrics import pairwise_distances
 from gudhi.hera import wasserstein_distance as hera_wasserstein_distance
+from ._sliced_wasserstein import sliced_wasserstein_distance_matrix as _sliced_wasserstein_distance_matrix
 from .preprocessing import Padding
-from joblib import Parallel, delayed
+from joblib import Parallel, delayed, effective_n_jobs
 
 #############################################
 # Metrics ###################################
@@ -41,40 +42,6 @@ def _sliced_wasserstein_distance(D1, D2, num_directions):
     L1 = np.sum(np.abs(A-B), axis=0)
     return np.mean(L1)
 
-def _compute_persistence_diagram_projections(X, num_directions):
-    """
-    This is a function for projecting the points of a list of persistence diagrams (as well as their diagonal projections) onto a fixed number of lines sampled uniformly on [-pi/2, pi/2]. This function can be used as a preprocessing step in order to speed up the running time for computing all pairwise sliced Wasserstein distances / kernel values on a list of persistence diagrams. 
-
-    Parameters:
-        X (list of n numpy arrays of shape (numx2)): list of persistence diagrams. 
-        num_directions (int): number of lines evenly sampled from [-pi/2,pi/2] in order to approximate and speed up the distance computation.
-
-    Returns: 
-        list of n numpy arrays of shape (2*numx2): list of projected persistence diagrams.
-    """
-    thetas = np.linspace(-np.pi/2, np.pi/2, num=num_directions+1)[np.newaxis,:-1]
-    lines = np.concatenate([np.cos(thetas), np.sin(thetas)], axis=0)
-    XX = [np.vstack([np.matmul(D, lines), np.matmul(np.matmul(D, .5 * np.ones((2,2))), lines)]) for D in X]
-    return XX
-
-def _sliced_wasserstein_distance_on_projections(D1, D2):
-    """
-    This is a function for computing the sliced Wasserstein distance between two persistence diagrams that have already been projected onto some lines. It simply amounts to comparing the sorted projections with the 1-norm, and averaging over the lines. See http://proceedings.mlr.press/v70/carriere17a.html for more details.
-
-    Parameters: 
-        D1: (2n x number_of_lines) numpy.array containing the n projected points of the first diagram, and the n projections of their diagonal projections.
-        D2: (2m x number_of_lines) numpy.array containing the m projected points of the second diagram, and the m projections of their diagonal projections.
-
-    Returns: 
-        float: the sliced Wasserstein distance between the projected persistence diagrams. 
-    """
-    lim1, lim2 = int(len(D1)/2), int(len(D2)/2)
-    approx1, approx_diag1, approx2, approx_diag2 = D1[:lim1], D1[lim1:], D2[:lim2], D2[lim2:]
-    A = np.sort(np.concatenate([approx1, approx_diag2], axis=0), axis=0)
-    B = np.sort(np.concatenate([approx2, approx_diag1], axis=0), axis=0)
-    L1 = np.sum(np.abs(A-B), axis=0)
-    return np.mean(L1)
-
 def _persistence_fisher_distance(D1, D2, kernel_approx=None, bandwidth=1.):
     """
     This is a function for computing the persistence Fisher distance from two persistence diagrams. The persistence Fisher distance is obtained by computing the original Fisher distance between the probability distributions associated to the persistence diagrams given by convolving them with a Gaussian kernel. See http://papers.nips.cc/paper/8205-persistence-fisher-kernel-a-riemannian-manifold-kernel-for-persistence-diagrams for more details.
@@ -131,6 +98,23 @@ def _pairwise(fallback, skipdiag, X, Y, metric, n_jobs):
         np.fill_diagonal(m, 0)
     return m
 
+def _sliced_wasserstein_matrix(X, Y, n_jobs, num_directions=10):
+    """
+    This function computes the sliced Wasserstein distance matrix in C++, in parallel with TBB when GUDHI is built with it. If n_jobs is given, the rows of the matrix are also split in blocks computed in joblib threads, which run in parallel because the C++ code releases the GIL.
+    """
+    num_blocks = 1 if n_jobs is None else min(effective_n_jobs(n_jobs), len(X))
+    if num_blocks <= 1:
+        return _sliced_wasserstein_distance_matrix(X, Y, num_directions=num_directions)
+    Z = X if Y is None else Y
+    bounds = np.linspace(0, len(X), num_blocks + 1).astype(int)
+    par = Parallel(n_jobs=n_jobs, prefer="threads")
+    blocks = par(delayed(_sliced_wasserstein_distance_matrix)([X[k] for k in range(bounds[i], bounds[i+1])], Z, num_directions=num_directions) for i in range(num_blocks))
+    m = np.vstack(blocks)
+    if Y is None:
+        m = np.triu(m, 1)
+        m += m.T
+    return m
+
 def _sklearn_wrapper(metric, X, Y, **kwargs):
     """
     This function is a wrapper for any metric between two persistence diagrams that takes two numpy arrays of shapes (nx2) and (mx2) as arguments.
@@ -180,9 +164,8 @@ def pairwise_persistence_diagram_distances(X, Y=None, metric="bottleneck", n_job
             print("POT (Python Optimal Transport) is not installed. Please install POT or use metric='wasserstein' or metric='hera_wasserstein'")
             raise
     elif metric == "sliced_wasserstein":
-        Xproj = _compute_persistence_diagram_projections(X, **kwargs)
-        Yproj = None if Y is None else _compute_persistence_diagram_projections(Y, **kwargs)
-        return _pairwise(pairwise_distances, True, XX, YY, metric=_sklearn_wrapper(_sliced_wasserstein_distance_on_projections, Xproj, Yproj), n_jobs=n_jobs)
+        # The diagrams are projected once and the distances are computed in C++
+        return _sliced_wasserstein_matrix(X, None if Y is None or Y is X else Y, n_jobs, **kwargs)
     elif type(metric) == str:
         return _pairwise(pairwise_distances, True, XX, YY, metric=_sklearn_wrapper(PAIRWISE_DISTANCE_FUNCTIONS[metric], X, Y, **kwargs), n_jobs=n_jobs)
     else:
@@ -198,7 +181,7 @@ class SlicedWassersteinDistance(BaseEstimator, TransformerMixin):
 
         Parameters:
             num_directions (int): number of lines evenly sampled from [-pi/2,pi/2] in order to approximate and speed up the distance computation (default 10). 
-            n_jobs (int): number of jobs to use for the computation. See :func:`pairwise_persistence_diagram_distances` for details.
+            n_jobs (int): number of jobs to use for the computation. The rows of the distance matrix are split among n_jobs threads. When GUDHI is built with TBB, each block of rows is also computed in parallel, so this is mostly useful without TBB.
         """
         self.num_directions = num_directions
         self.n_jobs = n_jobs
@@ -237,7 +220,7 @@ class SlicedWassersteinDistance(BaseEstimator, TransformerMixin):
         Returns:
             float: sliced Wasserstein distance.
         """
-        return _sliced_wasserstein_distance(diag1, diag2, num_directions=self.num_directions)
+        return _sliced_wasserstein_distance_matrix([diag1], [diag2], num_directions=self.num_directions)[0, 0]
 
 class BottleneckDistance(BaseEstimator, TransformerMixin):
     """
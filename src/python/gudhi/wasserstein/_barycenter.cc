@@ -0,0 +1,93 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/Wasserstein_barycenter.h>
+
+#include <pybind11_diagram_utils.h>
+
+#include <pybind11/stl.h>
+
+#include <vector>
+#include <utility>  // for std::declval
+
+namespace py = pybind11;
+using Gudhi::persistence_diagram::Lagrangian_barycenter;
+
+static py::array_t<double> diagram_to_numpy(Lagrangian_barycenter::Diagram const& diag) {
+  py::array_t<double> result({diag.size(), std::size_t(2)});
+  double* data = result.mutable_data();
+  for (std::size_t i = 0; i < diag.size(); ++i) {
+    data[2 * i] = diag[i].first;
+    data[2 * i + 1] = diag[i].second;
+  }
+  return result;
+}
+
+static py::array_t<int> grouping_to_numpy(Lagrangian_barycenter::Grouping const& grouping) {
+  py::array_t<int> result({grouping.size(), std::size_t(2)});
+  int* data = result.mutable_data();
+  for (std::size_t i = 0; i < grouping.size(); ++i) {
+    data[2 * i] = grouping[i].first;
+    data[2 * i + 1] = grouping[i].second;
+  }
+  return result;
+}
+
+py::object lagrangian_barycenter(std::vector<Dgm> const& pdiagset, Dgm init, bool verbose, double delta,
+                                 int max_iterations)
+{
+  typedef decltype(numpy_to_range_of_pairs(std::declval<Dgm>())) Dgm_range;
+  std::vector<Dgm_range> diags;
+  for (auto const& dgm : pdiagset) diags.push_back(numpy_to_range_of_pairs(dgm));
+  auto init_range = numpy_to_range_of_pairs(init);
+
+  Lagrangian_barycenter::Diagram barycenter;
+  std::vector<Lagrangian_barycenter::Grouping> groupings;
+  double energy = 0.;
+  int nb_iter;
+  {
+    py::gil_scoped_release release;
+    Lagrangian_barycenter bary(diags, delta);
+    barycenter = bary.compute(init_range, max_iterations);
+    nb_iter = bary.number_of_iterations();
+    if (verbose) {
+      energy = bary.compute_energy();
+      groupings = bary.groupings();
+    }
+  }
+  if (!verbose) return diagram_to_numpy(barycenter);
+  py::list py_groupings;
+  for (auto const& grouping : groupings) py_groupings.append(grouping_to_numpy(grouping));
+  return py::make_tuple(diagram_to_numpy(barycenter), py_groupings, energy, nb_iter);
+}
+
+PYBIND11_MODULE(_barycenter, m) {
+      m.def("lagrangian_barycenter", &lagrangian_barycenter,
+          py::arg("pdiagset"), py::arg("init"),
+          py::arg("verbose") = false,
+          py::arg("delta") = 1e-6,
+          py::arg("max_iterations") = 1000,
+          R"pbdoc(
+        Lagrangian barycenter of persistence diagrams computed in C++, the
+        matchings being computed in parallel with the auction algorithm and
+        warm-started between iterations. See
+        :func:`gudhi.wasserstein.barycenter.lagrangian_barycenter`.
+
+        Parameters:
+            pdiagset (list of n x 2 numpy arrays): Diagrams to average, with only finite coordinates
+            init (n x 2 numpy array): Initial estimate
+            verbose (bool): if True, also returns the groupings, the energy and the number of iterations
+            delta (float): Relative error of the matchings
+            max_iterations (int): Maximal number of iterations
+
+        Returns:
+            The barycenter estimate, or if verbose a tuple (barycenter, groupings, energy, nb_iter)
+    )pbdoc");
+}
@@ -0,0 +1,129 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       Gudhi developers
+ *
+ *    Copyright (C) 2020 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/Wasserstein_distance.h>
+
+#include <pybind11_diagram_utils.h>
+
+#include <pybind11/stl.h>
+
+#include <vector>
+#include <utility>  // for std::declval
+#include <algorithm>  // for std::copy, std::sort
+#include <limits>  // for std::numeric_limits
+
+namespace py = pybind11;
+
+typedef decltype(numpy_to_range_of_pairs(std::declval<Dgm>())) Dgm_range;
+
+static std::vector<Dgm_range> numpy_to_ranges_of_pairs(std::vector<Dgm> const& dgms) {
+  std::vector<Dgm_range> ranges;
+  for (auto const& dgm : dgms) ranges.push_back(numpy_to_range_of_pairs(dgm));
+  return ranges;
+}
+
+py::object wasserstein_distance(Dgm d1, Dgm d2, double order, double internal_p, double delta, bool matching)
+{
+  // I *think* the call to request() has to be before releasing the GIL.
+  auto diag1 = numpy_to_range_of_pairs(d1);
+  auto diag2 = numpy_to_range_of_pairs(d2);
+
+  double dist;
+  std::vector<std::pair<int, int>> pairs;
+  {
+    py::gil_scoped_release release;
+    Gudhi::persistence_diagram::Wasserstein_auction auction(diag1, diag2, order, internal_p);
+    dist = auction.compute(delta);
+    if (matching) {
+      pairs = auction.matching();
+      std::sort(pairs.begin(), pairs.end());
+    }
+  }
+  if (!matching) return py::float_(dist);
+  py::array_t<int> py_pairs({pairs.size(), std::size_t(2)});
+  int* data = py_pairs.mutable_data();
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    data[2 * i] = pairs[i].first;
+    data[2 * i + 1] = pairs[i].second;
+  }
+  return py::make_tuple(dist, py_pairs);
+}
+
+// Y=None means the symmetric matrix of X
+py::array_t<double> wasserstein_distance_matrix(std::vector<Dgm> const& X, py::object Y, double order,
+                                                double internal_p, double delta)
+{
+  // The input arrays (kept alive by the vectors) must outlive the ranges.
+  std::vector<Dgm> dgms_y;
+  if (!Y.is_none()) dgms_y = Y.cast<std::vector<Dgm>>();
+  auto diags_x = numpy_to_ranges_of_pairs(X);
+  auto diags_y = numpy_to_ranges_of_pairs(dgms_y);
+  std::size_t n1 = diags_x.size();
+  std::size_t n2 = Y.is_none() ? n1 : diags_y.size();
+
+  std::vector<double> matrix;
+  {
+    py::gil_scoped_release release;
+    if (Y.is_none())
+      matrix = Gudhi::persistence_diagram::wasserstein_distance_matrix(diags_x, order, internal_p, delta);
+    else
+      matrix = Gudhi::persistence_diagram::wasserstein_distance_matrix(diags_x, diags_y, order, internal_p, delta);
+  }
+  py::array_t<double> result({n1, n2});
+  std::copy(matrix.begin(), matrix.end(), result.mutable_data());
+  return result;
+}
+
+PYBIND11_MODULE(auction, m) {
+      m.def("wasserstein_distance", &wasserstein_distance,
+          py::arg("X"), py::arg("Y"),
+          py::arg("order") = 1,
+          py::arg("internal_p") = std::numeric_limits<double>::infinity(),
+          py::arg("delta") = .01,
+          py::arg("matching") = false,
+          R"pbdoc(
+        Compute the Wasserstein distance between two diagrams with GUDHI's
+        auction algorithm. Points at infinity are supported.
+
+        Parameters:
+            X (n x 2 numpy array): First diagram
+            Y (n x 2 numpy array): Second diagram
+            order (float): Wasserstein exponent W_q
+            internal_p (float): Internal Minkowski norm L^p in R^2
+            delta (float): Relative error 1+delta, must be positive
+            matching (bool): if True, computes and returns the optimal matching between X and Y, encoded as a (n x 2)
+                np.array [...[i,j]...], meaning the i-th point in X is matched to the j-th point in Y, with the
+                convention (-1) represents the diagonal.
+
+        Returns:
+            float: Approximate Wasserstein distance W_q(X,Y), and the matching if requested
+    )pbdoc");
+      m.def("wasserstein_distance_matrix", &wasserstein_distance_matrix,
+          py::arg("X"), py::arg("Y") = py::none(),
+          py::arg("order") = 1,
+          py::arg("internal_p") = std::numeric_limits<double>::infinity(),
+          py::arg("delta") = .01,
+          R"pbdoc(
+        Compute the Wasserstein distances between all the pairs of a list of
+        diagrams, or between each diagram of a list and each diagram of another
+        list, with GUDHI's auction algorithm. The computation runs in parallel
+        when GUDHI is built with TBB.
+
+        Parameters:
+            X (list of n x 2 numpy arrays): First list of diagrams
+            Y (list of n x 2 numpy arrays): Second list of diagrams. If None, the distances between the diagrams of X are computed
+            order (float): Wasserstein exponent W_q
+            internal_p (float): Internal Minkowski norm L^p in R^2
+            delta (float): Relative error 1+delta, must be positive
+
+        Returns:
+            numpy array of shape (len(X), len(Y)): Approximate Wasserstein distances
+    )pbdoc");
+}
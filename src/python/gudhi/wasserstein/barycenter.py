@@ -30,7 +30,7 @@ def _mean(x, m):
         return np.array([0, 0])
 
 
-def lagrangian_barycenter(pdiagset, init=None, verbose=False):
+def lagrangian_barycenter(pdiagset, init=None, verbose=False, implementation="pot"):
     '''
     :param pdiagset: a list of ``numpy.array`` of shape `(n x 2)` (`n` can variate), encoding a set of persistence
         diagrams with only finite coordinates.
@@ -52,6 +52,11 @@ def lagrangian_barycenter(pdiagset, init=None, verbose=False):
         - `"energy"`, ``float`` representing the Frechet energy value obtained. It is the mean of squared distances of observations to the output.
 
         - `"nb_iter"`, ``int`` number of iterations performed before convergence of the algorithm.
+    :param implementation: "pot" (default) computes the exact matchings with `Python Optimal Transport`.
+        "auction" runs the whole algorithm in C++, with approximate matchings given by the auction algorithm,
+        computed in parallel and warm-started from one iteration to the next. It is much faster on large sets of
+        diagrams.
+    :type implementation: str
     '''
     X = pdiagset  # to shorten notations, not a copy
     m = len(X)  # number of diagrams we are averaging
@@ -71,6 +76,16 @@ def lagrangian_barycenter(pdiagset, init=None, verbose=False):
         else:
             Y = init.copy()
 
+    if implementation == "auction":
+        from gudhi.wasserstein._barycenter import lagrangian_barycenter as _auction_barycenter
+        res = _auction_barycenter(X, np.asarray(Y, dtype=float), verbose)
+        if verbose:
+            Y, groupings, energy, nb_iter = res
+            return Y, {"groupings": groupings, "energy": energy, "nb_iter": nb_iter}
+        return res
+    elif implementation != "pot":
+        raise ValueError("Unknown implementation " + str(implementation))
+
     nb_iter = 0
 
     converged = False  # stoping criterion
@@ -12,12 +12,14 @@
 #define INCLUDE_READER_UTILS_INTERFACE_H_
 
 #include <gudhi/reader_utils.h>
+#include <gudhi/Persistence_diagram_archive.h>
 
 #include <iostream>
 #include <vector>
 #include <string>
 #include <map>
 #include <utility>  // for pair<>
+#include <cstddef>  // for std::size_t
 
 namespace Gudhi {
 
@@ -37,6 +39,29 @@ inline std::vector<std::pair<double, double>>
   return read_persistence_intervals_in_dimension(filename, only_this_dim);
 }
 
+inline void write_pers_diagram_archive(
+    std::string const& filename,
+    std::vector<std::map<int, std::vector<std::pair<double, double>>>> const& diagrams) {
+  Persistence_diagram_archive_writer writer(filename);
+  for (auto const& diagram : diagrams) writer.add_diagram(diagram);
+  writer.close();
+}
+
+// Returns the total number of intervals of the archive, and for every diagram the position of its first interval in
+// dimension only_this_dim and the position after its last one, so that Python can map the intervals itself.
+inline std::pair<std::size_t, std::vector<std::pair<std::size_t, std::size_t>>>
+    read_pers_diagram_archive_index(std::string const& filename, int only_this_dim = -1) {
+  Persistence_diagram_archive archive(filename);
+  auto first = archive.all_intervals().begin();
+  std::vector<std::pair<std::size_t, std::size_t>> index;
+  index.reserve(archive.size());
+  for (std::size_t i = 0; i != archive.size(); ++i) {
+    auto intervals = archive.intervals(i, only_this_dim);
+    index.emplace_back(intervals.begin() - first, intervals.end() - first);
+  }
+  return std::make_pair(archive.all_intervals().size(), index);
+}
+
 
 }  // namespace Gudhi
 
@@ -10,6 +10,7 @@
 
 import gudhi
 import gudhi.hera
+import numpy as np
 import pytest
 
 __author__ = "Vincent Rouvreau"
@@ -25,3 +26,18 @@ def test_basic_bottleneck():
     assert gudhi.bottleneck_distance(diag1, diag2, 0.1) == pytest.approx(0.75, abs=0.1)
     assert gudhi.hera.bottleneck_distance(diag1, diag2, 0) == 0.75
     assert gudhi.hera.bottleneck_distance(diag1, diag2, 0.1) == pytest.approx(0.75, rel=0.1)
+
+
+def test_bottleneck_distance_matrix():
+    diag1 = [[2.7, 3.7], [9.6, 14.0], [34.2, 34.974], [3.0, float("Inf")]]
+    diag2 = [[2.8, 4.45], [9.5, 14.1], [3.2, float("Inf")]]
+    diag3 = [[0.0, 1.0]]
+    diags = [diag1, diag2, diag3]
+    m = gudhi.bottleneck_distance_matrix(diags)
+    assert m.shape == (3, 3)
+    assert m[0, 1] == m[1, 0] == 0.75
+    assert np.isinf(m[0, 2]) and np.isinf(m[2, 1])
+    assert np.all(np.diag(m) == 0)
+    c = gudhi.bottleneck_distance_matrix(diags, [diag2], 0)
+    assert c.shape == (3, 1)
+    assert c[0, 0] == 0.75 and c[1, 0] == 0
@@ -110,6 +110,27 @@ def test_knn_compare():
     assert r1[1] == d0 and r2[1] == d0 and r3[1] == d0
 
 
+def test_knn_rpforest():
+    np.random.seed(0)
+    base = np.random.randn(500, 40)
+    query = np.random.randn(20, 40)
+    r0 = KNearestNeighbors(5, implementation="ckdtree", return_index=True, return_distance=True).fit(base).transform(query)
+    # Examining all the candidates makes the search exact
+    r1 = (
+        KNearestNeighbors(5, implementation="rpforest", n_trees=3, search_k=1500, return_index=True, return_distance=True)
+        .fit(base)
+        .transform(query)
+    )
+    assert np.array_equal(r0[0], r1[0])
+    assert r1[1] == pytest.approx(r0[1])
+    # Default parameters only approximate the neighbors, but distances are exact and sorted
+    r2 = KNearestNeighbors(5, implementation="rpforest", return_index=True, return_distance=True).fit(base).transform(query)
+    assert r2[0].shape == (20, 5)
+    assert np.all(np.diff(r2[1], axis=1) >= 0)
+    assert np.all(r2[1][:, 0] >= r0[1][:, 0] - 1e-9)
+    assert r2[1] == pytest.approx(np.linalg.norm(query[:, None, :] - base[r2[0]], axis=-1))
+
+
 def test_knn_nop():
     # This doesn't look super useful...
     p = np.array([[0.0]])
@@ -10,6 +10,7 @@
 
 import gudhi
 import numpy as np
+import pytest
 
 __author__ = "Vincent Rouvreau"
 __copyright__ = "Copyright (C) 2017 Inria"
@@ -124,3 +125,24 @@ def test_read_persistence_intervals_with_dimension():
         1: [(9.6, 14.0), (3.0, float("Inf"))],
         3: [(34.2, 34.974)],
     }
+
+
+def test_persistence_diagram_archive():
+    with_dimension = {0: [(2.7, 3.7)], 1: [(9.6, 14.0), (3.0, float("Inf"))], 3: [(34.2, 34.974)]}
+    without_dimension = np.array([[1.0, 2.0], [0.5, 4.0]])
+    gudhi.write_persistence_diagram_archive("diagrams.pda", [with_dimension, [], without_dimension])
+
+    diagrams = gudhi.read_persistence_diagram_archive("diagrams.pda")
+    assert len(diagrams) == 3
+    np.testing.assert_array_equal(
+        diagrams[0], [(2.7, 3.7), (9.6, 14.0), (3.0, float("Inf")), (34.2, 34.974)]
+    )
+    assert diagrams[1].shape == (0, 2)
+    np.testing.assert_array_equal(diagrams[2], without_dimension)
+
+    diagrams = gudhi.read_persistence_diagram_archive("diagrams.pda", only_this_dim=1)
+    np.testing.assert_array_equal(diagrams[0], [(9.6, 14.0), (3.0, float("Inf"))])
+    assert diagrams[2].shape == (0, 2)
+
+    with pytest.raises(ValueError):
+        gudhi.read_persistence_diagram_archive("persistence_intervals_with_dimension.pers")
@@ -41,3 +41,59 @@ def test_multiple():
     d2 = WassersteinDistance(order=2, internal_p=2, n_jobs=4).fit(l2).transform(l1)
     print(d1.shape, d2.shape)
     assert d1 == pytest.approx(d2, rel=.02)
+
+
+def test_sliced_wasserstein():
+    l1 = _n_diags(9)
+    l2 = _n_diags(11)
+    l1.append(np.empty((0, 2)))
+    d1 = pairwise_persistence_diagram_distances(l1, metric="sliced_wasserstein", num_directions=20)
+    d2 = SlicedWassersteinDistance(num_directions=20).fit(l2).transform(l1)
+    assert d1.shape == (10, 10)
+    assert d2.shape == (10, 11)
+    for i in range(len(l1)):
+        assert d1[i, i] == 0
+        for j in range(len(l1)):
+            assert d1[i, j] == pytest.approx(_sliced_wasserstein_distance(l1[i], l1[j], num_directions=20))
+        for j in range(len(l2)):
+            assert d2[i, j] == pytest.approx(_sliced_wasserstein_distance(l1[i], l2[j], num_directions=20))
+    assert SlicedWassersteinDistance(num_directions=20)(l1[0], l2[0]) == pytest.approx(d2[0, 0])
+    # With n_jobs, the rows are computed in blocks
+    d3 = pairwise_persistence_diagram_distances(l1, metric="sliced_wasserstein", num_directions=20, n_jobs=3)
+    assert d3 == pytest.approx(d1)
+    assert (d3 == d3.T).all() and (np.diag(d3) == 0).all()
+    d4 = SlicedWassersteinDistance(num_directions=20, n_jobs=3).fit(l2).transform(l1)
+    assert d4 == pytest.approx(d2)
+
+
+def test_vectorizations():
+    from gudhi.representations.vector_methods import Landscape, Silhouette, BettiCurve, Entropy, TopologicalVector, PersistenceImage
+    D = np.array([[0.0, 4.0], [1.0, 2.0]])
+    E = np.empty((0, 2))
+    r2 = np.sqrt(2)
+
+    L = Landscape(num_landscapes=2, resolution=5, sample_range=[0, 4]).fit_transform([D, E])
+    assert L.shape == (2, 10)
+    assert L[0] == pytest.approx(r2 * np.array([0, 1, 2, 1, 0, 0, 0, 0, 0, 0]))
+    assert (L[1] == 0).all()
+    # The samples at both ends of the range computed by fit are removed
+    assert Landscape(num_landscapes=2, resolution=5).fit_transform([D]).shape == (1, 10)
+
+    S = Silhouette(resolution=5, sample_range=[0, 4]).fit_transform([D])
+    assert S[0] == pytest.approx(r2 * 0.5 * np.array([0, 1, 2, 1, 0]))
+
+    B = BettiCurve(resolution=5, sample_range=[0, 4]).fit_transform([D, E])
+    assert (B == np.array([[1, 2, 1, 1, 0], [0, 0, 0, 0, 0]])).all()
+
+    assert Entropy(mode="scalar").fit_transform([D]) == pytest.approx(np.array([[0.25 * np.log(4)]]))
+    ent = Entropy(mode="vector", resolution=5, sample_range=[0, 4]).fit_transform([D, D])
+    assert ent.shape == (2, 5)
+    assert np.abs(ent).sum(axis=1) == pytest.approx(1)
+
+    T = TopologicalVector(threshold=3).fit_transform([D, E])
+    assert T == pytest.approx(np.array([[0.5, 0, 0], [0, 0, 0]]))
+    assert TopologicalVector(threshold=-1).fit_transform([D, E]).shape == (2, 2)
+
+    P = PersistenceImage(bandwidth=1.0, resolution=[2, 3], im_range=[0, 1, 0, 2]).fit_transform([np.array([[0.0, 1.0]])])
+    x, y = np.meshgrid([0, 1], [0, 1, 2])
+    assert P[0] == pytest.approx((np.exp(-(x ** 2 + (1 - y) ** 2) / 2) / (2 * np.pi)).flatten())
@@ -16,7 +16,7 @@ __copyright__ = "Copyright (C) 2019 Inria"
 __license__ = "MIT"
 
 
-def test_lagrangian_barycenter():
+def _basic_lagrangian_barycenter(implementation):
 
     dg1 = np.array([[0.2, 0.5]])
     dg2 = np.array([[0.2, 0.7]])
@@ -33,14 +33,22 @@ def test_lagrangian_barycenter():
     eps = 1e-7
 
 
-    assert np.linalg.norm(lagrangian_barycenter(pdiagset=[dg1, dg2, dg3, dg4],init=3, verbose=False) - res) < eps
-    assert np.array_equal(lagrangian_barycenter(pdiagset=[dg4, dg5, dg6], verbose=False), np.empty(shape=(0,2)))
-    assert np.linalg.norm(lagrangian_barycenter(pdiagset=[dg7], verbose=False) - dg7) < eps
-    Y, log = lagrangian_barycenter(pdiagset=[dg4, dg8], verbose=True)
+    assert np.linalg.norm(lagrangian_barycenter(pdiagset=[dg1, dg2, dg3, dg4],init=3, verbose=False, implementation=implementation) - res) < eps
+    assert np.array_equal(lagrangian_barycenter(pdiagset=[dg4, dg5, dg6], verbose=False, implementation=implementation), np.empty(shape=(0,2)))
+    assert np.linalg.norm(lagrangian_barycenter(pdiagset=[dg7], verbose=False, implementation=implementation) - dg7) < eps
+    Y, log = lagrangian_barycenter(pdiagset=[dg4, dg8], verbose=True, implementation=implementation)
     assert np.linalg.norm(Y - np.array([[1,3], [5, 7]])) < eps
     assert np.abs(log["energy"] - 2) < eps
     assert np.array_equal(log["groupings"][0] , np.array([[0, -1], [1, -1]]))
     assert np.array_equal(log["groupings"][1] , np.array([[0, 0], [1, 1]]))
-    assert np.linalg.norm(lagrangian_barycenter(pdiagset=[dg8, dg4], init=np.array([[0.2, 0.6], [0.5, 0.7]]), verbose=False) - np.array([[1, 3], [5, 7]])) < eps
-    assert lagrangian_barycenter(pdiagset = []) is None
+    assert np.linalg.norm(lagrangian_barycenter(pdiagset=[dg8, dg4], init=np.array([[0.2, 0.6], [0.5, 0.7]]), verbose=False, implementation=implementation) - np.array([[1, 3], [5, 7]])) < eps
+    assert lagrangian_barycenter(pdiagset = [], implementation=implementation) is None
+
+
+
+def test_lagrangian_barycenter():
+    _basic_lagrangian_barycenter("pot")
+
 
+def test_lagrangian_barycenter_auction():
+    _basic_lagrangian_barycenter("auction")
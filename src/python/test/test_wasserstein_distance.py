@@ -11,6 +11,9 @@
 from gudhi.wasserstein.wasserstein import _proj_on_diag
 from gudhi.wasserstein import wasserstein_distance as pot
 from gudhi.hera import wasserstein_distance as hera
+from gudhi.hera import wasserstein_distance_matrix as hera_matrix
+from gudhi.wasserstein.auction import wasserstein_distance as auction
+from gudhi.wasserstein.auction import wasserstein_distance_matrix as auction_matrix
 import numpy as np
 import pytest
 
@@ -98,6 +101,45 @@ def test_wasserstein_distance_hera():
     _basic_wasserstein(hera_wrap(delta=1e-12), 1e-12, test_matching=False)
     _basic_wasserstein(hera_wrap(delta=.1), .1, test_matching=False)
 
+def auction_wrap(**extra):
+    def fun(*kargs,**kwargs):
+        return auction(*kargs,**kwargs,**extra)
+    return fun
+
+def test_wasserstein_distance_auction():
+    _basic_wasserstein(auction_wrap(delta=1e-12), 1e-12, test_matching=False)
+    _basic_wasserstein(auction_wrap(delta=.1), .1, test_matching=False)
+    diag1 = np.array([[2.7, 3.7], [9.6, 14.0], [34.2, 34.974]])
+    diag2 = np.array([[2.8, 4.45], [9.5, 14.1]])
+    match = auction(diag1, diag2, matching=True, internal_p=2., order=2., delta=1e-9)[1]
+    assert np.array_equal(match, [[0, 0], [1, 1], [2, -1]])
+
+def test_wasserstein_distance_matrix_auction():
+    diags = [np.array([[2.7, 3.7], [9.6, 14.0], [34.2, 34.974]]), np.array([[2.8, 4.45], [9.5, 14.1]]), np.array([]),
+             np.array([[0.0, 1.0], [3.0, np.inf]])]
+    m = auction_matrix(diags, order=2, internal_p=2, delta=1e-9)
+    assert m.shape == (4, 4)
+    for i in range(4):
+        for j in range(4):
+            if i != j:
+                assert m[i, j] == pytest.approx(hera(diags[i], diags[j], order=2, internal_p=2, delta=1e-12), rel=1e-8)
+    assert auction_matrix(diags, diags[:1], order=2, internal_p=2, delta=1e-9) == pytest.approx(m[:, :1], rel=1e-8)
+
+def test_wasserstein_distance_matrix_hera():
+    diags = [np.array([[2.7, 3.7], [9.6, 14.0], [34.2, 34.974]]), np.array([[2.8, 4.45], [9.5, 14.1]]), np.array([[0.0, 1.0]]),
+             np.array([]), np.array([[0.0, 1.0], [3.0, np.inf]])]
+    m = hera_matrix(diags, order=2, internal_p=2, delta=1e-12)
+    assert m.shape == (5, 5)
+    for i in range(5):
+        assert m[i, i] == 0
+        for j in range(5):
+            assert m[i, j] == m[j, i]
+            if i != j:
+                assert m[i, j] == pytest.approx(hera(diags[i], diags[j], order=2, internal_p=2, delta=1e-12))
+    c = hera_matrix(diags, diags[:2], order=2, internal_p=2, delta=1e-12)
+    assert c.shape == (5, 2)
+    assert c == pytest.approx(m[:, :2])
+
 def test_wasserstein_distance_grad():
     import torch
 